@@ -28,18 +28,28 @@ bool configSetTh0Timeout(uint32_t timeoutMs);
 bool configSetTh0RawVacuum(uint32_t rawVacuum);
 bool configSetTh1Timeout(uint32_t timeoutMs);
 bool configSetTh1RawVacuum(uint32_t rawVacuum);
+bool configSetDecayTimeout(uint32_t timeoutMs);
+bool configSetDecayRawLeakRate(uint32_t rawLeakRate);
+bool configSetPredictMode(uint32_t mode);
 
 uint32_t configGetTh0Timeout(void);
 uint32_t configGetTh0RawVacuum(void);
 uint32_t configGetTh0Vacuum(void);
 uint32_t configGetTh1Timeout(void);
 uint32_t configGetTh1RawVacuum(void);
+uint32_t configGetTh1Vacuum(void);
 uint32_t configGetTh0DefaultTimeout(void);
 uint32_t configGetTh0DefaultRawVacuum(void);
 uint32_t configGetTh0DefaultVacuum(void);
 uint32_t configGetTh1DefaultTimeout(void);
 uint32_t configGetTh1DefaultRawVacuum(void);
+uint32_t configGetTh1DefaultVacuum(void);
+uint32_t configGetDecayTimeout(void);
+uint32_t configGetDecayRawLeakRate(void);
+uint32_t configGetDecayDefaultTimeout(void);
+uint32_t configGetDecayDefaultRawLeakRate(void);
 uint32_t configGetRetryCount(void);
+uint32_t configGetPredictMode(void);
 bool configIsPasswordCharValid(char character, uint8_t position);
 uint32_t configPasswordLength(void);
 
@@ -0,0 +1,34 @@
+#ifndef APP_CURVE_H
+#define	APP_CURVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CONFIG_CURVE_POINTS             128
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+struct curve {
+    uint16_t            sample[CONFIG_CURVE_POINTS];
+    uint32_t            vertex[CONFIG_CURVE_POINTS];
+    uint32_t            count;
+    uint32_t            decimation;
+    uint32_t            decimationCount;
+    uint32_t            decimationMax;
+    uint32_t            rawFullScale;
+};
+
+void curveStart(struct curve * curve, uint32_t rawTh0Value, uint32_t rawTh1Value, uint32_t nSamples);
+bool curvePush(struct curve * curve, uint32_t rawVacuum);
+void constructCurve(const struct curve * curve);
+uint32_t curveGetSamples(const struct curve * curve, const uint16_t ** samples);
+uint32_t curveGetDecimation(const struct curve * curve);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* APP_CURVE_H */
+
@@ -23,9 +23,46 @@ extern "C" {
 #endif
 
 #define CONFIG_USE_DIRECT_ENTRY         0
+#define CONFIG_DATA_LOG_CURVE_SIZE      96
+#define CONFIG_DATA_LOG_CURVE_POINTS    128
+
+/*
+ * Export is formatted into a buffer and written to the drive in blocks of this
+ * size, so each FSfwrite() call covers several whole sectors. Keep it a
+ * multiple of the sector size.
+ */
+#define CONFIG_DATA_LOG_EXPORT_BUFFER   2048
+
+/*
+ * Export file formats, text for spreadsheets or the binary format described in
+ * app_log_format.h.
+ */
+enum dataLogFormat {
+    DATA_LOG_FORMAT_CSV,
+    DATA_LOG_FORMAT_BINARY,
+    DATA_LOG_LAST_FORMAT
+};
+
+enum dataLogDecay {
+    DATA_LOG_DECAY_NOT_EXECUTED,
+    DATA_LOG_DECAY_PASSED,
+    DATA_LOG_DECAY_FAILED
+};
 
 extern const struct storageEntry DataLogStorage;
 extern const struct storageEntry ArrayDescStorage;
+extern const struct storageEntry ExportCursorStorage;
+
+/*
+ * Pump-down curve, delta encoded vacuum samples taken every period ms. Curve
+ * is not present when nPoints is zero.
+ */
+struct appDataLogCurve {
+    uint16_t            nPoints;
+    uint16_t            period;
+    uint16_t            size;
+    uint8_t             data[CONFIG_DATA_LOG_CURVE_SIZE];
+};
 
 struct appDataLog {
     struct appTime      timestamp;
@@ -36,17 +73,33 @@ struct appDataLog {
         uint32_t            time;
     }                   th[2];
     bool                hasPassed;
+    bool                isPredicted;                                            /* Verdict and 2nd threshold time come from the predictor   */
+    struct decayData {
+        enum dataLogDecay   state;
+        int32_t             rawRate;                                            /* Raw vacuum lost per second                               */
+    }                   decay;
+    struct appDataLogCurve curve;
 };
 
 esError initAppDataLog(void);
 esError appDataLogSave(const struct appDataLog * dataLog);
+void appDataLogSetCurve(struct appDataLog * dataLog, const uint16_t * samples, uint32_t nSamples, uint32_t period);
+uint32_t appDataLogGetCurve(const struct appDataLog * dataLog, uint16_t * samples, uint32_t nSamples);
 esError appDataLogNumberOfSlots(uint32_t * nSlots);
 esError appDataLogNumberOfEntries(uint32_t * nEntries);
 esError appDataLogHeadId(uint32_t * headId);
 esError appDataLogLoad(uint32_t entryId, struct appDataLog * dataLog);
+esError appDataLogFindRange(const struct appTime * begin, const struct appTime * end, uint32_t * firstId,
+    uint32_t * endId);
 esError appDataLogExportInit(void);
 esError appDataLogExportTerm(void);
-esError appDataLogExport(uint32_t entryId);
+esError appDataLogExportBegin(enum dataLogFormat format);
+esError appDataLogExportEntry(uint32_t entryId);
+esError appDataLogExportEnd(void);
+esError appDataLogExportCursor(uint32_t * entryId);
+esError appDataLogExportSetCursor(uint32_t entryId);
+bool appDataLogIsLegacy(void);
+esError appDataLogRestart(void);
 
 #ifdef	__cplusplus
 }
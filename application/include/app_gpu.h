@@ -16,7 +16,9 @@
 #define DISP_WIDTH                      320
 #define DISP_HEIGHT                     240
 
+#define CONFIG_GPU_PROFILE_DEPTH        16
 
+#define gpuBegin()                      gpuBeginScreen(__func__)
 
 #ifdef	__cplusplus
 extern "C" {
@@ -32,13 +34,31 @@ struct gpuTouchData {
     uint32_t            f;
 };
 
+struct gpuProfileRecord {
+    const char *        screen;
+    uint32_t            cmdWords;
+    uint32_t            spiBytes;
+    uint32_t            waitTicks;
+    uint32_t            frameTicks;
+};
+
+struct gpuProfile {
+    struct gpuProfileRecord record[CONFIG_GPU_PROFILE_DEPTH];
+    uint32_t            head;
+    uint32_t            frames;
+};
+
 extern Ft_Gpu_Hal_Context_t Gpu;
+extern struct gpuProfile    GpuProfile;
 
 void initGpuModule(void);
 void gpuSetupDisplay(void);
 bool isGpuReady(void);
-void gpuBegin(void);
+void gpuBeginScreen(const char * screen);
 void gpuEnd(void);
+void gpuSync(void);
+bool isGpuBusy(void);
+bool gpuProfileGet(uint32_t age, struct gpuProfileRecord * record);
 uint8_t gpuGetKey(void);
 void gpuFadeIn(void);
 void gpuFadeOut(void);
@@ -0,0 +1,29 @@
+#ifndef APP_LEAK_H
+#define	APP_LEAK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+struct leak {
+    int64_t             sumX;
+    int64_t             sumY;
+    int64_t             sumXX;
+    int64_t             sumXY;
+    uint32_t            nSamples;
+    uint32_t            period;
+};
+
+void leakStart(struct leak * leak, uint32_t periodMs);
+void leakPush(struct leak * leak, uint32_t rawVacuum);
+int32_t leakGetRate(const struct leak * leak);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* APP_LEAK_H */
+
@@ -0,0 +1,58 @@
+#ifndef APP_LOG_FORMAT_H
+#define	APP_LOG_FORMAT_H
+
+/*
+ * Binary log export, written by the tester as MMDDhhmm.BIN, or MMDD_nnn.BIN
+ * when that name is taken, and read back by tools/export_decode. All numbers
+ * are little endian.
+ *
+ * The file starts with a header of LOG_BIN_HEADER_SIZE bytes:
+ *
+ *     0   magic "VTLB"
+ *     4   u16 format version, LOG_BIN_VERSION
+ *     6   u16 header size
+ *     8   u16 year, u8 month, u8 day, u8 hour (0 - 23), u8 minute, u8 second
+ *         of the export
+ *     15  u8 number of calibration points in use, zero when raw values are not
+ *         converted
+ *     16  LOG_BIN_CALIB_POINTS pairs of u32 raw vacuum, u32 vacuum
+ *
+ * A sequence of blocks follows. Every block is u16 type, u16 payload length
+ * and the payload. Readers skip blocks they do not know:
+ *
+ *     entry   u32 entry id, u16 year, u8 month, u8 day, u8 hour (0 - 23),
+ *             u8 minute, u8 second, u8 flags, u32 user id, u32 number of
+ *             tests, then u32 raw max value and u32 time in ms of both
+ *             thresholds, u8 leak test result (LOG_BIN_LEAK_*) and s32 raw
+ *             vacuum lost per second during the leak test. Version 1 entries
+ *             end before the leak test result
+ *     curve   curve of the preceding entry: u16 number of points, u16 period
+ *             in ms and the delta encoded raw samples as stored in the log
+ *     end     u32 number of entries, u32 CRC-32 of all bytes before the CRC
+ *
+ * The end block is always the last one, a file without it was not closed.
+ */
+#define LOG_BIN_MAGIC                   "VTLB"
+#define LOG_BIN_VERSION                 2
+#define LOG_BIN_HEADER_SIZE             40
+#define LOG_BIN_CALIB_POINTS            3
+#define LOG_BIN_BLOCK_SIZE              4
+
+#define LOG_BIN_ENTRY                   1
+#define LOG_BIN_CURVE                   2
+#define LOG_BIN_END                     3
+
+#define LOG_BIN_ENTRY_SIZE              41
+#define LOG_BIN_ENTRY_V1_SIZE           36
+#define LOG_BIN_CURVE_SIZE              4                                       /* Without the samples                                      */
+#define LOG_BIN_END_SIZE                8
+
+#define LOG_BIN_FLAG_PASSED             0x01u
+#define LOG_BIN_FLAG_PREDICTED          0x02u                                   /* Verdict was predicted, the 2nd threshold time too        */
+
+#define LOG_BIN_LEAK_NOT_EXECUTED       0
+#define LOG_BIN_LEAK_PASSED             1
+#define LOG_BIN_LEAK_FAILED             2
+
+#endif	/* APP_LOG_FORMAT_H */
+
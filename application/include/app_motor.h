@@ -8,13 +8,16 @@
 #ifndef APP_MOTOR_H
 #define	APP_MOTOR_H
 
+#include <stdint.h>
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
 void initMotorModule(void);
-void motorEnable(void);
-void motorDisable(void);
+void motorEnable(uint32_t station);
+void motorEnableControl(uint32_t station, uint32_t rawIdleVacuum, uint32_t rawTarget);
+void motorDisable(uint32_t station);
 
 #ifdef	__cplusplus
 }
@@ -5,7 +5,7 @@
 #include "eds/event.h"
 
 #define CONFIG_DEBOUNCE_EVENT_BASE          1800
-#define CONFIG_CONSUMER                     Gui
+#define CONFIG_CONSUMER                     Test
 
 
 
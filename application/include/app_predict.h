@@ -0,0 +1,91 @@
+#ifndef APP_PREDICT_H
+#define	APP_PREDICT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Number of samples averaged into one block, as power of two. The fit works on
+ * block sums to suppress sensor noise.
+ */
+#define CONFIG_PREDICT_BLOCK_SHIFT      2
+
+/*
+ * Minimum number of block pairs in the fit before any verdict is given.
+ */
+#define CONFIG_PREDICT_MIN_PAIRS        4
+
+/*
+ * No verdict is given before 1/2^CONFIG_PREDICT_MIN_ELAPSED_SHIFT of the time
+ * to deadline has elapsed, so pump spin-up is not mistaken for a leak.
+ */
+#define CONFIG_PREDICT_MIN_ELAPSED_SHIFT 2
+
+/*
+ * Number of consecutive blocks the predicted asymptote must stay within
+ * 1/2^CONFIG_PREDICT_STABLE_SHIFT of its previous value.
+ */
+#define CONFIG_PREDICT_STABLE_COUNT     3
+#define CONFIG_PREDICT_STABLE_SHIFT     4
+
+/*
+ * The value predicted at the deadline must clear the threshold by
+ * 1/2^CONFIG_PREDICT_MARGIN_SHIFT of the threshold.
+ */
+#define CONFIG_PREDICT_MARGIN_SHIFT     3
+
+/*
+ * The fit is halved when it reaches this number of pairs, so older blocks
+ * gradually lose weight and the sums can not overflow.
+ */
+#define CONFIG_PREDICT_MAX_PAIRS        128
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+enum predictMode {
+    PREDICT_DISABLED,
+    PREDICT_FAIL_ONLY,
+    PREDICT_PASS_FAIL,
+    PREDICT_LAST_MODE
+};
+
+enum predictVerdict {
+    PREDICT_UNKNOWN,
+    PREDICT_PASS,
+    PREDICT_FAIL
+};
+
+struct predict {
+    int64_t             sumX;
+    int64_t             sumY;
+    int64_t             sumXX;
+    int64_t             sumXY;
+    uint32_t            nPairs;
+    uint32_t            nBlockSamples;
+    int32_t             block;
+    int32_t             previousBlock;
+    bool                hasPreviousBlock;
+    int32_t             ratio;
+    int32_t             asymptote;
+    uint32_t            nStable;
+    int32_t             rawThBlock;
+    uint32_t            nBlocks;
+    uint32_t            deadline;
+    uint32_t            crossing;
+    enum predictVerdict verdict;
+};
+
+void predictStart(struct predict * predict);
+void predictSetTarget(struct predict * predict, uint32_t rawThValue, uint32_t nSamples);
+enum predictVerdict predictPush(struct predict * predict, uint32_t rawVacuum);
+uint32_t predictGetAsymptote(const struct predict * predict);
+uint32_t predictGetCrossing(const struct predict * predict);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* APP_PREDICT_H */
+
@@ -11,19 +11,56 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "eds/event.h"
+#include "driver/adc.h"
+
+#define CONFIG_PSENSOR_EVENT_BASE       1900
+#define CONFIG_PSENSOR_CAPTURE_SIZE     128
+#define CONFIG_PSENSOR_CALIB_POINTS     3
+#define CONFIG_PSENSOR_CONSUMER         Test
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+enum psensorEventId {
+    EVT_PSENSOR_THRESHOLD   = CONFIG_PSENSOR_EVENT_BASE
+};
+
+struct psensorEvent {
+    esEvent             event;
+    uint32_t            rawValue;
+    uint32_t            timestamp;
+    uint32_t            armSeq;
+};
+
 void initPSensorModule(void);
-uint32_t getDutRawValue(void);
+uint32_t getDutRawValue(uint32_t station);
+uint32_t getDutTimestamp(void);
+uint32_t dutTimestampToMs(uint32_t timestamp);
+uint32_t dutCapturePeriodMs(uint32_t decimation);
+uint32_t dutArmThreshold(uint32_t station, uint32_t rawIdleVacuum, uint32_t rawThValue);
+void dutDisarmThreshold(uint32_t station);
+void dutSetSampleHandler(uint32_t station, void (* handler)(int32_t));
+void dutStartCapture(uint32_t station, uint32_t decimation);
+void dutStopCapture(uint32_t station);
+uint32_t dutReadCapture(uint32_t station, struct adcSample * samples, uint32_t count);
+void dutStartZero(uint32_t station);
+void dutStopZero(uint32_t station);
+bool dutUpdateZero(uint32_t station);
+uint32_t dutGetZero(uint32_t station);
+uint32_t dutTrackZero(uint32_t station, uint32_t rawIdleVacuum);
 bool isDutFirstThresholdValid(void);
 bool isDutSecondhTresholdValid(void);
 void newDut(uint32_t firstTreshold, uint32_t secondTreshold);
 void updateDutFirstTh(void);
 void updateDutSecondTh(void);
 
+bool dutSetCalibration(const uint32_t * rawVacuum, const uint32_t * vacuum, uint32_t nPoints);
+void dutLoadCalibration(void);
+uint32_t dutGetCalibration(uint32_t * rawVacuum, uint32_t * vacuum);
 uint32_t dutRawToMm(uint32_t rawValue);
+uint32_t dutRawRateToMm(uint32_t rawRate, uint32_t rawValue);
 uint32_t dutMmToRaw(uint32_t mmValue);
 
 #ifdef	__cplusplus
@@ -0,0 +1,60 @@
+#ifndef APP_PUMP_H
+#define	APP_PUMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Duty cycle is a fraction of PUMP_DUTY_ONE.
+ */
+#define PUMP_DUTY_ONE                   (0x1l << 16)
+
+/*
+ * Controller runs once per CONFIG_PUMP_PERIOD sensor samples.
+ */
+#define CONFIG_PUMP_PERIOD              10
+
+/*
+ * Soft start: duty ceiling begins at CONFIG_PUMP_START_DUTY and rises to full
+ * duty in CONFIG_PUMP_RAMP_PERIODS controller periods.
+ */
+#define CONFIG_PUMP_START_DUTY          (PUMP_DUTY_ONE * 50 / 100)
+#define CONFIG_PUMP_RAMP_PERIODS        10
+
+/*
+ * Slope set point is 1/2^CONFIG_PUMP_APPROACH_SHIFT of the remaining distance
+ * to target, per controller period. This makes the vacuum approach the target
+ * exponentially instead of overshooting it.
+ */
+#define CONFIG_PUMP_APPROACH_SHIFT      3
+
+/*
+ * PI gains in duty per raw unit per period of slope error, Q16.
+ */
+#define CONFIG_PUMP_KP                  (PUMP_DUTY_ONE / 64)
+#define CONFIG_PUMP_KI                  (PUMP_DUTY_ONE / 256)
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+struct pump {
+    int32_t             rawTarget;
+    bool                isControlled;
+    uint32_t            count;
+    int32_t             previous;
+    bool                hasPrevious;
+    int32_t             ceiling;
+    int32_t             integral;
+    int32_t             duty;
+};
+
+void pumpStart(struct pump * pump, int32_t rawTarget);
+int32_t pumpUpdate(struct pump * pump, int32_t rawVacuum);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* APP_PUMP_H */
+
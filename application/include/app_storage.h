@@ -57,6 +57,11 @@ esError storageClearSpace(
 esError storageRead(
     struct storageSpace * space,
     void *              buffer);
+esError storageReadLegacy(
+    struct storageSpace * space,
+    uint32_t            signature,
+    size_t              size,
+    void *              buffer);
 esError storageWrite(
     struct storageSpace * space,
     const void *        buffer);
@@ -9,17 +9,54 @@
 #define	APP_USB_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include "eds/event.h"
 
 #define CONFIG_TEXT_USB_DETECTED        "detected"
 #define CONFIG_TEXT_USB_NOT_DETECTED    "not detected"
 
+/*
+ * The drive is mounted once in the idle routine right after it enumerates.
+ * The consumer gets EVT_USB_ATTACH when the device enumerates, EVT_USB_READY
+ * when the mount is done and EVT_USB_DETACH when the device goes away.
+ */
+#define CONFIG_USB_EVENT_BASE           2300
+#define CONFIG_USB_CONSUMER             Gui
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+enum usbEventsId {
+    EVT_USB_ATTACH          = CONFIG_USB_EVENT_BASE,
+    EVT_USB_READY,
+    EVT_USB_DETACH
+};
+
+/*
+ * Milliseconds from the moment the host saw the device to each step of the
+ * attach.
+ */
+struct usbTiming {
+    uint32_t            enumerated;                                             /* Configuration requested bus power                        */
+    uint32_t            mediaReady;                                             /* SCSI layer reports the media                             */
+    uint32_t            mounted;                                                /* File system and FSInfo loaded                            */
+};
+
+struct usbReadyEvent {
+    esEvent             event;
+    bool                isMounted;
+    struct usbTiming    timing;
+};
+
 void initUsbModule(void);
 void appUsb(void);
 bool isUsbDetected(void);
+bool isUsbAttached(void);
+bool isUsbMounted(void);
+bool isUsbFailed(void);
+void appUsbGetTiming(struct usbTiming * timing);
 uint32_t snprintUsbStatus(char * buffer);
 
 #ifdef	__cplusplus
@@ -61,6 +61,19 @@
 #define MEDIA_SECTOR_SIZE 		512
 /************************************************************************/
 
+// Number of consecutive data sectors collected before they are written to
+// the media with one multi-sector command. Each sector takes MEDIA_SECTOR_SIZE
+// bytes of RAM. Comment this out to write every sector on its own.
+// Requires MDD_SectorsWrite from the media layer.
+#define FS_MULTI_SECTOR_COUNT   8
+/************************************************************************/
+
+// Number of FAT sectors kept in RAM. Changed FAT sectors are written back
+// when they are evicted or when a file is closed. Each sector takes
+// MEDIA_SECTOR_SIZE bytes of RAM, 1 gives the original single FAT buffer.
+#define FS_FAT_CACHE_SECTORS    2
+/************************************************************************/
+
 /* *******************************************************************************************************/
 /************** Compiler options to enable/Disable Features based on user's application ******************/
 /* *******************************************************************************************************/
@@ -210,6 +223,8 @@
     #define MDD_MediaDetect         USBHostMSDSCSIMediaDetect
     #define MDD_SectorRead          USBHostMSDSCSISectorRead
     #define MDD_SectorWrite         USBHostMSDSCSISectorWrite
+    #define MDD_SectorsRead         USBHostMSDSCSISectorsRead
+    #define MDD_SectorsWrite        USBHostMSDSCSISectorsWrite
     #define MDD_InitIO();              
     #define MDD_ShutdownMedia       USBHostMSDSCSIMediaReset
     #define MDD_WriteProtectState   USBHostMSDSCSIWriteProtectState
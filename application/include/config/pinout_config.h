@@ -41,10 +41,21 @@ extern "C" {
 
 #define CONFIG_MDRIVE_GPIO_PORT         &GpioA
 #define CONFIG_MDRIVE_GPIO_PIN          4
+#define CONFIG_MDRIVE_PWM_PPS           RPA4R
+#define CONFIG_MDRIVE_PWM_PPS_OC4       0x5u
 
 #define CONFIG_MDRIVE_POWER_PORT        &GpioA
 #define CONFIG_MDRIVE_POWER_PIN         10
 
+/*
+ * Every test station has its own pad detector and pressure sensor input. The
+ * current board wires only one station, so only one is supported. A board
+ * with a second station defines CONFIG_PDETECTOR_1_PORT, CONFIG_PDETECTOR_1_PIN,
+ * CONFIG_PSENSOR_1_GPIO_PORT, CONFIG_PSENSOR_1_GPIO_PIN and
+ * CONFIG_PSENSOR_1_ADC_CHANNEL here and sets CONFIG_NUM_OF_STATIONS to 2.
+ */
+#define CONFIG_NUM_OF_STATIONS          1
+
 #define CONFIG_PDETECTOR_PORT           &GpioA
 #define CONFIG_PDETECTOR_PIN            9
 
@@ -72,7 +72,8 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #define USB_NUM_BULK_NAKS 20000
 //#define USB_SUPPORT_ISOCHRONOUS_TRANSFERS
 #define USB_INITIAL_VBUS_CURRENT (100/2)
-#define USB_INSERT_TIME (250+1)
+// Insertion debounce at the 100 ms spec minimum, longer only delays the attach
+#define USB_INSERT_TIME (100+1)
 #define USB_HOST_APP_EVENT_HANDLER      appUsbEventHandler
 
 // Host Mass Storage Client Driver Configuration
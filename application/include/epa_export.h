@@ -0,0 +1,73 @@
+#ifndef EPA_EXPORT_H
+#define	EPA_EXPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "events.h"
+#include "eds/epa.h"
+#include "app_data_log.h"
+
+/*
+ * Export runs below the test stations. It writes at most
+ * CONFIG_EPA_EXPORT_CHUNK entries per event and then waits
+ * CONFIG_EPA_EXPORT_CHUNK_PERIOD_MS, so the idle routine keeps servicing USB
+ * and other EPAs are never delayed by more than one chunk.
+ */
+#define CONFIG_EPA_EXPORT_PRIORITY      20
+#define CONFIG_EPA_EXPORT_QUEUE_SIZE    5
+#define CONFIG_EPA_EXPORT_EVENT_BASE    2200
+#define CONFIG_EPA_EXPORT_NAME          "Log export"
+#define CONFIG_EPA_EXPORT_CHUNK         8
+#define CONFIG_EPA_EXPORT_CHUNK_PERIOD_MS 10
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+enum exportEventsId {
+    EVT_EXPORT_START        = CONFIG_EPA_EXPORT_EVENT_BASE,
+    EVT_EXPORT_CANCEL,
+    EVT_EXPORT_PROGRESS,
+    EVT_EXPORT_DONE
+};
+
+enum exportResult {
+    EXPORT_SUCCESS,
+    EXPORT_FAILED,
+    EXPORT_CANCELED
+};
+
+/*
+ * Entries from firstNo up to, but not including, endNo are exported. When
+ * isNewOnly is set the export cursor is advanced to endNo on success.
+ */
+struct exportStartEvent {
+    esEvent             event;
+    uint32_t            firstNo;
+    uint32_t            endNo;
+    bool                isNewOnly;
+    enum dataLogFormat  format;
+};
+
+struct exportProgressEvent {
+    esEvent             event;
+    uint32_t            nDone;
+    uint32_t            nEntries;
+};
+
+struct exportDoneEvent {
+    esEvent             event;
+    enum exportResult   result;
+};
+
+extern const struct esEpaDefine ExportEpa;
+extern const struct esSmDefine  ExportSm;
+extern struct esEpa *           Export;
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EPA_EXPORT_H */
+
@@ -0,0 +1,95 @@
+#ifndef EPA_TEST_H
+#define	EPA_TEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "events.h"
+#include "eds/epa.h"
+#include "app_curve.h"
+#include "config/pinout_config.h"
+
+/*
+ * One test EPA runs per station. Station n gets priority
+ * CONFIG_EPA_TEST_PRIORITY - n, all of them are below the GUI.
+ */
+#define CONFIG_EPA_TEST_PRIORITY        27
+#define CONFIG_EPA_TEST_QUEUE_SIZE      10
+#define CONFIG_EPA_TEST_EVENT_BASE      2100
+#define CONFIG_EPA_TEST_NAME            "Test station"
+#define CONFIG_EPA_TEST_CONSUMER        Gui
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+enum testEventsId {
+    EVT_TEST_START          = CONFIG_EPA_TEST_EVENT_BASE,
+    EVT_TEST_FINISH,
+    EVT_TEST_STATUS
+};
+
+enum testStage {
+    TEST_STAGE_ZERO,
+    TEST_STAGE_IDLE,
+    TEST_STAGE_FIRST_TH,
+    TEST_STAGE_SECOND_TH,
+    TEST_STAGE_DECAY,
+    TEST_STAGE_DONE,
+    TEST_STAGE_SAVING
+};
+
+enum testState {
+    TEST_NOT_EXECUTED,
+    TEST_STARTED,
+    TEST_FAILED,
+    TEST_CANCELED,
+    TEST_VALID
+};
+
+struct testStatusEvent {
+    esEvent             event;
+    uint32_t            station;
+    bool                isCurveUpdated;
+};
+
+/*
+ * Station status is owned by the station EPA. Other EPAs may read it from
+ * their event handlers, the kernel never preempts one EPA with another.
+ */
+struct testStatus {
+    enum testStage      stage;
+    bool                isDutInPlace;
+    bool                isNewDut;                                               /* Part was replaced since the last result                  */
+    bool                isPredicted;                                            /* Verdict was taken from the predictor, not measured       */
+    uint32_t            rawIdleVacuum;
+    uint32_t            count;
+    uint32_t            nEntries;
+    struct testThStatus {
+        enum testState      state;
+        uint32_t            rawMaxValue;
+        uint32_t            rawThValue;
+        uint32_t            time;
+    }                   th[2];
+    struct testDecayStatus {
+        enum testState      state;
+        uint32_t            time;
+        uint32_t            rawLimit;
+        int32_t             rawRate;
+    }                   decay;
+    struct curve        curve;
+};
+
+extern const struct esEpaDefine TestEpa[CONFIG_NUM_OF_STATIONS];
+extern const struct esSmDefine  TestSm;
+extern struct esEpa *           Test[CONFIG_NUM_OF_STATIONS];
+
+const struct testStatus * testGetStatus(uint32_t station);
+bool isTestPassed(const struct testStatus * status);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EPA_TEST_H */
+
@@ -12,6 +12,8 @@
 
 #include "epa_gui.h"
 #include "epa_touch.h"
+#include "epa_test.h"
+#include "epa_export.h"
 
 /*===============================================================  MACRO's  ==*/
 
@@ -1,18 +1,26 @@
 
+#include <string.h>
+
 #include "app_config.h"
 #include "app_storage.h"
+#include "app_predict.h"
 
-#define APP_CONFIG_SIGNATURE            0xdadcbeefu
+#define APP_CONFIG_SIGNATURE            0xdadcbef3u
+#define APP_CONFIG_V0_SIGNATURE         0xdadcbeefu
+#define APP_CONFIG_V0_RAW_SHIFT         2
 
-#define CONFIG_DEF_RAW_IDLE_VACUUM      270
+#define CONFIG_DEF_RAW_IDLE_VACUUM      1080
 #define CONFIG_DEF_TH0_TIMEOUT          500
-#define CONFIG_DEF_TH0_RAW_VACUUM       70
+#define CONFIG_DEF_TH0_RAW_VACUUM       280
 #define CONFIG_DEF_TH0_VACUUM           5
 #define CONFIG_DEF_TH1_TIMEOUT          1000
-#define CONFIG_DEF_TH1_RAW_VACUUM       84
+#define CONFIG_DEF_TH1_RAW_VACUUM       336
 #define CONFIG_DEF_TH1_VACUUM           10
 #define CONFIG_DEF_RETRY_COUNT          2
 #define CONFIG_DEF_PASSWORD             "1248"
+#define CONFIG_DEF_PREDICT_MODE         PREDICT_DISABLED
+#define CONFIG_DEF_DECAY_TIMEOUT        0
+#define CONFIG_DEF_DECAY_RAW_LEAK_RATE  20
 
 struct config {
     struct th {
@@ -20,6 +28,24 @@ struct config {
         uint32_t        rawVacuum;
         uint32_t        vacuum;
     }                   th[2];
+    struct decay {
+        uint32_t        time;
+        uint32_t        rawLeakRate;
+    }                   decay;
+    char                password[4];
+    uint32_t            predictMode;
+};
+
+/*
+ * Record of the firmware before the ADC filter chain, raw vacuum values are on
+ * the plain 10-bit scale and the vacuum fields were never written.
+ */
+struct configV0 {
+    struct thV0 {
+        uint32_t        time;
+        uint32_t        rawVacuum;
+        uint32_t        vacuum;
+    }                   th[2];
     char                password[4];
 };
 
@@ -33,13 +59,42 @@ const struct storageEntry ConfigStorage = {
 
 static void appConfigReset(struct config * config) {
     config->th[0].time      = CONFIG_DEF_TH0_TIMEOUT;
-    config->th[0].rawVacuum = CONFIG_DEF_TH0_RAW_VACUUM;/*TODO: konvertuj iz RAW u mm */
+    config->th[0].rawVacuum = CONFIG_DEF_TH0_RAW_VACUUM;
+    config->th[0].vacuum    = CONFIG_DEF_TH0_VACUUM;
     config->th[1].time      = CONFIG_DEF_TH1_TIMEOUT;
-    config->th[1].rawVacuum = CONFIG_DEF_TH1_RAW_VACUUM;/*TODO: konvertuj iz RAW u mm */
+    config->th[1].rawVacuum = CONFIG_DEF_TH1_RAW_VACUUM;
+    config->th[1].vacuum    = CONFIG_DEF_TH1_VACUUM;
+    config->decay.time        = CONFIG_DEF_DECAY_TIMEOUT;
+    config->decay.rawLeakRate = CONFIG_DEF_DECAY_RAW_LEAK_RATE;
     config->password[0]     = CONFIG_DEF_PASSWORD[0];
     config->password[1]     = CONFIG_DEF_PASSWORD[1];
     config->password[2]     = CONFIG_DEF_PASSWORD[2];
     config->password[3]     = CONFIG_DEF_PASSWORD[3];
+    config->predictMode     = CONFIG_DEF_PREDICT_MODE;
+}
+
+/*
+ * Keeps the user settings of a tester upgraded from the firmware before the
+ * ADC filter chain. The thresholds are scaled to the current raw resolution
+ * of 10 + CONFIG_PSENSOR_EXTRA_BITS bits, everything added since then starts
+ * from the defaults.
+ */
+static bool appConfigMigrate(struct config * config) {
+    struct configV0     configV0;
+    uint32_t            cnt;
+
+    if (storageReadLegacy(Storage, APP_CONFIG_V0_SIGNATURE, sizeof(configV0), &configV0) != ES_ERROR_NONE) {
+
+        return (false);
+    }
+
+    for (cnt = 0u; cnt < 2u; cnt++) {
+        config->th[cnt].time      = configV0.th[cnt].time;
+        config->th[cnt].rawVacuum = configV0.th[cnt].rawVacuum << APP_CONFIG_V0_RAW_SHIFT;
+    }
+    memcpy(config->password, configV0.password, sizeof(config->password));
+
+    return (true);
 }
 
 void initAppConfig(void) {
@@ -47,6 +102,7 @@ void initAppConfig(void) {
 
     if (storageRead(Storage, &config) != ES_ERROR_NONE) {
         appConfigReset(&config);
+        appConfigMigrate(&config);
         storageWrite(Storage, &config);
     }
 }
@@ -183,16 +239,124 @@ uint32_t configGetTh1RawVacuum(void) {
     return (config.th[1].rawVacuum);
 }
 
+uint32_t configGetTh1Vacuum(void) {
+    struct config       config;
+
+    storageRead(Storage, &config);
+
+    return (config.th[1].vacuum);
+}
+
 uint32_t configGetTh1DefaultRawVacuum(void) {
 
     return (CONFIG_DEF_TH1_RAW_VACUUM);
 }
 
+uint32_t configGetTh1DefaultVacuum(void) {
+
+    return (CONFIG_DEF_TH1_VACUUM);
+}
+
+/*
+ * Decay phase is skipped when its timeout is zero.
+ */
+bool configSetDecayTimeout(uint32_t timeoutMs) {
+    struct config       config;
+
+    if (storageRead(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+    config.decay.time = timeoutMs;
+
+    if (storageWrite(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+
+    return (true);
+SPACE_FAILURE:
+
+    return (false);
+}
+
+bool configSetDecayRawLeakRate(uint32_t rawLeakRate) {
+    struct config       config;
+
+    if (storageRead(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+    config.decay.rawLeakRate = rawLeakRate;
+
+    if (storageWrite(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+
+    return (true);
+SPACE_FAILURE:
+
+    return (false);
+}
+
+uint32_t configGetDecayTimeout(void) {
+    struct config       config;
+
+    storageRead(Storage, &config);
+
+    return (config.decay.time);
+}
+
+uint32_t configGetDecayRawLeakRate(void) {
+    struct config       config;
+
+    storageRead(Storage, &config);
+
+    return (config.decay.rawLeakRate);
+}
+
+uint32_t configGetDecayDefaultTimeout(void) {
+
+    return (CONFIG_DEF_DECAY_TIMEOUT);
+}
+
+uint32_t configGetDecayDefaultRawLeakRate(void) {
+
+    return (CONFIG_DEF_DECAY_RAW_LEAK_RATE);
+}
+
 uint32_t configGetRetryCount(void)
 {
     return (CONFIG_DEF_RETRY_COUNT);
 }
 
+bool configSetPredictMode(uint32_t mode) {
+    struct config       config;
+
+    if (mode >= PREDICT_LAST_MODE) {
+        goto SPACE_FAILURE;
+    }
+
+    if (storageRead(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+    config.predictMode = mode;
+
+    if (storageWrite(Storage, &config) != ES_ERROR_NONE) {
+        goto SPACE_FAILURE;
+    }
+
+    return (true);
+SPACE_FAILURE:
+
+    return (false);
+}
+
+uint32_t configGetPredictMode(void) {
+    struct config       config;
+
+    storageRead(Storage, &config);
+
+    return (config.predictMode);
+}
+
 bool configIsPasswordCharValid(char character, uint8_t position) {
     struct config       config;
 
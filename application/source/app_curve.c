@@ -0,0 +1,174 @@
+
+#include <stddef.h>
+
+#include "app_curve.h"
+#include "app_gpu.h"
+
+/*
+ * Plot area in pixels. Threshold lines are placed relative to the full scale
+ * which is set to 125% of the higher threshold.
+ */
+#define CONFIG_CURVE_X0                 20
+#define CONFIG_CURVE_X1                 300
+#define CONFIG_CURVE_Y0                 90
+#define CONFIG_CURVE_Y1                 220
+
+/*
+ * The axis layer is a precompiled display list fragment which is appended to
+ * each frame with CMD_APPEND. It is placed at the end of RAM_G, above the
+ * manufacturer logo.
+ */
+#define CONFIG_CURVE_LAYER_ADDR         (RAM_G + 196608ul)
+#define CONFIG_CURVE_LAYER_WORDS        32
+
+#define CURVE_WIDTH                     (CONFIG_CURVE_X1 - CONFIG_CURVE_X0)
+#define CURVE_HEIGHT                    (CONFIG_CURVE_Y1 - CONFIG_CURVE_Y0)
+
+static uint32_t curveToX(uint32_t index);
+static uint32_t curveToY(const struct curve * curve, uint32_t rawVacuum);
+static void curveCompact(struct curve * curve);
+
+/*
+ * All stations test against the same thresholds, so one axis layer serves
+ * every curve.
+ */
+static uint32_t LayerSize;
+
+static uint32_t curveToX(uint32_t index) {
+
+    return ((CONFIG_CURVE_X0 * 16u) + (index * CURVE_WIDTH * 16u) / (CONFIG_CURVE_POINTS - 1u));
+}
+
+static uint32_t curveToY(const struct curve * curve, uint32_t rawVacuum) {
+
+    if (rawVacuum > curve->rawFullScale) {
+        rawVacuum = curve->rawFullScale;
+    }
+
+    return ((CONFIG_CURVE_Y1 * 16u) - (rawVacuum * CURVE_HEIGHT * 16u) / curve->rawFullScale);
+}
+
+/*
+ * When the buffer is full every two neighbouring points are merged into one
+ * and the decimation factor is doubled, so the whole test always fits in the
+ * plot area regardless of the configured timeouts.
+ */
+static void curveCompact(struct curve * curve) {
+    uint32_t            cnt;
+
+    for (cnt = 0u; cnt < (CONFIG_CURVE_POINTS / 2u); cnt++) {
+        uint16_t        sample;
+
+        sample = curve->sample[cnt * 2u];
+
+        if (sample < curve->sample[cnt * 2u + 1u]) {
+            sample = curve->sample[cnt * 2u + 1u];
+        }
+        curve->sample[cnt] = sample;
+        curve->vertex[cnt] = VERTEX2F(curveToX(cnt), curveToY(curve, sample));
+    }
+    curve->count       = CONFIG_CURVE_POINTS / 2u;
+    curve->decimation *= 2u;
+}
+
+void curveStart(struct curve * curve, uint32_t rawTh0Value, uint32_t rawTh1Value, uint32_t nSamples) {
+    uint32_t            layer[CONFIG_CURVE_LAYER_WORDS];
+    uint32_t            cnt;
+
+    curve->count           = 0u;
+    curve->decimationCount = 0u;
+    curve->decimationMax   = 0u;
+    curve->decimation      = (nSamples + CONFIG_CURVE_POINTS - 1u) / CONFIG_CURVE_POINTS;
+
+    if (curve->decimation == 0u) {
+        curve->decimation = 1u;
+    }
+    curve->rawFullScale  = (rawTh0Value > rawTh1Value ? rawTh0Value : rawTh1Value);
+    curve->rawFullScale += curve->rawFullScale / 4u;
+
+    if (curve->rawFullScale == 0u) {
+        curve->rawFullScale = 1u;
+    }
+    cnt = 0u;
+    layer[cnt++] = SAVE_CONTEXT();
+    layer[cnt++] = LINE_WIDTH(8);
+    layer[cnt++] = COLOR_RGB(160, 160, 160);
+    layer[cnt++] = BEGIN(LINES);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, (CONFIG_CURVE_Y0 + CURVE_HEIGHT / 4) * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, (CONFIG_CURVE_Y0 + CURVE_HEIGHT / 4) * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, (CONFIG_CURVE_Y0 + CURVE_HEIGHT / 2) * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, (CONFIG_CURVE_Y0 + CURVE_HEIGHT / 2) * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, (CONFIG_CURVE_Y1 - CURVE_HEIGHT / 4) * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, (CONFIG_CURVE_Y1 - CURVE_HEIGHT / 4) * 16);
+    layer[cnt++] = COLOR_RGB(224, 160, 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, curveToY(curve, rawTh0Value));
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, curveToY(curve, rawTh0Value));
+    layer[cnt++] = COLOR_RGB(224, 16, 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, curveToY(curve, rawTh1Value));
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, curveToY(curve, rawTh1Value));
+    layer[cnt++] = END();
+    layer[cnt++] = LINE_WIDTH(16);
+    layer[cnt++] = COLOR_RGB(0, 0, 0);
+    layer[cnt++] = BEGIN(LINE_STRIP);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, CONFIG_CURVE_Y0 * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X0 * 16, CONFIG_CURVE_Y1 * 16);
+    layer[cnt++] = VERTEX2F(CONFIG_CURVE_X1 * 16, CONFIG_CURVE_Y1 * 16);
+    layer[cnt++] = END();
+    layer[cnt++] = RESTORE_CONTEXT();
+    LayerSize = cnt * sizeof(layer[0]);
+    gpuSync();                                                                  /* Previous frame may still reference the old layer         */
+    Ft_Gpu_Hal_WrMem(&Gpu, CONFIG_CURVE_LAYER_ADDR, (const uint8_t *)layer, LayerSize);
+}
+
+bool curvePush(struct curve * curve, uint32_t rawVacuum) {
+
+    if (curve->decimationMax < rawVacuum) {
+        curve->decimationMax = rawVacuum;
+    }
+    curve->decimationCount++;
+
+    if (curve->decimationCount < curve->decimation) {
+
+        return (false);
+    }
+
+    if (curve->count == CONFIG_CURVE_POINTS) {
+        curveCompact(curve);
+    }
+
+    if (curve->decimationMax > UINT16_MAX) {
+        curve->decimationMax = UINT16_MAX;
+    }
+    curve->sample[curve->count] = (uint16_t)curve->decimationMax;
+    curve->vertex[curve->count] = VERTEX2F(curveToX(curve->count), curveToY(curve, curve->decimationMax));
+    curve->count++;
+    curve->decimationCount = 0u;
+    curve->decimationMax   = 0u;
+
+    return (true);
+}
+
+void constructCurve(const struct curve * curve) {
+    Ft_Gpu_CoCmd_Append(&Gpu, CONFIG_CURVE_LAYER_ADDR, LayerSize);
+
+    if (curve->count > 1u) {
+        Ft_Gpu_Hal_WrCmd32(&Gpu, SAVE_CONTEXT());
+        Ft_Gpu_Hal_WrCmd32(&Gpu, LINE_WIDTH(24));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(16, 16, 224));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, BEGIN(LINE_STRIP));
+        Ft_Gpu_Hal_WrCmdBuf(&Gpu, (uint8_t *)curve->vertex, curve->count * sizeof(curve->vertex[0]));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, END());
+        Ft_Gpu_Hal_WrCmd32(&Gpu, RESTORE_CONTEXT());
+    }
+}
+
+uint32_t curveGetSamples(const struct curve * curve, const uint16_t ** samples) {
+    *samples = curve->sample;
+
+    return (curve->count);
+}
+
+uint32_t curveGetDecimation(const struct curve * curve) {
+
+    return (curve->decimation);
+}
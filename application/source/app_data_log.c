@@ -1,11 +1,24 @@
 
+#include <string.h>
+
 #include "app_data_log.h"
 #include "app_storage.h"
 #include "MDD File System/FSIO.h"
-#include "arch/systimer.h"
 #include "app_string.h"
+#include "app_psensor.h"
+#include "app_gpu.h"
+#include "app_usb.h"
+#include "app_log_format.h"
+#include "delta/delta.h"
+#include "checksum/checksum.h"
 
 #define APP_DATA_LOG_SIGNATURE          0xdedefefeu
+#define APP_DATA_LOG_V0_RAW_SHIFT       2
+#define APP_DATA_LOG_MAX_FILE_NO        999u
+
+#if (CONFIG_PSENSOR_CALIB_POINTS > LOG_BIN_CALIB_POINTS)
+# error "Binary export header has no room for all calibration points"
+#endif
 
 
 struct dataLogEntry {
@@ -13,6 +26,19 @@ struct dataLogEntry {
     struct appDataLog   log;
 };
 
+/*
+ * Entry of the firmware before the pump-down curve. A log written in this
+ * layout stays in it until appDataLogRestart(). Its raw values are 10-bit
+ * readings, entries added later are stored in the same scale.
+ */
+struct dataLogEntryV0 {
+    struct appTime      timestamp;
+    struct appUser      user;
+    uint32_t            numOfTests;
+    struct thData       th[2];
+    bool                hasPassed;
+};
+
 struct dataLogTable {
     uint32_t            nEntries;
     uint32_t            headNo;
@@ -23,9 +49,18 @@ struct dataLogTable {
     }                   layout;
 };
 
+/*
+ * Id of the first entry which was not exported yet by an incremental export.
+ */
+struct exportCursor {
+    uint32_t            nextId;
+};
+
 static struct storageSpace *  Storage;
 static struct storageSpace *  ArrayStorage;
+static struct storageSpace *  CursorStorage;
 static struct storageArray    ArrayHandle;
+static bool                   IsLegacyLayout;
 
 const struct storageEntry DataLogStorage = {
     APP_DATA_LOG_SIGNATURE,
@@ -39,6 +74,12 @@ const struct storageEntry ArrayDescStorage = {
     &ArrayStorage
 };
 
+const struct storageEntry ExportCursorStorage = {
+    APP_DATA_LOG_SIGNATURE,
+    sizeof(struct exportCursor),
+    &CursorStorage
+};
+
 #if (CONFIG_USE_DIRECT_ENTRY == 1)
 static void dataLogTableReset(struct dataLogTable * logTable) {
     logTable->nEntries = 0u;
@@ -48,9 +89,16 @@ static void dataLogTableReset(struct dataLogTable * logTable) {
 #endif
 
 esError initAppDataLog(void) {
+    IsLegacyLayout = false;
+
     if (storageRead(ArrayStorage, &ArrayHandle) != ES_ERROR_NONE) {
         storageRegisterArray(&ArrayHandle, sizeof(struct dataLogEntry));
         storageWrite(ArrayStorage, &ArrayHandle);
+    } else if (ArrayHandle.entryDesc.size == sizeof(struct dataLogEntryV0)) {
+        IsLegacyLayout = true;
+    } else if (ArrayHandle.entryDesc.size != sizeof(struct dataLogEntry)) {
+        storageRegisterArray(&ArrayHandle, sizeof(struct dataLogEntry));
+        storageWrite(ArrayStorage, &ArrayHandle);
     }
     return (ES_ERROR_NONE);
 }
@@ -84,11 +132,31 @@ esError appDataLogNumberOfEntries(uint32_t * nEntries) {
 esError appDataLogHeadId(uint32_t * headId);
 esError appDataLogLoad(uint32_t entryId, struct appDataLog * dataLog);
 #else
+/*
+ * A log in the layout before the pump-down curve keeps its history readable,
+ * new entries are stored in the same layout and 10-bit scale without their
+ * curve.
+ */
 esError appDataLogSave(const struct appDataLog * dataLog) {
 
     esError                     error;
 
-    error = storageArrayWrite(&ArrayHandle, dataLog);
+    if (IsLegacyLayout) {
+        struct dataLogEntryV0   entry;
+
+        memset(&entry, 0, sizeof(entry));
+        entry.timestamp  = dataLog->timestamp;
+        entry.user       = dataLog->user;
+        entry.numOfTests = dataLog->numOfTests;
+        entry.th[0]      = dataLog->th[0];
+        entry.th[1]      = dataLog->th[1];
+        entry.hasPassed  = dataLog->hasPassed;
+        entry.th[0].rawMaxValue >>= APP_DATA_LOG_V0_RAW_SHIFT;
+        entry.th[1].rawMaxValue >>= APP_DATA_LOG_V0_RAW_SHIFT;
+        error = storageArrayWrite(&ArrayHandle, &entry);
+    } else {
+        error = storageArrayWrite(&ArrayHandle, dataLog);
+    }
 
     if (!error) {
         error = storageWrite(ArrayStorage, &ArrayHandle);
@@ -97,6 +165,68 @@ esError appDataLogSave(const struct appDataLog * dataLog) {
     return (error);
 }
 
+/*
+ * When the curve does not fit into the payload every two neighbouring points
+ * are merged, keeping the higher vacuum, and the period is doubled.
+ */
+void appDataLogSetCurve(struct appDataLog * dataLog, const uint16_t * samples, uint32_t nSamples, uint32_t period) {
+    uint16_t                    points[CONFIG_DATA_LOG_CURVE_POINTS];
+    uint32_t                    cnt;
+    size_t                      size;
+
+    if (nSamples > CONFIG_DATA_LOG_CURVE_POINTS) {
+        nSamples = CONFIG_DATA_LOG_CURVE_POINTS;
+    }
+
+    for (cnt = 0u; cnt < nSamples; cnt++) {
+        points[cnt] = samples[cnt];
+    }
+
+    while ((size = deltaEncode(points, nSamples, dataLog->curve.data, sizeof(dataLog->curve.data))) == 0u) {
+
+        if (nSamples == 0u) {
+            break;
+        }
+
+        if (nSamples == 1u) {
+            nSamples = 0u;
+
+            break;
+        }
+
+        for (cnt = 0u; cnt < (nSamples / 2u); cnt++) {
+            points[cnt] = points[cnt * 2u];
+
+            if (points[cnt] < points[cnt * 2u + 1u]) {
+                points[cnt] = points[cnt * 2u + 1u];
+            }
+        }
+
+        if ((nSamples % 2u) != 0u) {                                            /* Odd last point has no pair, it is kept as it is          */
+            points[cnt] = points[nSamples - 1u];
+        }
+        nSamples  = (nSamples + 1u) / 2u;
+        period   *= 2u;
+    }
+    dataLog->curve.nPoints = (uint16_t)nSamples;
+    dataLog->curve.period  = (uint16_t)period;
+    dataLog->curve.size    = (uint16_t)size;
+}
+
+uint32_t appDataLogGetCurve(const struct appDataLog * dataLog, uint16_t * samples, uint32_t nSamples) {
+
+    if (nSamples > dataLog->curve.nPoints) {
+        nSamples = dataLog->curve.nPoints;
+    }
+
+    if (dataLog->curve.size > sizeof(dataLog->curve.data)) {
+
+        return (0u);
+    }
+
+    return (deltaDecode(dataLog->curve.data, dataLog->curve.size, samples, nSamples));
+}
+
 esError appDataLogNumberOfSlots(uint32_t * nSlots) {
     *nSlots = storageArrayMaxNEntries(&ArrayHandle);
 
@@ -115,12 +245,104 @@ esError appDataLogHeadId(uint32_t * headId) {
 
 esError appDataLogLoad(uint32_t entryId, struct appDataLog * dataLog) {
 
+    if (IsLegacyLayout) {
+        struct dataLogEntryV0   entry;
+        esError                 error;
+
+        error = storageArrayRead(&ArrayHandle, entryId, &entry);
+
+        if (error) {
+            return (error);
+        }
+        memset(dataLog, 0, sizeof(*dataLog));
+        dataLog->timestamp  = entry.timestamp;
+        dataLog->user       = entry.user;
+        dataLog->numOfTests = entry.numOfTests;
+        dataLog->th[0]      = entry.th[0];
+        dataLog->th[1]      = entry.th[1];
+        dataLog->hasPassed  = entry.hasPassed;
+        dataLog->th[0].rawMaxValue <<= APP_DATA_LOG_V0_RAW_SHIFT;
+        dataLog->th[1].rawMaxValue <<= APP_DATA_LOG_V0_RAW_SHIFT;
+
+        return (ES_ERROR_NONE);
+    }
+
     return (storageArrayRead(&ArrayHandle, entryId, dataLog));
 }
 
+static uint32_t dataLogDateKey(const struct appTime * time) {
+
+    return ((uint32_t)time->day + ((uint32_t)time->month * 31ul) + ((uint32_t)time->year * 31ul * 12ul));
+}
+
+/*
+ * Entries are appended in time order, so the array is sorted by date starting
+ * from the oldest entry. Returns the id of the first entry dated after key.
+ */
+static esError dataLogSearchAfter(uint32_t key, uint32_t * entryId) {
+    struct appDataLog           dataLog;
+    esError                     error;
+    uint32_t                    lower;
+    uint32_t                    upper;
+
+    lower = 0u;
+    upper = storageArrayNEntries(&ArrayHandle);
+
+    while (lower < upper) {
+        uint32_t                middle;
+
+        middle = lower + ((upper - lower) / 2u);
+        error  = storageArrayRead(&ArrayHandle, middle, &dataLog);
+
+        if (error) {
+            return (error);
+        }
+
+        if (dataLogDateKey(&dataLog.timestamp) <= key) {
+            lower = middle + 1u;
+        } else {
+            upper = middle;
+        }
+    }
+    *entryId = lower;
+
+    return (ES_ERROR_NONE);
+}
+
+/*
+ * Only the dates of begin and end are used and both days are included. On
+ * return entries from firstId up to, but not including, endId are in range.
+ */
+esError appDataLogFindRange(const struct appTime * begin, const struct appTime * end, uint32_t * firstId,
+    uint32_t * endId) {
+
+    esError                     error;
+
+    error = dataLogSearchAfter(dataLogDateKey(begin) - 1u, firstId);
+
+    if (error) {
+        return (error);
+    }
+    error = dataLogSearchAfter(dataLogDateKey(end), endId);
+
+    if (error) {
+        return (error);
+    }
+
+    if (*endId < *firstId) {
+        *endId = *firstId;
+    }
+
+    return (ES_ERROR_NONE);
+}
+
+/*
+ * The drive is mounted by the USB module when it attaches, the export only
+ * checks that it is still there.
+ */
 esError appDataLogExportInit(void) {
 
-    if (FSInit()) {
+    if (isUsbMounted()) {
 
         return (ES_ERROR_NONE);
     } else {
@@ -129,93 +351,486 @@ esError appDataLogExportInit(void) {
     }
 }
 
+#if defined(FT_GPU_HAL_PROFILE)
+static esError exportGpuProfile(void) {
+    FSFILE *                    fileHandle;
+    struct gpuProfileRecord     record;
+    char                        primaryBuff[128];
+    uint32_t                    age;
+    size_t                      length;
+
+    fileHandle = FSfopen("GPUPROF.TXT", FS_WRITE);
+
+    if (fileHandle == NULL) {
+        return (ES_ERROR_NOT_PERMITTED);
+    }
+    length = nstrcpy(primaryBuff, "screen, words, bytes, wait ticks, frame ticks\r\n");
+    FSfwrite(primaryBuff, 1, length, fileHandle);
+
+    for (age = 0u; gpuProfileGet(age, &record); age++) {
+        length  = 0u;
+        length += nstrcpy(&primaryBuff[length], record.screen);
+        length += nstrcpy(&primaryBuff[length], ", ");
+        length += sprintUint32(&primaryBuff[length], record.cmdWords);
+        length += nstrcpy(&primaryBuff[length], ", ");
+        length += sprintUint32(&primaryBuff[length], record.spiBytes);
+        length += nstrcpy(&primaryBuff[length], ", ");
+        length += sprintUint32(&primaryBuff[length], record.waitTicks);
+        length += nstrcpy(&primaryBuff[length], ", ");
+        length += sprintUint32(&primaryBuff[length], record.frameTicks);
+        length += nstrcpy(&primaryBuff[length], "\r\n");
+        FSfwrite(primaryBuff, 1, length, fileHandle);
+    }
+    FSfclose(fileHandle);
+
+    return (ES_ERROR_NONE);
+}
+#endif
+
 esError appDataLogExportTerm(void) {
+#if defined(FT_GPU_HAL_PROFILE)
+
+    return (exportGpuProfile());
+#else
 
     return (ES_ERROR_NONE);
+#endif
+}
+
+
+
+/*
+ * All selected entries are streamed into a single CSV file, one entry per
+ * line. The leak columns are empty when the leak test did not run. The curve,
+ * when present, takes the columns after the curve period.
+ */
+#define LOG_CSV_HEADER                                                          \
+    "Entry,Date,Time,User,Result,Predicted,Tests,"                              \
+    "Th1 max (inHg),Th1 time (ms),Th2 max (inHg),Th2 time (ms),"                \
+    "Leak result,Leak rate (inHg/min),"                                         \
+    "Curve period (ms),Curve (inHg)\r\n"
+#define LOG_CSV_ENTRY_SIZE              160
+#define LOG_CSV_POINT_SIZE              8
+
+/*
+ * Largest binary record, an entry block with its curve block.
+ */
+#define LOG_BIN_RECORD_SIZE                                                     \
+    (LOG_BIN_BLOCK_SIZE + LOG_BIN_ENTRY_SIZE +                                  \
+     LOG_BIN_BLOCK_SIZE + LOG_BIN_CURVE_SIZE + CONFIG_DATA_LOG_CURVE_SIZE)
+
+#if (LOG_BIN_RECORD_SIZE > LOG_CSV_ENTRY_SIZE)
+# error "Binary record does not fit into the export buffer slack"
+#endif
+
+struct exportStream {
+    FSFILE *            file;
+    size_t              length;
+    esError             error;
+    enum dataLogFormat  format;
+    uint32_t            nEntries;
+    uint32_t            crc;                                                    /* CRC-32 of the binary file so far                         */
+    char                buffer[CONFIG_DATA_LOG_EXPORT_BUFFER + LOG_CSV_ENTRY_SIZE];
+};
+
+static struct exportStream Stream;
+
+/*
+ * Until the last flush only whole sectors are written, the rest is moved to the
+ * start of the buffer. Every write then starts at a sector boundary of the file
+ * and FSfwrite() passes the buffer straight to the drive. The entry size past
+ * CONFIG_DATA_LOG_EXPORT_BUFFER makes every such write the same whole size.
+ */
+static void exportFlush(bool isLast) {
+    size_t              length;
+
+    length = Stream.length;
+
+    if (!isLast) {
+        length -= length % MEDIA_SECTOR_SIZE;
+    }
+
+    if ((length != 0u) && (Stream.error == ES_ERROR_NONE)) {
+
+        if (FSfwrite(Stream.buffer, 1, length, Stream.file) != length) {
+            Stream.error = ES_ERROR_DEVICE_FAIL;
+        }
+    }
+    Stream.length -= length;
+    memmove(Stream.buffer, &Stream.buffer[length], Stream.length);
+}
+
+/*
+ * Returns the free part of the export buffer which is at least size bytes big.
+ */
+static char * exportReserve(size_t size) {
+
+    if ((Stream.length + size) > sizeof(Stream.buffer)) {
+        exportFlush(false);
+    }
+
+    return (&Stream.buffer[Stream.length]);
 }
 
+static size_t sprintUint2(char * buffer, uint32_t value) {
+    buffer[0] = (char)('0' + ((value / 10u) % 10u));
+    buffer[1] = (char)('0' + (value % 10u));
 
+    return (2u);
+}
+
+static bool isFileFree(const char * name) {
+    FSFILE *                    file;
+
+    file = FSfopen(name, FS_READ);
+
+    if (file == NULL) {
+        return (true);
+    }
+    FSfclose(file);
+
+    return (false);
+}
+
+static uint32_t exportHour(const struct appTime * time) {
+    uint32_t                    hour;
+
+    hour = time->hour % 12u;
+
+    if (time->daySelector == APPTIME_PM) {
+        hour += 12u;
+    }
+
+    return (hour);
+}
+
+static size_t putUint8(char * buffer, uint32_t value) {
+    buffer[0] = (char)(value & 0xffu);
+
+    return (1u);
+}
+
+static size_t putUint16(char * buffer, uint32_t value) {
+    buffer[0] = (char)(value & 0xffu);
+    buffer[1] = (char)((value >> 8) & 0xffu);
+
+    return (2u);
+}
+
+static size_t putUint32(char * buffer, uint32_t value) {
+    buffer[0] = (char)(value & 0xffu);
+    buffer[1] = (char)((value >> 8) & 0xffu);
+    buffer[2] = (char)((value >> 16) & 0xffu);
+    buffer[3] = (char)((value >> 24) & 0xffu);
+
+    return (4u);
+}
+
+static size_t putTime(char * buffer, const struct appTime * time) {
+    size_t                      length;
+
+    length  = putUint16(buffer, time->year);
+    length += putUint8(&buffer[length], time->month);
+    length += putUint8(&buffer[length], time->day);
+    length += putUint8(&buffer[length], exportHour(time));
+    length += putUint8(&buffer[length], time->minute);
+    length += putUint8(&buffer[length], time->second);
+
+    return (length);
+}
+
+static size_t putBlock(char * buffer, uint32_t type, uint32_t size) {
+    size_t                      length;
+
+    length  = putUint16(buffer, type);
+    length += putUint16(&buffer[length], size);
+
+    return (length);
+}
+
+/*
+ * Binary records are composed in place by the put functions and then appended
+ * here, which keeps the running CRC of the file.
+ */
+static void exportAppend(const char * buffer, size_t length) {
+    Stream.crc     = checksumCrc32(Stream.crc, buffer, length);
+    Stream.length += length;
+}
+
+/*
+ * The calibration is stored in the header, so the decoder converts raw values
+ * the same way the tester does.
+ */
+static void exportBinaryHeader(const struct appTime * time) {
+    uint32_t                    rawVacuum[CONFIG_PSENSOR_CALIB_POINTS];
+    uint32_t                    vacuum[CONFIG_PSENSOR_CALIB_POINTS];
+    uint32_t                    nPoints;
+    uint32_t                    cnt;
+    char *                      buffer;
+    size_t                      length;
+
+    nPoints = dutGetCalibration(rawVacuum, vacuum);
+    buffer  = exportReserve(LOG_BIN_HEADER_SIZE);
+    length  = nstrcpy(buffer, LOG_BIN_MAGIC);
+    length += putUint16(&buffer[length], LOG_BIN_VERSION);
+    length += putUint16(&buffer[length], LOG_BIN_HEADER_SIZE);
+    length += putTime(&buffer[length], time);
+    length += putUint8(&buffer[length], nPoints);
+
+    for (cnt = 0u; cnt < LOG_BIN_CALIB_POINTS; cnt++) {
+        length += putUint32(&buffer[length], cnt < nPoints ? rawVacuum[cnt] : 0u);
+        length += putUint32(&buffer[length], cnt < nPoints ? vacuum[cnt]    : 0u);
+    }
+    exportAppend(buffer, length);
+}
+
+/*
+ * Values are stored the way they are kept in the log, the curve is copied
+ * still delta encoded.
+ */
+static void exportBinaryEntry(uint32_t entryId, const struct appDataLog * log) {
+    char *                      buffer;
+    size_t                      length;
+
+    buffer  = exportReserve(LOG_BIN_RECORD_SIZE);
+    length  = putBlock(buffer, LOG_BIN_ENTRY, LOG_BIN_ENTRY_SIZE);
+    length += putUint32(&buffer[length], entryId);
+    length += putTime(&buffer[length], &log->timestamp);
+    length += putUint8(&buffer[length], (log->hasPassed ? LOG_BIN_FLAG_PASSED : 0u) |
+        (log->isPredicted ? LOG_BIN_FLAG_PREDICTED : 0u));
+    length += putUint32(&buffer[length], log->user.id);
+    length += putUint32(&buffer[length], log->numOfTests);
+    length += putUint32(&buffer[length], log->th[0].rawMaxValue);
+    length += putUint32(&buffer[length], log->th[0].time);
+    length += putUint32(&buffer[length], log->th[1].rawMaxValue);
+    length += putUint32(&buffer[length], log->th[1].time);
+    length += putUint8(&buffer[length], log->decay.state);                      /* LOG_BIN_LEAK_* follow enum dataLogDecay                  */
+    length += putUint32(&buffer[length], (uint32_t)log->decay.rawRate);
+
+    if ((log->curve.nPoints != 0u) && (log->curve.size <= sizeof(log->curve.data))) {
+        length += putBlock(&buffer[length], LOG_BIN_CURVE, LOG_BIN_CURVE_SIZE + log->curve.size);
+        length += putUint16(&buffer[length], log->curve.nPoints);
+        length += putUint16(&buffer[length], log->curve.period);
+        memcpy(&buffer[length], log->curve.data, log->curve.size);
+        length += log->curve.size;
+    }
+    exportAppend(buffer, length);
+    Stream.nEntries++;
+}
 
-#define LOG_SEPARATOR           "--------------------\r\n"
-#define LOG_HEADER              "Nitto wwww.nitto.com\r\n" LOG_SEPARATOR
-#define LOG_ENTRY_ID            "Entry Id: "
-#define LOG_TIME                "Time    : "
-#define LOG_RESULTS             "Passed  : "
+/*
+ * The CRC is the last field, it covers everything written before it.
+ */
+static void exportBinaryEnd(void) {
+    char *                      buffer;
+    size_t                      length;
 
-esError appDataLogExport(uint32_t entryId) {
+    buffer  = exportReserve(LOG_BIN_BLOCK_SIZE + LOG_BIN_END_SIZE);
+    length  = putBlock(buffer, LOG_BIN_END, LOG_BIN_END_SIZE);
+    length += putUint32(&buffer[length], Stream.nEntries);
+    exportAppend(buffer, length);
+    Stream.length += putUint32(&buffer[length], Stream.crc);
+}
+
+esError appDataLogExportBegin(enum dataLogFormat format) {
     struct appTime              currentTime;
-    FSFILE *                    fileHandle;
     esError                     error;
+    char                        name[16];
+    size_t                      length;
+    uint32_t                    fileNo;
+
+    if ((error = appTimeGet(&currentTime)) != ES_ERROR_NONE) {
+        return (error);
+    }
+    length  = 0u;                                                               /* MMDDhhmm.CSV or .BIN                                     */
+    length += sprintUint2(&name[length], currentTime.month);
+    length += sprintUint2(&name[length], currentTime.day);
+    length += sprintUint2(&name[length], exportHour(&currentTime));
+    length += sprintUint2(&name[length], currentTime.minute);
+    length += nstrcpy(&name[length], format == DATA_LOG_FORMAT_BINARY ? ".BIN" : ".CSV");
+    name[length] = '\0';
+    fileNo       = 0u;
+
+    while (!isFileFree(name)) {                                                 /* FS_WRITE would truncate an earlier export                */
+        fileNo++;
+
+        if (fileNo > APP_DATA_LOG_MAX_FILE_NO) {
+            return (ES_ERROR_NOT_PERMITTED);
+        }
+        name[4] = '_';                                                          /* MMDD_nnn, can not be taken for a time                    */
+        name[5] = (char)('0' + (fileNo / 100u));
+        (void)sprintUint2(&name[6], fileNo);
+    }
+    Stream.length   = 0u;
+    Stream.error    = ES_ERROR_NONE;
+    Stream.format   = format;
+    Stream.nEntries = 0u;
+    Stream.crc      = 0u;
+    Stream.file     = FSfopen(name, FS_WRITE);
+
+    if (Stream.file == NULL) {
+        return (ES_ERROR_NOT_PERMITTED);
+    }
+
+    if (format == DATA_LOG_FORMAT_BINARY) {
+        exportBinaryHeader(&currentTime);
+    } else {
+        Stream.length = nstrcpy(Stream.buffer, LOG_CSV_HEADER);
+    }
+
+    return (ES_ERROR_NONE);
+}
+
+esError appDataLogExportEntry(uint32_t entryId) {
     struct appDataLog           currentLog;
-    char                        primaryBuff[512];
-    uint32_t                    shortNameSeed;
+    esError                     error;
+    char *                      buffer;
     size_t                      length;
 
+    if (Stream.file == NULL) {
+        return (ES_ERROR_NOT_PERMITTED);
+    }
     error = appDataLogLoad(entryId, &currentLog);
 
     if (error) {
-        return (error);
-    }
 
-    if ((error = appTimeGet(&currentTime)) != ES_ERROR_NONE) {
+        if (Stream.error == ES_ERROR_NONE) {
+            Stream.error = error;
+        }
+
         return (error);
     }
-#if 0
-    length  = 0;
-    length += nstrcpy(&LFNnameW[length], "V");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.year);
-    length += nstrcpy(&LFNnameW[length], "_");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.month);
-    length += nstrcpy(&LFNnameW[length], "_");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.day);
-    length += nstrcpy(&LFNnameW[length], "_");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.hour);
-    length += nstrcpy(&LFNnameW[length], "_");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.minute);
-    length += nstrcpy(&LFNnameW[length], "_");
-    length += sprintUint32(&LFNnameW[length], currentLog.timestamp.second);
-    length += nstrcpy(&LFNnameW[length], "-");
-    length += sprintUint32(&LFNnameW[length], entryId);
-    LFNnameW[length] = '\0';
-    LFNnameW[0] = '\0';
-#endif
-    shortNameSeed = entryId + ES_SYSTIMER_GET_CVAL() +
-                (uint32_t)currentTime.second +
-               ((uint32_t)currentTime.minute * 60ul) +
-               ((uint32_t)currentTime.hour   * 3600ul);
-    shortNameSeed = shortNameSeed % 1000000ul;
-    length  = 0;
-    length += nstrcpy(&primaryBuff[length], "V");
-    length += sprintUint32(&primaryBuff[length], shortNameSeed);
-    length += nstrcpy(&primaryBuff[length], ".LOG");
-    primaryBuff[length] = '\0';
-    fileHandle = FSfopen(primaryBuff, FS_WRITE);
 
-    if (fileHandle == NULL) {
-        return (ES_ERROR_NOT_PERMITTED);
+    if (Stream.format == DATA_LOG_FORMAT_BINARY) {
+        exportBinaryEntry(entryId, &currentLog);
+
+        return (Stream.error);
     }
+    buffer  = exportReserve(LOG_CSV_ENTRY_SIZE);
     length  = 0u;
-    length += nstrcpy(&primaryBuff[length], LOG_HEADER);
-    length += nstrcpy(&primaryBuff[length], "\r\n");
-    length += nstrcpy(&primaryBuff[length], LOG_ENTRY_ID);
-    length += sprintUint32(&primaryBuff[length], entryId);
-    length += nstrcpy(&primaryBuff[length], "\r\n");
-    length += nstrcpy(&primaryBuff[length], LOG_TIME);
-    length += snprintRtcDate(&currentLog.timestamp, &primaryBuff[length]);
-    length += nstrcpy(&primaryBuff[length], " ");
-    length += snprintRtcTime(&currentLog.timestamp, &primaryBuff[length]);
-    length += nstrcpy(&primaryBuff[length], "\r\n");
-    length += nstrcpy(&primaryBuff[length], LOG_RESULTS);
-
-    if (currentLog.hasPassed) {
-        length += nstrcpy(&primaryBuff[length], "PASSED");
+    length += sprintUint32(&buffer[length], entryId);
+    length += nstrcpy(&buffer[length], ",");
+    length += snprintRtcDate(&currentLog.timestamp, &buffer[length]);
+    length += nstrcpy(&buffer[length], ",");
+    length += snprintRtcTime(&currentLog.timestamp, &buffer[length]);
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], currentLog.user.id);
+    length += nstrcpy(&buffer[length], currentLog.hasPassed ? ",PASSED," : ",FAILED,");
+    length += nstrcpy(&buffer[length], currentLog.isPredicted ? "YES," : "NO,");
+    length += sprintUint32(&buffer[length], currentLog.numOfTests);
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], dutRawToMm(currentLog.th[0].rawMaxValue));
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], currentLog.th[0].time);
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], dutRawToMm(currentLog.th[1].rawMaxValue));
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], currentLog.th[1].time);
+
+    if (currentLog.decay.state != DATA_LOG_DECAY_NOT_EXECUTED) {
+        length += nstrcpy(&buffer[length],
+            currentLog.decay.state == DATA_LOG_DECAY_PASSED ? ",PASSED," : ",FAILED,");
+        length += sprintUint32(&buffer[length], dutRawRateToMm(
+            currentLog.decay.rawRate > 0 ? (uint32_t)currentLog.decay.rawRate * 60u : 0u,
+            currentLog.th[1].rawMaxValue));
     } else {
-        length += nstrcpy(&primaryBuff[length], "FAILED");
+        length += nstrcpy(&buffer[length], ",,");
+    }
+    length += nstrcpy(&buffer[length], ",");
+    length += sprintUint32(&buffer[length], currentLog.curve.period);
+    Stream.length += length;
+
+    if (currentLog.curve.nPoints != 0u) {
+        uint16_t                points[CONFIG_DATA_LOG_CURVE_POINTS];
+        uint32_t                nPoints;
+        uint32_t                cnt;
+
+        nPoints = appDataLogGetCurve(&currentLog, points, CONFIG_DATA_LOG_CURVE_POINTS);
+
+        for (cnt = 0u; cnt < nPoints; cnt++) {
+            buffer         = exportReserve(LOG_CSV_POINT_SIZE);
+            length         = nstrcpy(buffer, ",");
+            length        += sprintUint32(&buffer[length], dutRawToMm(points[cnt]));
+            Stream.length += length;
+        }
+    }
+    buffer         = exportReserve(LOG_CSV_POINT_SIZE);
+    Stream.length += nstrcpy(buffer, "\r\n");
+
+    return (Stream.error);
+}
+
+esError appDataLogExportEnd(void) {
+    esError                     error;
+
+    if (Stream.file == NULL) {
+        return (ES_ERROR_NOT_PERMITTED);
     }
-    length += nstrcpy(&primaryBuff[length], "\r\n\r\n");
-    FSfwrite(primaryBuff, 1, length, fileHandle);
-    FSfclose(fileHandle);
+
+    if (Stream.format == DATA_LOG_FORMAT_BINARY) {
+        exportBinaryEnd();
+    }
+    exportFlush(true);
+    error       = Stream.error;
+
+    if (FSfclose(Stream.file) != 0) {
+        error = ES_ERROR_DEVICE_FAIL;
+    }
+    Stream.file = NULL;
+
+    return (error);
+}
+
+esError appDataLogExportCursor(uint32_t * entryId) {
+    struct exportCursor         cursor;
+
+    if (storageRead(CursorStorage, &cursor) != ES_ERROR_NONE) {
+        cursor.nextId = 0u;
+    }
+
+    if (cursor.nextId > storageArrayNEntries(&ArrayHandle)) {                   /* Log was cleared after the last export                    */
+        cursor.nextId = 0u;
+    }
+    *entryId = cursor.nextId;
 
     return (ES_ERROR_NONE);
 }
+
+/*
+ * Call only after appDataLogExportEnd() succeeded, otherwise entries which
+ * never reached the drive would be skipped by the next incremental export.
+ */
+esError appDataLogExportSetCursor(uint32_t entryId) {
+    struct exportCursor         cursor;
+
+    cursor.nextId = entryId;
+
+    return (storageWrite(CursorStorage, &cursor));
+}
+
+bool appDataLogIsLegacy(void) {
+    return (IsLegacyLayout);
+}
+
+/*
+ * Erases a log in the layout before the pump-down curve and starts an empty
+ * one in the current layout. Only the operator starts this, after exporting
+ * the old entries. The curve makes an entry about three times bigger, so the
+ * restarted log holds about a third of the entries.
+ */
+esError appDataLogRestart(void) {
+    struct exportCursor         cursor;
+    esError                     error;
+
+    storageRegisterArray(&ArrayHandle, sizeof(struct dataLogEntry));
+    error = storageWrite(ArrayStorage, &ArrayHandle);
+
+    if (error) {
+        return (error);
+    }
+    IsLegacyLayout = false;
+    cursor.nextId  = 0u;
+
+    return (storageWrite(CursorStorage, &cursor));
+}
 #endif
@@ -1,4 +1,6 @@
 
+#include <xc.h>
+
 #include "driver/gpio.h"
 #include "driver/spi.h"
 
@@ -25,8 +27,21 @@ static struct change_slot * g_change_handle;
 
 static void (* ClientHandler)(void);
 
+static bool IsSwapPending;
+
+#if defined(FT_GPU_HAL_PROFILE)
+static struct gpuProfileRecord  FrameStart;
+#endif
+
 Ft_Gpu_Hal_Context_t Gpu;
 
+#if defined(FT_GPU_HAL_PROFILE)
+/* Ring of the last CONFIG_GPU_PROFILE_DEPTH frames, inspect it with debugger
+ * or read it out with gpuProfileGet().
+ */
+struct gpuProfile    GpuProfile;
+#endif
+
 static void gpuInterruptHandler(void) {
 
     if ((*(FT800_INT_PORT)->port & (0x1u << FT800_INT_PIN)) == 0) {
@@ -96,7 +111,16 @@ bool isGpuReady(void) {
     }
 }
 
-void gpuBegin(void) {
+void gpuBeginScreen(const char * screen) {
+#if defined(FT_GPU_HAL_PROFILE)
+    FrameStart.screen     = screen;
+    FrameStart.cmdWords   = Gpu.prof_cmd_words;
+    FrameStart.spiBytes   = Gpu.prof_spi_bytes;
+    FrameStart.waitTicks  = Gpu.prof_wait_ticks;
+    FrameStart.frameTicks = _CP0_GET_COUNT();
+#else
+    (void)screen;
+#endif
     Ft_Gpu_CoCmd_Dlstart(&Gpu);
     Ft_Gpu_Hal_WrCmd32(&Gpu, CLEAR_TAG(0));
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG_MASK(1));
@@ -105,8 +129,62 @@ void gpuBegin(void) {
 void gpuEnd(void) {
     Ft_Gpu_Hal_WrCmd32(&Gpu, DISPLAY());
     Ft_Gpu_CoCmd_Swap(&Gpu);
-    Ft_Gpu_Hal_WaitCmdfifo_empty(&Gpu);
+    IsSwapPending = true;                                                       /* Coprocessor will finish the frame on its own             */
+#if defined(FT_GPU_HAL_PROFILE)
+    {
+        struct gpuProfileRecord * record;
+
+        record = &GpuProfile.record[GpuProfile.head];
+        record->screen     = FrameStart.screen;
+        record->cmdWords   = Gpu.prof_cmd_words  - FrameStart.cmdWords;
+        record->spiBytes   = Gpu.prof_spi_bytes  - FrameStart.spiBytes;
+        record->waitTicks  = Gpu.prof_wait_ticks - FrameStart.waitTicks;
+        record->frameTicks = _CP0_GET_COUNT()    - FrameStart.frameTicks;
+        GpuProfile.head++;
+
+        if (GpuProfile.head == CONFIG_GPU_PROFILE_DEPTH) {
+            GpuProfile.head = 0u;
+        }
+        GpuProfile.frames++;
+    }
+#endif
+}
+
+void gpuSync(void) {
+
+    if (IsSwapPending) {
+        Ft_Gpu_Hal_WaitCmdfifo_empty(&Gpu);
+        IsSwapPending = false;
+    }
+}
+
+bool isGpuBusy(void) {
+
+    if (IsSwapPending && Ft_Gpu_Hal_IsCmdfifo_empty(&Gpu)) {
+        IsSwapPending = false;
+    }
+
+    return (IsSwapPending);
+}
+
+#if defined(FT_GPU_HAL_PROFILE)
+bool gpuProfileGet(uint32_t age, struct gpuProfileRecord * record) {
+    uint32_t            index;
+
+    if ((age >= CONFIG_GPU_PROFILE_DEPTH) || (age >= GpuProfile.frames)) {
+
+        return (false);
+    }
+    index = GpuProfile.head + CONFIG_GPU_PROFILE_DEPTH - 1u - age;
+
+    if (index >= CONFIG_GPU_PROFILE_DEPTH) {
+        index -= CONFIG_GPU_PROFILE_DEPTH;
+    }
+    *record = GpuProfile.record[index];
+
+    return (true);
 }
+#endif
 
 
 uint8_t gpuGetKey(void) {
@@ -0,0 +1,48 @@
+
+#include "app_leak.h"
+
+/*
+ * Leak rate is the slope of a least squares line fitted through the vacuum
+ * samples taken while the pump is off. Only the sums of the fit are kept, so
+ * each sample costs a few additions and the window length is not limited by
+ * memory.
+ */
+
+void leakStart(struct leak * leak, uint32_t periodMs) {
+    leak->sumX     = 0;
+    leak->sumY     = 0;
+    leak->sumXX    = 0;
+    leak->sumXY    = 0;
+    leak->nSamples = 0u;
+    leak->period   = (periodMs == 0u ? 1u : periodMs);
+}
+
+void leakPush(struct leak * leak, uint32_t rawVacuum) {
+    int64_t             x;
+
+    x = leak->nSamples;
+    leak->sumX  += x;
+    leak->sumY  += rawVacuum;
+    leak->sumXX += x * x;
+    leak->sumXY += x * rawVacuum;
+    leak->nSamples++;
+}
+
+/*
+ * Returns the vacuum loss in raw units per second. Positive value means that
+ * the vacuum is decaying.
+ */
+int32_t leakGetRate(const struct leak * leak) {
+    int64_t             num;
+    int64_t             den;
+
+    if (leak->nSamples < 2u) {
+
+        return (0);
+    }
+    num = (int64_t)leak->nSamples * leak->sumXY - leak->sumX * leak->sumY;
+    den = (int64_t)leak->nSamples * leak->sumXX - leak->sumX * leak->sumX;
+    den *= leak->period;
+
+    return ((int32_t)((-num * 1000 + (num < 0 ? den / 2 : -den / 2)) / den));
+}
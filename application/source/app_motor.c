@@ -1,14 +1,55 @@
-
 #include <xc.h>
 #include <stddef.h>
 #include <stdbool.h>
 
 #include "app_motor.h"
+#include "app_psensor.h"
+#include "app_pump.h"
 #include "driver/gpio.h"
 #include "driver/adc.h"
+#include "driver/pwm.h"
 #include "app_timer.h"
 #include "config/pinout_config.h"
 
+#define CONFIG_MOTOR_PWM_FREQUENCY      20000
+
+/*
+ * The pump is shared by all stations. It runs while at least one station needs
+ * it and the loop is closed on the sensor of the station which started it.
+ * When more stations need the pump at the same time no single sensor describes
+ * the manifold any more, so the pump falls back to open loop drive.
+ */
+static struct pump Pump;
+static int32_t MotorRawIdleVacuum;
+static uint32_t MotorStation;
+static uint32_t MotorUsers;
+
+/*
+ * Runs in ADC interrupt context for every pressure sensor sample. Pump duty
+ * cycle has the same scale as PWM duty cycle.
+ */
+static void motorSampleHandler(int32_t rawValue) {
+    pwmSetDuty((uint32_t)pumpUpdate(&Pump, MotorRawIdleVacuum - rawValue));
+}
+
+static void motorStart(uint32_t station, uint32_t rawIdleVacuum, uint32_t rawTarget) {
+
+    if (MotorUsers != 0u) {
+        MotorUsers        |= (0x1u << station);
+        Pump.isControlled  = false;
+
+        return;
+    }
+    MotorUsers         = (0x1u << station);
+    MotorStation       = station;
+    MotorRawIdleVacuum = (int32_t)rawIdleVacuum;
+    pumpStart(&Pump, (int32_t)rawTarget);
+    pwmStart(CONFIG_MOTOR_PWM_FREQUENCY);
+    pwmSetDuty((uint32_t)Pump.duty);
+    CONFIG_MDRIVE_PWM_PPS = CONFIG_MDRIVE_PWM_PPS_OC4;
+    *(CONFIG_MDRIVE_POWER_PORT)->set = (0x1u << CONFIG_MDRIVE_POWER_PIN);
+    dutSetSampleHandler(station, motorSampleHandler);
+}
 
 void initMotorModule(void) {
     *(CONFIG_MSENSOR_GPIO_PORT)->tris  |=  (0x1u << CONFIG_MSENSOR_GPIO_PIN);
@@ -19,16 +60,39 @@ void initMotorModule(void) {
     *(CONFIG_MDRIVE_POWER_PORT)->clr    =  (0x1u << CONFIG_MDRIVE_POWER_PIN);
 
     adcEnableChannel(CONFIG_MSENSOR_AD_CHANNEL, NULL);
+    MotorUsers = 0u;
 }
 
-void motorEnable(void)
+/*
+ * Open loop drive with soft start only.
+ */
+void motorEnable(uint32_t station)
 {
-    *(CONFIG_MDRIVE_POWER_PORT)->set = (0x1u << CONFIG_MDRIVE_POWER_PIN);
-    *(CONFIG_MDRIVE_GPIO_PORT)->set  = (0x1u << CONFIG_MDRIVE_GPIO_PIN);
+    motorStart(station, 0u, 0u);
 }
 
-void motorDisable(void)
+/*
+ * Soft start followed by closed loop approach to rawTarget vacuum.
+ */
+void motorEnableControl(uint32_t station, uint32_t rawIdleVacuum, uint32_t rawTarget)
 {
+    motorStart(station, rawIdleVacuum, rawTarget);
+}
+
+/*
+ * The pump keeps running until the last station which needs it is done.
+ */
+void motorDisable(uint32_t station)
+{
+    MotorUsers &= ~(0x1u << station);
+
+    if (MotorUsers != 0u) {
+
+        return;
+    }
+    dutSetSampleHandler(MotorStation, NULL);
+    pwmStop();
+    CONFIG_MDRIVE_PWM_PPS = 0u;
     *(CONFIG_MDRIVE_POWER_PORT)->clr = (0x1u << CONFIG_MDRIVE_POWER_PIN);
     *(CONFIG_MDRIVE_GPIO_PORT)->clr  = (0x1u << CONFIG_MDRIVE_GPIO_PIN);
 }
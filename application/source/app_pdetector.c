@@ -27,44 +27,83 @@
 
 #define CONFIG_TIMEOUT_MS               50
 
+struct pdetector_pin
+{
+    const struct gpio *         port;
+    uint32_t                    pin;
+};
 
 static const ES_MODULE_INFO_CREATE("pdetector", "Porator detector", "Nenad Radulovoc");
 
-static struct change_slot * g_change_handle;
+static const struct pdetector_pin g_pin[CONFIG_NUM_OF_STATIONS] =
+{
+    {CONFIG_PDETECTOR_PORT,   CONFIG_PDETECTOR_PIN},
+#if (CONFIG_NUM_OF_STATIONS > 1)
+    {CONFIG_PDETECTOR_1_PORT, CONFIG_PDETECTOR_1_PIN},
+#endif
+};
+
+static struct change_slot * g_change_handle[CONFIG_NUM_OF_STATIONS];
+static bool g_is_pressed[CONFIG_NUM_OF_STATIONS];
 static esVTimer timeout;
 
+/*
+ * One debounce timer serves all pads. When it expires every pad is sampled
+ * and only the pads which changed state notify their station.
+ */
 static void timeout_handler(void * arg)
 {
-    esEvent *           notify;
-    esError             error;
+    uint32_t            station;
 
     (void)arg;
 
-    if (gpioRead(CONFIG_PDETECTOR_PORT) & (0x1u << CONFIG_PDETECTOR_PIN)) {
-        ES_ENSURE(error = esEventCreateI(sizeof(esEvent), EVT_PDETECT_PRESS, &notify));
-    } else {
-        ES_ENSURE(error = esEventCreateI(sizeof(esEvent), EVT_PDETECT_RELEASE, &notify));
-    }
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        esEvent *       notify;
+        esError         error;
+        bool            is_pressed;
+
+        is_pressed = (gpioRead(g_pin[station].port) & (0x1u << g_pin[station].pin)) ? true : false;
 
-    if (!error) {
-        ES_ENSURE(esEpaSendEventI(CONFIG_CONSUMER, notify));
+        if (is_pressed != g_is_pressed[station]) {
+            g_is_pressed[station] = is_pressed;
+
+            if (is_pressed) {
+                ES_ENSURE(error = esEventCreateI(sizeof(esEvent), EVT_PDETECT_PRESS, &notify));
+            } else {
+                ES_ENSURE(error = esEventCreateI(sizeof(esEvent), EVT_PDETECT_RELEASE, &notify));
+            }
+
+            if (!error) {
+                ES_ENSURE(esEpaSendEventI(CONFIG_CONSUMER[station], notify));
+            }
+        }
+        gpio_change_enable(g_change_handle[station]);
     }
-    gpio_change_enable(g_change_handle);
 }
 
 static void debounce_handler(void)
 {
-    gpio_change_disable(g_change_handle);
+    uint32_t            station;
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        gpio_change_disable(g_change_handle[station]);
+    }
     esVTimerStartI(&timeout, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TIMEOUT_MS), timeout_handler, NULL);
 }
 
 void initPdetectorModule(void)
 {
+    uint32_t            station;
+
     esVTimerInit(&timeout);
-    gpioSetAsInput(CONFIG_PDETECTOR_PORT, CONFIG_PDETECTOR_PIN);
-    gpioSetPullDown(CONFIG_PDETECTOR_PORT, CONFIG_PDETECTOR_PIN);
-    g_change_handle = gpio_request_slot(CONFIG_PDETECTOR_PORT,
-        CONFIG_PDETECTOR_PIN, debounce_handler);
-    gpio_change_enable(g_change_handle);
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        gpioSetAsInput(g_pin[station].port, g_pin[station].pin);
+        gpioSetPullDown(g_pin[station].port, g_pin[station].pin);
+        g_is_pressed[station]    = false;
+        g_change_handle[station] = gpio_request_slot(g_pin[station].port,
+            g_pin[station].pin, debounce_handler);
+        gpio_change_enable(g_change_handle[station]);
+    }
 }
 
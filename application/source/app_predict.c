@@ -0,0 +1,238 @@
+
+#include "app_predict.h"
+
+/*
+ * The pump-down curve is modelled as an exponential approach to an asymptote:
+ *
+ *     v(t) = A - (A - v0) * r^t
+ *
+ * For equally spaced samples this gives the linear recurrence
+ *
+ *     v[k+1] = r * v[k] + A * (1 - r)
+ *
+ * so r and A follow from an ordinary least squares line fit of v[k+1] against
+ * v[k]. The sums of the fit are updated once per block, which makes the cost
+ * per sample constant. Ratio is kept in Q16 format.
+ */
+
+#define RATIO_SHIFT                     16
+#define RATIO_ONE                       (0x1l << RATIO_SHIFT)
+#define RATIO_HALF                      (0x1l << (RATIO_SHIFT - 1))
+#define BLOCK_SIZE                      (0x1u << CONFIG_PREDICT_BLOCK_SHIFT)
+
+static int32_t ratioPower(int32_t ratio, uint32_t exponent);
+static int32_t valueAfter(const struct predict * predict, int32_t value, uint32_t nBlocks);
+static uint32_t blocksToCross(const struct predict * predict, int32_t value, uint32_t nBlocks);
+static bool predictFit(struct predict * predict);
+
+static int32_t ratioPower(int32_t ratio, uint32_t exponent) {
+    int64_t             result;
+    int64_t             base;
+
+    result = RATIO_ONE;
+    base   = ratio;
+
+    while (exponent != 0u) {
+
+        if ((exponent & 0x1u) != 0u) {
+            result = (result * base + RATIO_HALF) >> RATIO_SHIFT;
+        }
+        base       = (base * base + RATIO_HALF) >> RATIO_SHIFT;
+        exponent >>= 1;
+    }
+
+    return ((int32_t)result);
+}
+
+static int32_t valueAfter(const struct predict * predict, int32_t value, uint32_t nBlocks) {
+    int64_t             gap;
+
+    gap = (int64_t)predict->asymptote - value;
+
+    return (predict->asymptote - (int32_t)((gap * ratioPower(predict->ratio, nBlocks)) >> RATIO_SHIFT));
+}
+
+/*
+ * Called only once, when a pass verdict is given, so a plain walk over at most
+ * nBlocks steps is good enough here.
+ */
+static uint32_t blocksToCross(const struct predict * predict, int32_t value, uint32_t nBlocks) {
+    int64_t             gap;
+    uint32_t            cnt;
+
+    gap = (int64_t)predict->asymptote - value;
+
+    for (cnt = 1u; cnt < nBlocks; cnt++) {
+        gap = (gap * predict->ratio) >> RATIO_SHIFT;
+
+        if ((predict->asymptote - gap) >= predict->rawThBlock) {
+            break;
+        }
+    }
+
+    return (cnt);
+}
+
+/*
+ * Returns false when the curve does not bend towards an asymptote (yet), in
+ * which case nothing can be predicted.
+ */
+static bool predictFit(struct predict * predict) {
+    int64_t             num;
+    int64_t             den;
+    int64_t             intercept;
+    int32_t             asymptote;
+    int32_t             diff;
+
+    num = (int64_t)predict->nPairs * predict->sumXY - predict->sumX * predict->sumY;
+    den = (int64_t)predict->nPairs * predict->sumXX - predict->sumX * predict->sumX;
+
+    if (den <= 0) {
+        predict->ratio = 0;
+    } else {
+        predict->ratio = (int32_t)((num * RATIO_ONE) / den);
+    }
+
+    if (predict->ratio >= RATIO_ONE) {
+        predict->nStable = 0u;
+
+        return (false);
+    }
+
+    if (predict->ratio < 0) {
+        predict->ratio = 0;
+    }
+    intercept = (predict->sumY * RATIO_ONE - (int64_t)predict->ratio * predict->sumX) / predict->nPairs;
+    asymptote = (int32_t)(intercept / (RATIO_ONE - predict->ratio));
+    diff      = asymptote - predict->asymptote;
+
+    if (diff < 0) {
+        diff = -diff;
+    }
+
+    if (diff <= ((asymptote < 0 ? -asymptote : asymptote) >> CONFIG_PREDICT_STABLE_SHIFT)) {
+        predict->nStable++;
+    } else {
+        predict->nStable = 0u;
+    }
+    predict->asymptote = asymptote;
+
+    return (true);
+}
+
+void predictStart(struct predict * predict) {
+    predict->sumX             = 0;
+    predict->sumY             = 0;
+    predict->sumXX            = 0;
+    predict->sumXY            = 0;
+    predict->nPairs           = 0u;
+    predict->nBlockSamples    = 0u;
+    predict->block            = 0;
+    predict->previousBlock    = 0;
+    predict->hasPreviousBlock = false;
+    predict->ratio            = 0;
+    predict->asymptote        = 0;
+    predict->nStable          = 0u;
+    predictSetTarget(predict, 0u, 0u);
+}
+
+/*
+ * The fit is kept when the target changes, so the second threshold may get a
+ * verdict right after the first one was crossed.
+ */
+void predictSetTarget(struct predict * predict, uint32_t rawThValue, uint32_t nSamples) {
+    predict->rawThBlock = (int32_t)(rawThValue << CONFIG_PREDICT_BLOCK_SHIFT);
+    predict->nBlocks    = 0u;
+    predict->deadline   = nSamples >> CONFIG_PREDICT_BLOCK_SHIFT;
+    predict->crossing   = 0u;
+    predict->verdict    = PREDICT_UNKNOWN;
+}
+
+enum predictVerdict predictPush(struct predict * predict, uint32_t rawVacuum) {
+    int32_t             value;
+    int32_t             previous;
+    int32_t             atDeadline;
+    int32_t             margin;
+    uint32_t            remaining;
+
+    if (predict->verdict != PREDICT_UNKNOWN) {
+
+        return (predict->verdict);
+    }
+    predict->block += (int32_t)rawVacuum;
+    predict->nBlockSamples++;
+
+    if (predict->nBlockSamples < BLOCK_SIZE) {
+
+        return (PREDICT_UNKNOWN);
+    }
+    value                  = predict->block;
+    previous               = predict->previousBlock;
+    predict->block         = 0;
+    predict->nBlockSamples = 0u;
+    predict->previousBlock = value;
+    predict->nBlocks++;
+
+    if (!predict->hasPreviousBlock) {
+        predict->hasPreviousBlock = true;
+
+        return (PREDICT_UNKNOWN);
+    }
+
+    if (predict->nPairs == CONFIG_PREDICT_MAX_PAIRS) {
+        predict->sumX   >>= 1;
+        predict->sumY   >>= 1;
+        predict->sumXX  >>= 1;
+        predict->sumXY  >>= 1;
+        predict->nPairs >>= 1;
+    }
+    predict->sumX  += previous;
+    predict->sumY  += value;
+    predict->sumXX += (int64_t)previous * previous;
+    predict->sumXY += (int64_t)previous * value;
+    predict->nPairs++;
+
+    if (!predictFit(predict)) {
+
+        return (PREDICT_UNKNOWN);
+    }
+
+    if ((predict->nPairs   <  CONFIG_PREDICT_MIN_PAIRS)    ||
+        (predict->nStable  <  CONFIG_PREDICT_STABLE_COUNT) ||
+        (predict->nBlocks  <  (predict->deadline >> CONFIG_PREDICT_MIN_ELAPSED_SHIFT)) ||
+        (predict->nBlocks  >= predict->deadline)) {
+
+        return (PREDICT_UNKNOWN);
+    }
+    remaining  = predict->deadline - predict->nBlocks;
+    atDeadline = valueAfter(predict, value, remaining);
+    margin     = predict->rawThBlock >> CONFIG_PREDICT_MARGIN_SHIFT;
+
+    if ((atDeadline + margin) < predict->rawThBlock) {
+        predict->verdict = PREDICT_FAIL;
+    } else if (atDeadline > (predict->rawThBlock + margin)) {
+        predict->crossing = (predict->nBlocks + blocksToCross(predict, value, remaining)) << CONFIG_PREDICT_BLOCK_SHIFT;
+        predict->verdict  = PREDICT_PASS;
+    }
+
+    return (predict->verdict);
+}
+
+uint32_t predictGetAsymptote(const struct predict * predict) {
+
+    if (predict->asymptote < 0) {
+
+        return (0u);
+    }
+
+    return ((uint32_t)predict->asymptote >> CONFIG_PREDICT_BLOCK_SHIFT);
+}
+
+/*
+ * Returns predicted number of samples from the last target change until the
+ * threshold is crossed. Valid only after a pass verdict.
+ */
+uint32_t predictGetCrossing(const struct predict * predict) {
+
+    return (predict->crossing);
+}
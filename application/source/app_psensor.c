@@ -4,27 +4,323 @@
 #include "main.h"
 
 #include "app_psensor.h"
+#include "app_config.h"
+#include "events.h"
 #include "driver/gpio.h"
 #include "driver/adc.h"
 #include "config/pinout_config.h"
 
+/*
+ * 16 sample window keeps 2 bits above the converter resolution, so raw values
+ * are in 12-bit scale.
+ */
+#define CONFIG_PSENSOR_WINDOW_SHIFT     4
+#define CONFIG_PSENSOR_EXTRA_BITS       2
+#define CONFIG_PSENSOR_IIR_SHIFT        1
+
+/*
+ * Zero calibration looks at blocks of every 10th filtered sample. A block is
+ * stable when its variance and its mean drift from the previous block are
+ * both within the limits below (raw units, 12-bit scale). Between tests the
+ * idle level follows stable blocks which are close enough to it.
+ */
+#define CONFIG_PSENSOR_ZERO_DECIMATION  10
+#define CONFIG_PSENSOR_ZERO_BLOCK       16
+#define CONFIG_PSENSOR_ZERO_VARIANCE    4
+#define CONFIG_PSENSOR_ZERO_DRIFT       2
+#define CONFIG_PSENSOR_ZERO_TRACK_LIMIT 24
+#define CONFIG_PSENSOR_ZERO_TRACK_SHIFT 2
+
+#define CALIB_SHIFT                     16
+
+/*
+ * One calibration point with precomputed slopes towards the next point. The
+ * last point keeps the slope of the previous segment for extrapolation.
+ */
+struct calibPoint {
+    uint32_t            rawVacuum;
+    uint32_t            vacuum;
+    int32_t             slope;
+    int32_t             invSlope;
+};
+
+struct zero {
+    uint32_t            sum;
+    uint32_t            sumSquares;
+    uint32_t            nSamples;
+    uint32_t            previousMean;
+    bool                hasPreviousMean;
+    uint32_t            mean;
+    bool                isValid;
+};
+
+struct dutPins {
+    const struct gpio * port;
+    uint32_t            pin;
+    uint32_t            adcChannel;
+};
+
+struct dutStation {
+    struct adcSample    captureBuffer[CONFIG_PSENSOR_CAPTURE_SIZE];
+    struct adcCapture   capture;
+    struct zero         zero;
+    uint32_t            armSeq;                                                 /* Bumped on every arm, tags the threshold event            */
+};
+
+static const struct dutPins DutPins[CONFIG_NUM_OF_STATIONS] = {
+    {
+        CONFIG_PSENSOR_GPIO_PORT,
+        CONFIG_PSENSOR_GPIO_PIN,
+        CONFIG_PSENSOR_ADC_CHANNEL
+    },
+#if (CONFIG_NUM_OF_STATIONS > 1)
+    {
+        CONFIG_PSENSOR_1_GPIO_PORT,
+        CONFIG_PSENSOR_1_GPIO_PIN,
+        CONFIG_PSENSOR_1_ADC_CHANNEL
+    },
+#endif
+};
 
 static uint32_t FirstTreshold;
 static uint32_t SecondTreshold;
 static uint32_t IdleVacuum;
 static uint32_t MaxFirstVacuum;
 static uint32_t MaxSecondVacuum;
+static struct dutStation Station[CONFIG_NUM_OF_STATIONS];
+static struct calibPoint Calib[CONFIG_PSENSOR_CALIB_POINTS];
+static uint32_t NumOfCalibPoints;
 
 void initPSensorModule(void) {
-    *(CONFIG_PSENSOR_GPIO_PORT)->tris     |= (0x1u << CONFIG_PSENSOR_GPIO_PIN);
-    *(CONFIG_PSENSOR_GPIO_PORT)->ansel    |= (0x1u << CONFIG_PSENSOR_GPIO_PIN);
+    struct adcFilter    filter;
+    uint32_t            station;
+
+    filter.windowShift     = CONFIG_PSENSOR_WINDOW_SHIFT;
+    filter.extraBits       = CONFIG_PSENSOR_EXTRA_BITS;
+    filter.iirShift        = CONFIG_PSENSOR_IIR_SHIFT;
+    filter.isMedianEnabled = true;
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        *(DutPins[station].port)->tris  |= (0x1u << DutPins[station].pin);
+        *(DutPins[station].port)->ansel |= (0x1u << DutPins[station].pin);
+        adcEnableChannel(DutPins[station].adcChannel, NULL);
+        adcSetFilter(DutPins[station].adcChannel, &filter);
+    }
+}
+
+/*
+ * All stations share this handler, the station is found by its ADC channel.
+ */
+static void thresholdHandler(uint32_t id, int32_t value, uint32_t timestamp) {
+    struct psensorEvent * notify;
+    esError             error;
+    uint32_t            station;
+
+    for (station = 0u; (station < CONFIG_NUM_OF_STATIONS) && (DutPins[station].adcChannel != id); station++);
+
+    if (station == CONFIG_NUM_OF_STATIONS) {
+
+        return;
+    }
+    ES_ENSURE(error = esEventCreateI(sizeof(struct psensorEvent), EVT_PSENSOR_THRESHOLD, (esEvent **)&notify));
+
+    if (!error) {
+        notify->rawValue  = (uint32_t)value;
+        notify->timestamp = timestamp;
+        notify->armSeq    = Station[station].armSeq;
+        ES_ENSURE(esEpaSendEventI(CONFIG_PSENSOR_CONSUMER[station], (esEvent *)notify));
+    }
+}
+
+uint32_t getDutRawValue(uint32_t station) {
+
+    return (adcReadChannel(DutPins[station].adcChannel));
+}
+
+uint32_t getDutTimestamp(void) {
+
+    return (adcGetTimestamp());
+}
+
+uint32_t dutTimestampToMs(uint32_t timestamp) {
+
+    return (adcTimestampToMs(timestamp));
+}
+
+/*
+ * Period of a capture started with the given decimation. The ADC scans all
+ * enabled channels in turn, so it depends on how many are enabled.
+ */
+uint32_t dutCapturePeriodMs(uint32_t decimation) {
 
-    adcEnableChannel(CONFIG_PSENSOR_ADC_CHANNEL, NULL);
+    return (adcSamplesToMs(decimation));
 }
 
-uint32_t getDutRawValue(void) {
+/*
+ * Post EVT_PSENSOR_THRESHOLD once the vacuum reaches rawThValue. Vacuum is
+ * measured as a drop of the raw value below the idle level.
+ *
+ * Disarming does not take back an event which is already queued, so every
+ * event carries the sequence number returned here. The consumer drops events
+ * whose number is not the one of its latest arm.
+ */
+uint32_t dutArmThreshold(uint32_t station, uint32_t rawIdleVacuum, uint32_t rawThValue) {
+    Station[station].armSeq++;
+    adcArmComparator(
+        DutPins[station].adcChannel,
+        (int32_t)rawIdleVacuum - (int32_t)rawThValue,
+        ADC_COMPARE_BELOW,
+        thresholdHandler);
 
-    return (adcReadChannel(CONFIG_PSENSOR_ADC_CHANNEL));
+    return (Station[station].armSeq);
+}
+
+void dutDisarmThreshold(uint32_t station) {
+    adcDisarmComparator(DutPins[station].adcChannel);
+}
+
+/*
+ * Handler is called from the ADC interrupt with every filtered raw sample. Use
+ * NULL to remove it.
+ */
+void dutSetSampleHandler(uint32_t station, void (* handler)(int32_t)) {
+    adcSetCallback(DutPins[station].adcChannel, handler);
+}
+
+/*
+ * Capture every decimation-th filtered sample together with its timestamp.
+ * Samples which are not drained in time are dropped.
+ */
+void dutStartCapture(uint32_t station, uint32_t decimation) {
+    adcStopCapture(DutPins[station].adcChannel);
+    adcCaptureInit(&Station[station].capture, Station[station].captureBuffer, CONFIG_PSENSOR_CAPTURE_SIZE);
+    adcCaptureSetDecimation(&Station[station].capture, decimation);
+    adcStartCapture(DutPins[station].adcChannel, &Station[station].capture);
+}
+
+void dutStopCapture(uint32_t station) {
+    adcStopCapture(DutPins[station].adcChannel);
+}
+
+uint32_t dutReadCapture(uint32_t station, struct adcSample * samples, uint32_t count) {
+
+    return (adcCaptureRead(&Station[station].capture, samples, count));
+}
+
+/*
+ * Zero calibration uses the capture, so it must not run during a test.
+ */
+void dutStartZero(uint32_t station) {
+    struct zero *       zero;
+
+    zero = &Station[station].zero;
+    zero->sum             = 0u;
+    zero->sumSquares      = 0u;
+    zero->nSamples        = 0u;
+    zero->hasPreviousMean = false;
+    zero->isValid         = false;
+    dutStartCapture(station, CONFIG_PSENSOR_ZERO_DECIMATION);
+}
+
+void dutStopZero(uint32_t station) {
+    dutStopCapture(station);
+}
+
+/*
+ * Returns true when at least one stable block was seen since the last call.
+ * The capture must be drained at least once per CONFIG_PSENSOR_CAPTURE_SIZE
+ * captured samples.
+ */
+bool dutUpdateZero(uint32_t station) {
+    struct adcSample    samples[CONFIG_PSENSOR_ZERO_BLOCK];
+    struct zero *       zero;
+    uint32_t            nSamples;
+    bool                isUpdated;
+
+    zero      = &Station[station].zero;
+    isUpdated = false;
+
+    while ((nSamples = dutReadCapture(station, samples, CONFIG_PSENSOR_ZERO_BLOCK)) != 0u) {
+        uint32_t        cnt;
+
+        for (cnt = 0u; cnt < nSamples; cnt++) {
+            uint32_t    value;
+            uint32_t    mean;
+            uint32_t    drift;
+
+            value = (uint32_t)samples[cnt].value;
+            zero->sum        += value;
+            zero->sumSquares += value * value;
+            zero->nSamples++;
+
+            if (zero->nSamples < CONFIG_PSENSOR_ZERO_BLOCK) {
+                continue;
+            }
+            mean  = (zero->sum + CONFIG_PSENSOR_ZERO_BLOCK / 2u) / CONFIG_PSENSOR_ZERO_BLOCK;
+            drift = (mean > zero->previousMean ? mean - zero->previousMean : zero->previousMean - mean);
+
+            if (zero->hasPreviousMean &&
+                (drift <= CONFIG_PSENSOR_ZERO_DRIFT) &&
+                ((CONFIG_PSENSOR_ZERO_BLOCK * zero->sumSquares - zero->sum * zero->sum) <=
+                    (CONFIG_PSENSOR_ZERO_BLOCK * CONFIG_PSENSOR_ZERO_BLOCK * CONFIG_PSENSOR_ZERO_VARIANCE))) {
+                zero->mean    = mean;
+                zero->isValid = true;
+                isUpdated    = true;
+            }
+            zero->previousMean    = mean;
+            zero->hasPreviousMean = true;
+            zero->sum             = 0u;
+            zero->sumSquares      = 0u;
+            zero->nSamples        = 0u;
+        }
+    }
+
+    return (isUpdated);
+}
+
+/*
+ * Returns the last stable idle level, or the current reading when no stable
+ * block was seen yet.
+ */
+uint32_t dutGetZero(uint32_t station) {
+
+    if (Station[station].zero.isValid) {
+
+        return (Station[station].zero.mean);
+    }
+
+    return (getDutRawValue(station));
+}
+
+/*
+ * Move the idle level a fraction of the way towards the last stable block.
+ * Blocks too far from the idle level are ignored, they are most likely left
+ * over vacuum from the previous part.
+ */
+uint32_t dutTrackZero(uint32_t station, uint32_t rawIdleVacuum) {
+    const struct zero * zero;
+    int32_t             diff;
+
+    zero = &Station[station].zero;
+
+    if (!zero->isValid) {
+
+        return (rawIdleVacuum);
+    }
+    diff = (int32_t)zero->mean - (int32_t)rawIdleVacuum;
+
+    if ((diff > CONFIG_PSENSOR_ZERO_TRACK_LIMIT) || (diff < -CONFIG_PSENSOR_ZERO_TRACK_LIMIT)) {
+
+        return (rawIdleVacuum);
+    }
+
+    if (diff > 0) {
+        diff = (diff + (0x1 << (CONFIG_PSENSOR_ZERO_TRACK_SHIFT - 1))) >> CONFIG_PSENSOR_ZERO_TRACK_SHIFT;
+    } else {
+        diff = -((-diff + (0x1 << (CONFIG_PSENSOR_ZERO_TRACK_SHIFT - 1))) >> CONFIG_PSENSOR_ZERO_TRACK_SHIFT);
+    }
+
+    return ((uint32_t)((int32_t)rawIdleVacuum + diff));
 }
 
 bool isDutFirstThresholdValid(void) {
@@ -52,7 +348,7 @@ bool isDutSecondhTresholdValid(void) {
 void newDut(uint32_t firstTreshold, uint32_t secondTreshold) {
     uint32_t            idle;
 
-    idle = getDutRawValue();
+    idle = dutGetZero(0u);
     IdleVacuum      = idle;
     MaxFirstVacuum  = 0;
     MaxSecondVacuum = 0;
@@ -63,7 +359,7 @@ void newDut(uint32_t firstTreshold, uint32_t secondTreshold) {
 void updateDutFirstTh(void) {
     uint32_t current;
 
-    current = IdleVacuum - getDutRawValue();
+    current = IdleVacuum - getDutRawValue(0u);
 
     if (MaxFirstVacuum < current ) {
         MaxFirstVacuum = current;
@@ -73,20 +369,143 @@ void updateDutFirstTh(void) {
 void updateDutSecondTh(void) {
     uint32_t current;
 
-    current = IdleVacuum - getDutRawValue();
+    current = IdleVacuum - getDutRawValue(0u);
 
     if (MaxSecondVacuum < current ) {
         MaxSecondVacuum = current;
     }
 }
 
+/*
+ * Both raw vacuum and vacuum must be strictly increasing. Slopes are computed
+ * here so the conversions need only a multiply and a shift.
+ */
+bool dutSetCalibration(const uint32_t * rawVacuum, const uint32_t * vacuum, uint32_t nPoints) {
+    uint32_t            cnt;
+
+    if ((nPoints < 2u) || (nPoints > CONFIG_PSENSOR_CALIB_POINTS)) {
+
+        return (false);
+    }
+
+    for (cnt = 1u; cnt < nPoints; cnt++) {
+
+        if ((rawVacuum[cnt] <= rawVacuum[cnt - 1u]) || (vacuum[cnt] <= vacuum[cnt - 1u])) {
+
+            return (false);
+        }
+    }
+
+    for (cnt = 0u; cnt < nPoints; cnt++) {
+        Calib[cnt].rawVacuum = rawVacuum[cnt];
+        Calib[cnt].vacuum    = vacuum[cnt];
+
+        if (cnt < (nPoints - 1u)) {
+            Calib[cnt].slope    = (int32_t)(((vacuum[cnt + 1u] - vacuum[cnt]) << CALIB_SHIFT) /
+                (rawVacuum[cnt + 1u] - rawVacuum[cnt]));
+            Calib[cnt].invSlope = (int32_t)(((rawVacuum[cnt + 1u] - rawVacuum[cnt]) << CALIB_SHIFT) /
+                (vacuum[cnt + 1u] - vacuum[cnt]));
+        } else {
+            Calib[cnt].slope    = Calib[cnt - 1u].slope;
+            Calib[cnt].invSlope = Calib[cnt - 1u].invSlope;
+        }
+    }
+    NumOfCalibPoints = nPoints;
+
+    return (true);
+}
+
+/*
+ * Calibration points are zero vacuum at idle level and the two threshold
+ * points captured in sensor calibration settings.
+ */
+void dutLoadCalibration(void) {
+    uint32_t            rawVacuum[CONFIG_PSENSOR_CALIB_POINTS];
+    uint32_t            vacuum[CONFIG_PSENSOR_CALIB_POINTS];
+
+    rawVacuum[0] = 0u;
+    vacuum[0]    = 0u;
+    rawVacuum[1] = configGetTh0RawVacuum();
+    vacuum[1]    = configGetTh0Vacuum();
+    rawVacuum[2] = configGetTh1RawVacuum();
+    vacuum[2]    = configGetTh1Vacuum();
+
+    if (!dutSetCalibration(rawVacuum, vacuum, CONFIG_PSENSOR_CALIB_POINTS)) {
+        rawVacuum[1] = configGetTh0DefaultRawVacuum();
+        vacuum[1]    = configGetTh0DefaultVacuum();
+        rawVacuum[2] = configGetTh1DefaultRawVacuum();
+        vacuum[2]    = configGetTh1DefaultVacuum();
+        dutSetCalibration(rawVacuum, vacuum, CONFIG_PSENSOR_CALIB_POINTS);
+    }
+}
+
+/*
+ * Copies the points in use, the arrays must hold CONFIG_PSENSOR_CALIB_POINTS
+ * entries. Returns the number of points, zero when raw values are not
+ * converted.
+ */
+uint32_t dutGetCalibration(uint32_t * rawVacuum, uint32_t * vacuum) {
+    uint32_t            cnt;
+
+    for (cnt = 0u; cnt < NumOfCalibPoints; cnt++) {
+        rawVacuum[cnt] = Calib[cnt].rawVacuum;
+        vacuum[cnt]    = Calib[cnt].vacuum;
+    }
+
+    return (NumOfCalibPoints);
+}
+
 uint32_t dutRawToMm(uint32_t rawValue) {
+    const struct calibPoint * point;
+    int32_t             vacuum;
+    uint32_t            cnt;
+
+    if (NumOfCalibPoints == 0u) {
 
-    return (rawValue);
+        return (rawValue);
+    }
+
+    for (cnt = NumOfCalibPoints - 1u; (cnt != 0u) && (rawValue < Calib[cnt].rawVacuum); cnt--);
+    point  = &Calib[cnt];
+    vacuum = (int32_t)point->vacuum +
+        (int32_t)((((int64_t)rawValue - point->rawVacuum) * point->slope + (0x1 << (CALIB_SHIFT - 1))) >> CALIB_SHIFT);
+
+    return (vacuum > 0 ? (uint32_t)vacuum : 0u);
+}
+
+/*
+ * Converts a rate of change of the raw value, such as a leak rate, using the
+ * slope of the calibration segment which holds rawValue. The rate itself is
+ * not a point on the curve, so it is not offset like dutRawToMm() values.
+ */
+uint32_t dutRawRateToMm(uint32_t rawRate, uint32_t rawValue) {
+    uint32_t            cnt;
+
+    if (NumOfCalibPoints == 0u) {
+
+        return (rawRate);
+    }
+
+    for (cnt = NumOfCalibPoints - 1u; (cnt != 0u) && (rawValue < Calib[cnt].rawVacuum); cnt--);
+
+    return ((uint32_t)(((int64_t)rawRate * Calib[cnt].slope + (0x1 << (CALIB_SHIFT - 1))) >> CALIB_SHIFT));
 }
 
 uint32_t dutMmToRaw(uint32_t mmValue) {
+    const struct calibPoint * point;
+    int32_t             rawVacuum;
+    uint32_t            cnt;
+
+    if (NumOfCalibPoints == 0u) {
+
+        return (mmValue);
+    }
+
+    for (cnt = NumOfCalibPoints - 1u; (cnt != 0u) && (mmValue < Calib[cnt].vacuum); cnt--);
+    point     = &Calib[cnt];
+    rawVacuum = (int32_t)point->rawVacuum +
+        (int32_t)((((int64_t)mmValue - point->vacuum) * point->invSlope + (0x1 << (CALIB_SHIFT - 1))) >> CALIB_SHIFT);
 
-    return (mmValue);
+    return (rawVacuum > 0 ? (uint32_t)rawVacuum : 0u);
 }
 
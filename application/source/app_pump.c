@@ -0,0 +1,83 @@
+
+#include "app_pump.h"
+
+/*
+ * Pump controller in fixed point. The inner loop is a PI controller on the
+ * vacuum slope measured over one controller period. The slope set point comes
+ * from the remaining distance to target, so the pump runs at full duty far from
+ * the target and backs off while approaching it. Output is always limited by
+ * the soft start ceiling.
+ */
+
+#define RAMP_STEP                       ((PUMP_DUTY_ONE - CONFIG_PUMP_START_DUTY) / CONFIG_PUMP_RAMP_PERIODS)
+
+static int32_t clamp(int32_t value, int32_t min, int32_t max) {
+
+    if (value < min) {
+
+        return (min);
+    }
+
+    if (value > max) {
+
+        return (max);
+    }
+
+    return (value);
+}
+
+/*
+ * Target of zero or less disables the PI loop and leaves only the soft start.
+ */
+void pumpStart(struct pump * pump, int32_t rawTarget) {
+    pump->rawTarget    = rawTarget;
+    pump->isControlled = (rawTarget > 0);
+    pump->count        = 0u;
+    pump->previous     = 0;
+    pump->hasPrevious  = false;
+    pump->ceiling      = CONFIG_PUMP_START_DUTY;
+    pump->integral     = CONFIG_PUMP_START_DUTY;
+    pump->duty         = CONFIG_PUMP_START_DUTY;
+}
+
+/*
+ * Called for every sensor sample, returns the duty cycle to apply.
+ */
+int32_t pumpUpdate(struct pump * pump, int32_t rawVacuum) {
+    int32_t             slope;
+    int32_t             setPoint;
+    int32_t             error;
+
+    if (++pump->count < CONFIG_PUMP_PERIOD) {
+
+        return (pump->duty);
+    }
+    pump->count   = 0u;
+    pump->ceiling = clamp(pump->ceiling + RAMP_STEP, 0, PUMP_DUTY_ONE);
+
+    if (!pump->isControlled) {
+        pump->duty = pump->ceiling;
+
+        return (pump->duty);
+    }
+
+    if (!pump->hasPrevious) {
+        pump->previous    = rawVacuum;
+        pump->hasPrevious = true;
+        pump->duty        = pump->ceiling;
+
+        return (pump->duty);
+    }
+    slope          = rawVacuum - pump->previous;
+    pump->previous = rawVacuum;
+    setPoint       = (pump->rawTarget - rawVacuum) >> CONFIG_PUMP_APPROACH_SHIFT;
+
+    if (setPoint < 0) {
+        setPoint = 0;
+    }
+    error          = setPoint - slope;
+    pump->integral = clamp(pump->integral + error * (CONFIG_PUMP_KI), 0, pump->ceiling);
+    pump->duty     = clamp(pump->integral + error * (CONFIG_PUMP_KP), 0, pump->ceiling);
+
+    return (pump->duty);
+}
@@ -212,8 +212,10 @@ esError storageClearSpace(struct storageSpace * space) {
     return (ES_ERROR_NONE);
 }
 
-esError storageRead(
-    struct storageSpace * space,
+static esError readSpace(
+    const struct storageSpace * space,
+    uint32_t            signature,
+    size_t              size,
     void *              buffer) {
     esError             error;
     struct storageSpace nvmSpace;
@@ -228,8 +230,8 @@ esError storageRead(
         return (ES_ERROR_OBJECT_INVALID);
     }
 
-    if ((nvmSpace.signature != space->signature) ||
-        (nvmSpace.data.size != space->data.size)) {
+    if ((nvmSpace.signature != signature) ||
+        (nvmSpace.data.size != size)) {
 
         return (ES_ERROR_OBJECT_INVALID);
     }
@@ -247,6 +249,27 @@ esError storageRead(
     return (ES_ERROR_NONE);
 }
 
+esError storageRead(
+    struct storageSpace * space,
+    void *              buffer) {
+
+    return (readSpace(space, space->signature, space->data.size, buffer));
+}
+
+/*
+ * Reads a record written by an older firmware with a different signature and
+ * size into the same space. The caller converts it and writes it back with
+ * storageWrite(), which stores the current signature.
+ */
+esError storageReadLegacy(
+    struct storageSpace * space,
+    uint32_t            signature,
+    size_t              size,
+    void *              buffer) {
+
+    return (readSpace(space, signature, size, buffer));
+}
+
 esError storageWrite(
     struct storageSpace * space,
     const void *        buffer) {
@@ -1,5 +1,7 @@
 
 #include <stdbool.h>
+#include <string.h>
+#include <xc.h>
 
 #include "GenericTypeDefs.h"
 #include "HardwareProfile.h"
@@ -7,16 +9,25 @@
 #include "USB/usb_host_msd.h"
 #include "USB/usb_host_msd_scsi.h"
 #include "MDD File System/FSIO.h"
+#include "eds/epa.h"
 
+#include "events.h"
 #include "app_usb.h"
 
+#define CONFIG_CORE_TICKS_PER_MS        (GetSystemClock() / 2000ul)
+
 enum appUsbState {
-    APP_USB_INIT,
-    APP_USB_IDLE,
-    APP_USB_WAIT
+    APP_USB_DETACHED,
+    APP_USB_ATTACHED,                                                           /* Enumerated, waiting for the media to mount               */
+    APP_USB_MOUNTED,
+    APP_USB_FAILED                                                              /* Media did not mount, waiting for the device to go away   */
 };
 
-static volatile bool    IsUsbDeviceAttached;
+static const ES_MODULE_INFO_CREATE("USB", "USB drive attach", "Nenad Radulovic");
+
+static enum appUsbState State;
+static uint32_t         AttachTicks;
+static struct usbTiming Timing;
 
 CLIENT_DRIVER_TABLE usbMediaInterfaceTable =
 {
@@ -49,7 +60,50 @@ USB_TPL usbTPL[] =
     { INIT_CL_SC_P( 8ul, 5ul, 0x50ul ), 0, 0, {TPL_CLASS_DRV} } // Some MSD flash drives use this instead
 };
 
+static uint32_t attachTime(void) {
+
+    return ((_CP0_GET_COUNT() - AttachTicks) / CONFIG_CORE_TICKS_PER_MS);
+}
+
+static void notifyConsumer(uint16_t id) {
+    esEvent *           notify;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(esEvent), id, &notify));
+
+    if (error == ES_ERROR_NONE) {
+        ES_ENSURE(esEpaSendEvent(CONFIG_USB_CONSUMER, notify));
+    }
+}
+
+static void notifyReady(bool isMounted) {
+    struct usbReadyEvent * notify;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(struct usbReadyEvent), EVT_USB_READY, (esEvent **)&notify));
+
+    if (error == ES_ERROR_NONE) {
+        notify->isMounted = isMounted;
+        notify->timing    = Timing;
+        ES_ENSURE(esEpaSendEvent(CONFIG_USB_CONSUMER, (esEvent *)notify));
+    }
+}
+
+/*
+ * A device that is not usable ends the attach, the consumer is told the drive
+ * will not mount.
+ */
+static void attachFailed(void) {
+
+    if (State == APP_USB_ATTACHED) {
+        State = APP_USB_FAILED;
+        notifyReady(false);
+    }
+}
+
 void initUsbModule(void) {
+    State       = APP_USB_DETACHED;
+    AttachTicks = _CP0_GET_COUNT();
     USBInitialize(0);
 }
 
@@ -95,6 +149,14 @@ BOOL appUsbEventHandler(BYTE address, USB_EVENT event, void *data, DWORD size)
             // The data pointer points to a byte that represents the amount of power
             // requested in mA, divided by two.  If the device wants too much power,
             // we reject it.
+
+            // The request made while the device enumerates means it is attached,
+            // the one made when the host starts comes with no device.
+            if ((State == APP_USB_DETACHED) && (USBHostDeviceStatus(address) != USB_DEVICE_DETACHED)) {
+                State             = APP_USB_ATTACHED;
+                Timing.enumerated = attachTime();
+                notifyConsumer(EVT_USB_ATTACH);
+            }
             return (true);
 
         case EVENT_VBUS_RELEASE_POWER:
@@ -102,25 +164,32 @@ BOOL appUsbEventHandler(BYTE address, USB_EVENT event, void *data, DWORD size)
             // The PIC24F with the Explorer 16 cannot turn off Vbus through software.
 
             //This means that the device was removed
-            IsUsbDeviceAttached = false;
+            if (State != APP_USB_DETACHED) {
+                State = APP_USB_DETACHED;
+                notifyConsumer(EVT_USB_DETACH);
+            }
             return (true);
             break;
 
         case EVENT_HUB_ATTACH:
+            attachFailed();
             return (true);
             break;
 
         case EVENT_UNSUPPORTED_DEVICE:
+            attachFailed();
             return (true);
             break;
 
         case EVENT_CANNOT_ENUMERATE:
             //UART2PrintString( "\r\n***** USB Error - cannot enumerate device *****\r\n" );
+            attachFailed();
             return (true);
             break;
 
         case EVENT_CLIENT_INIT_ERROR:
             //UART2PrintString( "\r\n***** USB Error - client driver initialization error *****\r\n" );
+            attachFailed();
             return (true);
             break;
 
@@ -141,57 +210,45 @@ BOOL appUsbEventHandler(BYTE address, USB_EVENT event, void *data, DWORD size)
     return false;
 }
 
+/*
+ * Runs from the idle routine. Until a device shows up the attach time keeps
+ * moving, so it ends up at the last pass before the host saw the device. The
+ * drive is mounted here once, exports only check that it is mounted.
+ */
 void appUsb(void) {
 
     USBTasks();
-#if 0
-    switch (state) {
-        case APP_USB_INIT: {
-            IsUsbDeviceAttached = false;
-            state = APP_USB_IDLE;
-
-            break;
-        }
-        case APP_USB_IDLE: {
-            //if thumbdrive is plugged in
-            if (USBHostMSDSCSIMediaDetect()) {
-                IsUsbDeviceAttached = true;
-
-                //now a device is attached
-                //See if the device is attached and in the right format
-                if (FSInit()) {
-                    FSFILE * myFile;
-                    //Opening a file in mode "w" will create the file if it doesn't
-                    //  exist.  If the file does exist it will delete the old file
-                    //  and create a new one that is blank.
-                    myFile = FSfopen("test.txt","w");
 
-                    //Write some data to the new file.
-                    FSfwrite("This is a test.",1,15,myFile);
+    switch (State) {
+        case APP_USB_DETACHED: {
 
-                    //Always make sure to close the file so that the data gets
-                    //  written to the drive.
-                    FSfclose(myFile);
-
-                    state = APP_USB_WAIT;
-                }
+            if (USBHostDeviceStatus(USB_ROOT_HUB) == USB_DEVICE_DETACHED) {
+                AttachTicks = _CP0_GET_COUNT();
             }
 
             break;
         }
-        case APP_USB_WAIT: {
+        case APP_USB_ATTACHED: {
+
+            if (USBHostMSDSCSIMediaDetect()) {
+                Timing.mediaReady = attachTime();
 
-            if (USBHostMSDSCSIMediaDetect() == false) {
-                state = APP_USB_INIT;
+                if (FSInit()) {
+                    State = APP_USB_MOUNTED;
+                } else {
+                    State = APP_USB_FAILED;
+                }
+                Timing.mounted = attachTime();
+                notifyReady(State == APP_USB_MOUNTED);
             }
 
             break;
         }
         default : {
 
+            break;
         }
     }
-#endif
 }
 
 bool isUsbDetected(void) {
@@ -205,6 +262,47 @@ bool isUsbDetected(void) {
     }
 }
 
+bool isUsbAttached(void) {
+
+    if (State == APP_USB_ATTACHED) {
+
+        return (true);
+    } else {
+
+        return (false);
+    }
+}
+
+/*
+ * The device enumerated but its media did not mount, it stays failed until it
+ * is detached.
+ */
+bool isUsbFailed(void) {
+
+    if (State == APP_USB_FAILED) {
+
+        return (true);
+    } else {
+
+        return (false);
+    }
+}
+
+bool isUsbMounted(void) {
+
+    if (State == APP_USB_MOUNTED) {
+
+        return (true);
+    } else {
+
+        return (false);
+    }
+}
+
+void appUsbGetTiming(struct usbTiming * timing) {
+    *timing = Timing;
+}
+
 uint32_t snprintUsbStatus(char * buffer) {
 
     if (isUsbDetected()) {
@@ -0,0 +1,207 @@
+/*=========================================================  INCLUDE FILES  ==*/
+
+#include "epa_export.h"
+#include "eds/epa.h"
+#include "vtimer/vtimer.h"
+
+#include "app_timer.h"
+#include "app_data_log.h"
+
+/*=========================================================  LOCAL MACRO's  ==*/
+
+#define EXPORT_TABLE(entry)                                                     \
+    entry(stateInit,                TOP)                                        \
+    entry(stateIdle,                TOP)                                        \
+    entry(stateExport,              TOP)
+
+/*======================================================  LOCAL DATA TYPES  ==*/
+
+enum exportStateId {
+    ES_STATE_ID_INIT(EXPORT_TABLE)
+};
+
+enum exportLocalEventId {
+    CHUNK_ = ES_EVENT_LOCAL_ID
+};
+
+struct wspace {
+    struct appTimer     chunk;
+    esEpa *             client;
+    uint32_t            firstNo;
+    uint32_t            currentNo;
+    uint32_t            endNo;
+    bool                isNewOnly;
+};
+
+/*=============================================  LOCAL FUNCTION PROTOTYPES  ==*/
+
+static esAction stateInit               (void *, const esEvent *);
+static esAction stateIdle               (void *, const esEvent *);
+static esAction stateExport             (void *, const esEvent *);
+
+/*=======================================================  LOCAL VARIABLES  ==*/
+
+static const ES_MODULE_INFO_CREATE("Export", CONFIG_EPA_EXPORT_NAME, "Nenad Radulovic");
+
+static const esSmTable  ExportTable[] = ES_STATE_TABLE_INIT(EXPORT_TABLE);
+
+/*======================================================  GLOBAL VARIABLES  ==*/
+
+const struct esEpaDefine ExportEpa = ES_EPA_DEFINE(
+    CONFIG_EPA_EXPORT_NAME,
+    CONFIG_EPA_EXPORT_PRIORITY,
+    CONFIG_EPA_EXPORT_QUEUE_SIZE);
+const struct esSmDefine  ExportSm = ES_SM_DEFINE(
+    ExportTable,
+    sizeof(struct wspace),
+    stateInit);
+struct esEpa *           Export;
+
+/*============================================  LOCAL FUNCTION DEFINITIONS  ==*/
+
+/*--  SUPPORT  ---------------------------------------------------------------*/
+
+static void notifyProgress(const struct wspace * wspace) {
+    struct exportProgressEvent * notify;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(struct exportProgressEvent), EVT_EXPORT_PROGRESS, (esEvent **)&notify));
+
+    if (error == ES_ERROR_NONE) {
+        notify->nDone    = wspace->currentNo - wspace->firstNo;
+        notify->nEntries = wspace->endNo     - wspace->firstNo;
+        ES_ENSURE(esEpaSendEvent(wspace->client, (esEvent *)notify));
+    }
+}
+
+static void notifyDone(const struct wspace * wspace, enum exportResult result) {
+    struct exportDoneEvent * notify;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(struct exportDoneEvent), EVT_EXPORT_DONE, (esEvent **)&notify));
+
+    if (error == ES_ERROR_NONE) {
+        notify->result = result;
+        ES_ENSURE(esEpaSendEvent(wspace->client, (esEvent *)notify));
+    }
+}
+
+/*
+ * Closes the file and reports the result. The cursor of the incremental export
+ * moves only when the whole range made it to the drive.
+ */
+static void exportFinish(const struct wspace * wspace, enum exportResult result) {
+
+    if ((appDataLogExportEnd() != ES_ERROR_NONE) && (result == EXPORT_SUCCESS)) {
+        result = EXPORT_FAILED;
+    }
+
+    if ((result == EXPORT_SUCCESS) && wspace->isNewOnly) {
+        appDataLogExportSetCursor(wspace->endNo);
+    }
+    appDataLogExportTerm();
+    notifyDone(wspace, result);
+}
+
+/*--  End of SUPPORT  --------------------------------------------------------*/
+
+static esAction stateInit(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_INIT: {
+            appTimerInit(&wspace->chunk);
+
+            return (ES_STATE_TRANSITION(stateIdle));
+        }
+        default: {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateIdle(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case EVT_EXPORT_START: {
+            const struct exportStartEvent * request = (const struct exportStartEvent *)event;
+
+            wspace->client    = event->producer;
+            wspace->firstNo   = request->firstNo;
+            wspace->currentNo = request->firstNo;
+            wspace->endNo     = request->endNo;
+            wspace->isNewOnly = request->isNewOnly;
+
+            if ((appDataLogExportInit() != ES_ERROR_NONE) || (appDataLogExportBegin(request->format) != ES_ERROR_NONE)) {
+                notifyDone(wspace, EXPORT_FAILED);
+
+                return (ES_STATE_HANDLED());
+            }
+
+            return (ES_STATE_TRANSITION(stateExport));
+        }
+        default: {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateExport(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            notifyProgress(wspace);
+            appTimerStart(&wspace->chunk, ES_VTMR_TIME_TO_TICK_MS(CONFIG_EPA_EXPORT_CHUNK_PERIOD_MS), CHUNK_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_EXIT: {
+            appTimerCancel(&wspace->chunk);
+
+            return (ES_STATE_HANDLED());
+        }
+        case CHUNK_: {
+            uint32_t    cnt;
+
+            for (cnt = 0u; (cnt < CONFIG_EPA_EXPORT_CHUNK) && (wspace->currentNo < wspace->endNo); cnt++) {
+
+                if (appDataLogExportEntry(wspace->currentNo) != ES_ERROR_NONE) {
+                    exportFinish(wspace, EXPORT_FAILED);
+
+                    return (ES_STATE_TRANSITION(stateIdle));
+                }
+                wspace->currentNo++;
+            }
+            notifyProgress(wspace);
+
+            if (wspace->currentNo == wspace->endNo) {
+                exportFinish(wspace, EXPORT_SUCCESS);
+
+                return (ES_STATE_TRANSITION(stateIdle));
+            }
+            appTimerStart(&wspace->chunk, ES_VTMR_TIME_TO_TICK_MS(CONFIG_EPA_EXPORT_CHUNK_PERIOD_MS), CHUNK_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_EXPORT_CANCEL: {                                               /* Keep what was written, the cursor stays where it was     */
+            exportFinish(wspace, EXPORT_CANCELED);
+
+            return (ES_STATE_TRANSITION(stateIdle));
+        }
+        default: {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*===================================  GLOBAL PRIVATE FUNCTION DEFINITIONS  ==*/
+/*====================================  GLOBAL PUBLIC FUNCTION DEFINITIONS  ==*/
+/*================================*//** @cond *//*==  CONFIGURATION ERRORS  ==*/
+/** @endcond *//***************************************************************
+ * END of epa_export.c
+ ******************************************************************************/
@@ -11,7 +11,6 @@
 #include "software_profile.h"
 
 #include "app_config.h"
-#include "app_motor.h"
 #include "app_psensor.h"
 #include "app_battery.h"
 #include "app_usb.h"
@@ -25,20 +24,24 @@
 #include "app_storage.h"
 #include "app_user.h"
 #include "app_data_log.h"
-#include "app_pdetector.h"
+#include "app_curve.h"
+#include "app_predict.h"
+#include "epa_test.h"
 
 /*=========================================================  LOCAL MACRO's  ==*/
 
-#define CONFIG_ZERO_CALIB_MS            2000
+#define CONFIG_ZERO_CALIB_REFRESH_MS    100
 #define CONFIG_TEST_CANCEL_MS           5000
 #define CONFIG_TEST_FAIL_MS             5000
 #define CONFIG_TEST_OVERVIEW_MS         5000
-#define CONFIG_TEST_REFRESH_MS          10
 #define CONFIG_TOUCH_REFRESH_MS         20
 #define CONFIG_MAIN_REFRESH_MS          1000
 
 #define DEF_VACUUM_UNIT                 "\"Hg"
 
+/*--  Small fonts  -----------------------------------------------------------*/
+#define DEF_S1_FONT_SIZE                26
+
 /*--  Normal fonts  ----------------------------------------------------------*/
 #define DEF_N1_FONT_SIZE                27
 #define DEF_N2_FONT_SIZE                29
@@ -101,8 +104,6 @@
     entry(stateProgress,            TOP)                                        \
     entry(stateTest,                TOP)                                        \
     entry(stateTestInProgress,      stateTest)                                  \
-    entry(stateTestFirstTh,         stateTestInProgress)                        \
-    entry(stateTestSecondTh,        stateTestInProgress)                        \
     entry(stateTestResultStatic,    stateTest)                                  \
     entry(stateTestResultReleased,  stateTest)                                  \
     entry(stateTestResultReady,     stateTest)                                  \
@@ -113,6 +114,7 @@
     entry(stateSettingsClock,       TOP)                                        \
     entry(stateSettingsParameter,   TOP)                                        \
     entry(stateSettingsPassword,    TOP)                                        \
+    entry(stateSettingsLogRestart,  TOP)                                        \
     entry(stateSettingsCalibLcd,    TOP)                                        \
     entry(stateSettingsCalibSens,   TOP)                                        \
     entry(stateSettingsCalibSensL,  TOP)                                        \
@@ -121,6 +123,7 @@
     entry(stateExportNoData,        TOP)                                        \
     entry(stateExportInsert,        TOP)                                        \
     entry(stateExportMount,         TOP)                                        \
+    entry(stateExportMountFail,     TOP)                                        \
     entry(stateExportChoose,        TOP)                                        \
     entry(stateExportSaving,        TOP)                                        
     
@@ -135,25 +138,11 @@ enum localEvents {
     WAKEUP_TIMEOUT_ = ES_EVENT_LOCAL_ID,
     WELCOME_WAIT_,
     MAIN_REFRESH_,
-    ZERO_CALIB_WAIT_,
-    FIRST_TH_TIMEOUT_,
-    FIRST_TH_REFRESH_,
-    SECOND_TH_TIMEOUT_,
-    SECOND_TH_REFRESH_,
+    ZERO_CALIB_REFRESH_,
     SETTINGS_SENSZLH_REFRESH_,
-    EXPORT_INSERT_REFRESH_,
-    EXPORT_CHOOSE_REFRESH_,
     PROGRESS_TIMEOUT_
 };
 
-enum testState {
-    TEST_NOT_EXECUTED,
-    TEST_STARTED,
-    TEST_FAILED,
-    TEST_CANCELED,
-    TEST_VALID
-};
-
 enum buttonBackPos {
     DOWN_LEFT,
     DOWN_MIDDLE,
@@ -174,27 +163,19 @@ enum inputBoxConfirmType {
 struct wspace {
     struct appTimer     timeout;
     struct appTimer     refresh;
-    uint32_t            rawIdleVacuum;
+    uint32_t            station;
+    enum testStage      stage[CONFIG_NUM_OF_STATIONS];
     union state {
         struct wakeUpLcd {
             uint32_t            retry;
         }                   wakeUpLcd;
         struct main {
-            bool                isDutInPlace;
             char                battery[20];
             char                time[20];
             char                date[20];
         }                   main;
         struct test {
-            struct testStatus {
-                enum testState      state;
-                uint32_t            rawMaxValue;
-                uint32_t            rawThValue;
-                uint32_t            time;
-            }                   th[2];
             const uint8_t *     notification;
-            uint32_t            rawIdleVacuum;
-            uint32_t            count;
             struct testResults {
                 const char *        title;
                 const char *        button;
@@ -207,9 +188,6 @@ struct wspace {
                 uint32_t            background;
             }                   testResults;
         }                   test;
-        struct testReport {
-            uint32_t                nEntries;
-        }                   testReport;
         struct settingsAuthorize {
             uint32_t            counter;
             uint32_t            numOfCharactes;
@@ -218,8 +196,20 @@ struct wspace {
             uint32_t            begin[3];
             uint32_t            end[3];
             uint32_t            focus;
+            uint32_t            nNewLogs;
+            uint32_t            mountMs;                                        /* From attach until the drive was mounted                  */
             bool                isExportEnabled;
+            bool                isNewOnly;
+            enum dataLogFormat  format;
         }                   exportChoose;
+        struct settingsParameter {
+            uint32_t            predictMode;
+            uint32_t            decayNo;
+        }                   settingsParameter;
+        struct settingsLogRestart {
+            uint32_t            nEntries;
+            uint32_t            nNewLogs;
+        }                   settingsLogRestart;
         struct settingsClock {
             uint32_t            focus;
             struct appTime      time;
@@ -237,8 +227,9 @@ struct wspace {
             uint32_t            timeout;
         }                   progress;
         struct export {
-            uint32_t            numOfLogs;
-            uint32_t            currentNo;
+            uint32_t            nDone;
+            uint32_t            nEntries;
+            bool                isCanceled;
         }                   export;
         struct inputBox {
             const char *        title;
@@ -266,8 +257,6 @@ static esAction stateMain               (void *, const esEvent *);
 static esAction stateProgress           (void *, const esEvent *);
 static esAction stateTest               (void *, const esEvent *);
 static esAction stateTestInProgress     (void *, const esEvent *);
-static esAction stateTestFirstTh        (void *, const esEvent *);
-static esAction stateTestSecondTh       (void *, const esEvent *);
 static esAction stateTestResultStatic   (void *, const esEvent *);
 static esAction stateTestResultReleased (void *, const esEvent *);
 static esAction stateTestResultReady    (void *, const esEvent *);
@@ -278,6 +267,7 @@ static esAction stateSettingsAdmin      (void *, const esEvent *);
 static esAction stateSettingsClock      (void *, const esEvent *);
 static esAction stateSettingsParameter  (void *, const esEvent *);
 static esAction stateSettingsPassword   (void *, const esEvent *);
+static esAction stateSettingsLogRestart (void *, const esEvent *);
 static esAction stateSettingsCalibLcd   (void *, const esEvent *);
 static esAction stateSettingsCalibSens  (void *, const esEvent *);
 static esAction stateSettingsCalibSensL (void *, const esEvent *);
@@ -286,6 +276,7 @@ static esAction stateExport             (void *, const esEvent *);
 static esAction stateExportNoData       (void *, const esEvent *);
 static esAction stateExportInsert       (void *, const esEvent *);
 static esAction stateExportMount        (void *, const esEvent *);
+static esAction stateExportMountFail    (void *, const esEvent *);
 static esAction stateExportChoose       (void *, const esEvent *);
 static esAction stateExportSaving       (void *, const esEvent *);
 
@@ -300,6 +291,37 @@ static const uint8_t FailNotification[] = {150, 150, 175, 175, 200, 0};
 static const uint8_t ConfusedNotification[] = {20, 100, 20, 100, 40, 100, 40, 100, 60, 0};
 static const uint8_t SuccessNotification[] = {40, 100, 40, 100, 40, 0};
 
+static const char * const PredictModeName[] = {
+    "Predict: off",
+    "Predict: fail",
+    "Predict: all"
+};
+
+/*
+ * Leak-rate decay phase lengths offered on the Parameters screen, the first one
+ * turns the phase off.
+ */
+static const uint32_t DecayTimeout[] = {
+    0u,
+    2000u,
+    5000u,
+    10000u
+};
+
+static const char * const DecayTimeoutName[] = {
+    "Decay: off",
+    "Decay: 2 s",
+    "Decay: 5 s",
+    "Decay: 10 s"
+};
+
+#define NUM_OF_DECAY_TIMEOUTS           (sizeof(DecayTimeout) / sizeof(DecayTimeout[0]))
+
+static const char * const ExportFormatName[] = {
+    "CSV",
+    "BIN"
+};
+
 /*======================================================  GLOBAL VARIABLES  ==*/
 
 const struct esEpaDefine GuiEpa = ES_EPA_DEFINE(
@@ -356,7 +378,84 @@ static void constructButtonBack(enum buttonBackPos position, bool active) {
     Ft_Gpu_CoCmd_ColdStart(&Gpu);
 }
 
+static const char * stageName(const struct testStatus * status) {
+
+    switch (status->stage) {
+        case TEST_STAGE_ZERO : {
+
+            return ("Calibrating");
+        }
+        case TEST_STAGE_IDLE : {
+
+            return (status->isDutInPlace ? "Ready" : "Empty");
+        }
+        case TEST_STAGE_FIRST_TH : {
+
+            return ("1st threshold");
+        }
+        case TEST_STAGE_SECOND_TH : {
+
+            return ("2nd threshold");
+        }
+        case TEST_STAGE_DECAY : {
+
+            return ("Leak test");
+        }
+        case TEST_STAGE_DONE : {
+
+            return (isTestPassed(status) ? "PASSED" : "FAILED");
+        }
+        default : {
+
+            return ("Saving...");
+        }
+    }
+}
+
+#if (CONFIG_NUM_OF_STATIONS > 1)
+static void constructStations(void) {
+    static const char * const StationName[] = {
+        "Pad 1",
+        "Pad 2"
+    };
+    uint32_t            station;
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        const struct testStatus * status;
+        int16_t         row;
+
+        status = testGetStatus(station);
+        row    = (int16_t)(75 + station * 65);
+
+        if ((status->stage == TEST_STAGE_IDLE) && !status->isDutInPlace) {
+            Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(92, 92, 92));
+            Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(112, 112, 112));
+            Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('p'));
+            Ft_Gpu_CoCmd_Button(&Gpu, 20, row, 130, 50, DEF_N1_FONT_SIZE, 0, StationName[station]);
+            Ft_Gpu_CoCmd_ColdStart(&Gpu);
+        } else {
+            Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+            Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('0' + station));
+            Ft_Gpu_CoCmd_Button(&Gpu, 20, row, 130, 50, DEF_N1_FONT_SIZE, 0, StationName[station]);
+        }
+
+        if (status->stage == TEST_STAGE_DONE) {
+
+            if (isTestPassed(status)) {
+                Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(0, 128, 0));
+            } else {
+                Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 0, 0));
+            }
+        } else {
+            Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(0, 0, 0));
+        }
+        Ft_Gpu_CoCmd_Text(&Gpu, 170, row + 25, DEF_N1_FONT_SIZE, OPT_CENTERY, stageName(status));
+    }
+}
+#endif
+
 static void screenWelcome(void) {
+    gpuSync();
     /* copy data continuously into RAM_G memory */
     Ft_Gpu_Hal_WrMem(&Gpu, RAM_G + 131072L, (const uint8_t *)ManufacturerLogo, ManufacturerLogoInfo.size);              
     gpuBegin();
@@ -379,9 +478,7 @@ static void screenWelcome(void) {
     Ft_Gpu_CoCmd_Text(&Gpu, DISP_WIDTH / 2, 160, DEF_N1_FONT_SIZE, OPT_CENTER, BUILD_DATE);
     Ft_Gpu_CoCmd_Text(&Gpu, DISP_WIDTH / 2, 180, DEF_N1_FONT_SIZE, OPT_CENTER, BUILD_TIME);
     Ft_Gpu_CoCmd_Text(&Gpu, DISP_WIDTH / 2, 220, DEF_N1_FONT_SIZE, OPT_CENTER, DEF_WEBSITE);
-    Ft_Gpu_Hal_WrCmd32(&Gpu, DISPLAY());
-    Ft_Gpu_CoCmd_Swap(&Gpu);
-    Ft_Gpu_Hal_WaitCmdfifo_empty(&Gpu);
+    gpuEnd();
 }
 
 static void screenProgress(const union state * state) {
@@ -404,7 +501,8 @@ static void screenMain(const union state * state) {
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('E'));
     Ft_Gpu_CoCmd_Button(&Gpu, 170, 20, 130,  40, DEF_N1_FONT_SIZE, 0, "Export");
 
-    if (state->main.isDutInPlace) {
+#if (CONFIG_NUM_OF_STATIONS == 1)
+    if (testGetStatus(0u)->isDutInPlace) {
         Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
         Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('T'));
         Ft_Gpu_CoCmd_Button(&Gpu, 80,  80, 160, 80, DEF_B1_FONT_SIZE, 0, "TEST");
@@ -420,6 +518,10 @@ static void screenMain(const union state * state) {
         text = "Put the porator on the test pad.";
     }
     Ft_Gpu_CoCmd_Text(&Gpu, 160, 185, DEF_N1_FONT_SIZE, OPT_CENTER, text);
+#else
+    (void)text;
+    constructStations();
+#endif
     Ft_Gpu_Hal_WrCmd32(&Gpu,          COLOR_RGB(0, 0, 0));
     Ft_Gpu_CoCmd_Text(&Gpu, 140, 225, DEF_N1_FONT_SIZE, OPT_CENTERY, state->main.date);
     Ft_Gpu_CoCmd_Text(&Gpu, 240, 225, DEF_N1_FONT_SIZE, OPT_CENTERY, state->main.time);
@@ -432,40 +534,47 @@ static void screenMain(const union state * state) {
     gpuEnd();
 }
 
-
-static void screenTestTh0(const union state * state) {
-    gpuBegin();
-    constructBackground(0);
-    constructTitle("Test in progress");
-    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_1, DEF_N1_FONT_SIZE, OPT_CENTERY, "1st threshold");
-    Ft_Gpu_CoCmd_Spinner(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2, 0, 0);
-    gpuEnd();
-}
-
-static void screenTestTh1(const union state * state) {
+static void screenTestProgress(const struct testStatus * status) {
     gpuBegin();
     constructBackground(0);
     constructTitle("Test in progress");
-    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_1, DEF_N1_FONT_SIZE, OPT_CENTERY, "2nd threshold");
-    Ft_Gpu_CoCmd_Spinner(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2, 0, 0);
+    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_1, DEF_N1_FONT_SIZE, OPT_CENTERY, stageName(status));
+#if (CONFIG_NUM_OF_STATIONS > 1)
+    Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+    Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('B'));
+    Ft_Gpu_CoCmd_Button(&Gpu, 230, 55, 80, 30, DEF_N1_FONT_SIZE, 0, "Back");
+#endif
+    constructCurve(&status->curve);
     gpuEnd();
 }
 
-static void screenTestResults(const union state * state) {
+static void screenTestResults(const union state * state, const struct testStatus * status) {
     gpuBegin();
     constructBackground(state->test.testResults.background);
     constructTitle(state->test.testResults.title);
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTERY, "1st threshold");
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_13,  POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTERY, "[" DEF_VACUUM_UNIT "]:");
     Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_18,  POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTERY,
-        state->test.testResults.rawMax0Value);
+        dutRawToMm(state->test.testResults.rawMax0Value));
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_26,  POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTER, state->test.testResults.state0);
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTERY, "2nd threshold");
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_13,  POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTERY, "[" DEF_VACUUM_UNIT "]:");
     Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_18,  POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTERY,
-        state->test.testResults.rawMax1Value);
+        dutRawToMm(state->test.testResults.rawMax1Value));
     Ft_Gpu_CoCmd_Text(&Gpu,  POS_COLUMN_26,  POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTER, state->test.testResults.state1);
 
+    if (status->decay.state != TEST_NOT_EXECUTED) {
+        Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,   POS_ROW_2, DEF_N1_FONT_SIZE, OPT_CENTERY, "Leak rate");
+        Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_13,  POS_ROW_2, DEF_N1_FONT_SIZE, OPT_CENTERY, "[" DEF_VACUUM_UNIT "/min]:");
+        Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_25,  POS_ROW_2, DEF_N1_FONT_SIZE, OPT_CENTERY,
+            dutRawRateToMm(status->decay.rawRate > 0 ? (uint32_t)status->decay.rawRate * 60u : 0u,
+                status->th[1].rawMaxValue));
+    }
+
+    if (status->isPredicted) {                                                  /* Not measured to the end, see the predictor mode          */
+        Ft_Gpu_CoCmd_Text(&Gpu, POS_COLUMN_2, POS_ROW_2_5, DEF_S1_FONT_SIZE, OPT_CENTERY, "Result predicted");
+    }
+
     if (state->test.testResults.is_rbutton_active) {
         Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
         Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('R'));
@@ -480,12 +589,12 @@ static void screenTestResults(const union state * state) {
     gpuEnd();
 }
 
-static void screenTestSaving(const union state * state) {
+static void screenTestSaving(const struct testStatus * status) {
     gpuBegin();
     constructBackground(0);
     constructTitle("Saving...");
     Ft_Gpu_CoCmd_Text(&Gpu, 160,  200, DEF_N1_FONT_SIZE, OPT_CENTER, "Saving record number:");
-    Ft_Gpu_CoCmd_Number(&Gpu, 240,  200, DEF_N1_FONT_SIZE, OPT_CENTERY, state->testReport.nEntries);
+    Ft_Gpu_CoCmd_Number(&Gpu, 240,  200, DEF_N1_FONT_SIZE, OPT_CENTERY, status->nEntries);
     Ft_Gpu_CoCmd_Spinner(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2, 0, 0);
     gpuEnd();
 }
@@ -518,11 +627,42 @@ static void screenExportMount(void) {
     gpuEnd();
 }
 
+static void screenExportMountFail(void) {
+    gpuBegin();
+    constructBackground(0);
+    constructTitle("Export");
+    Ft_Gpu_CoCmd_Text(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2 - 15, DEF_N1_FONT_SIZE, OPT_CENTER,
+        "USB flash drive can not be read");
+    Ft_Gpu_CoCmd_Text(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2 + 15, DEF_N1_FONT_SIZE, OPT_CENTER,
+        "Please use a FAT formatted drive");
+    constructButtonBack(DOWN_MIDDLE, B_IS_ACTIVE);
+    gpuEnd();
+}
+
 static void screenExportSaving(const union state * state) {
     gpuBegin();
     constructBackground(0);
     constructTitle("Saving data...");
-    Ft_Gpu_CoCmd_Spinner(&Gpu, DISP_WIDTH / 2, DISP_HEIGHT / 2, 0, 0);
+    Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(0, 0, 0));
+    Ft_Gpu_CoCmd_Number(&Gpu, 110, 80, DEF_N1_FONT_SIZE, OPT_CENTER, state->export.nDone);
+    Ft_Gpu_CoCmd_Text(&Gpu, 160, 80, DEF_N1_FONT_SIZE, OPT_CENTER, "of");
+    Ft_Gpu_CoCmd_Number(&Gpu, 210, 80, DEF_N1_FONT_SIZE, OPT_CENTER, state->export.nEntries);
+    Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+    Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(8, 120, 40));
+    Ft_Gpu_CoCmd_Progress(&Gpu, 40, 120, 240, 20, 0, (uint16_t)state->export.nDone,
+        state->export.nEntries != 0u ? (uint16_t)state->export.nEntries : 1u);
+
+    if (state->export.isCanceled) {
+        Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('c'));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(92, 92, 92));
+        Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(112, 112, 112));
+    } else {
+        Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('C'));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+        Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(8, 120, 40));
+    }
+    Ft_Gpu_CoCmd_Button(&Gpu, 98, 180, 130, 40, DEF_N1_FONT_SIZE, 0, "Cancel");
+    Ft_Gpu_CoCmd_ColdStart(&Gpu);
     gpuEnd();
 }
 
@@ -571,6 +711,8 @@ static void screenExportChoose(const union state * state) {
     }
     Ft_Gpu_CoCmd_Text(&Gpu, 125,  140,  DEF_N1_FONT_SIZE, OPT_CENTER, "-");
     Ft_Gpu_CoCmd_Text(&Gpu, 175,  140,  DEF_N1_FONT_SIZE, OPT_CENTER, "-");
+    Ft_Gpu_CoCmd_Text(&Gpu, 190,  166,  DEF_S1_FONT_SIZE, OPT_CENTERY | OPT_RIGHTX, "Drive ready [ms]:");
+    Ft_Gpu_CoCmd_Number(&Gpu, 196, 166, DEF_S1_FONT_SIZE, OPT_CENTERY, state->exportChoose.mountMs);
     Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('>'));
     Ft_Gpu_CoCmd_Button(&Gpu,  20, 60, 40, 40, DEF_B1_FONT_SIZE, 0, ">");
@@ -592,6 +734,22 @@ static void screenExportChoose(const union state * state) {
         Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(112, 112, 112));
     }
     Ft_Gpu_CoCmd_Button(&Gpu, 170, 180, 130, 40, DEF_N1_FONT_SIZE, 0, "Export");
+
+    if (state->exportChoose.nNewLogs != 0u) {
+        Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('N'));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+        Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(8, 120, 40));
+    } else {
+        Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('n'));
+        Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(92, 92, 92));
+        Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(112, 112, 112));
+    }
+    Ft_Gpu_CoCmd_Button(&Gpu, 240, 10, 60, 30, DEF_N1_FONT_SIZE, 0, "New");
+    Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('F'));
+    Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+    Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(8, 120, 40));
+    Ft_Gpu_CoCmd_Button(&Gpu, 20, 10, 60, 30, DEF_N1_FONT_SIZE, 0,
+        ExportFormatName[state->exportChoose.format]);
     Ft_Gpu_CoCmd_ColdStart(&Gpu);
     gpuEnd();
 }
@@ -625,15 +783,40 @@ static void screenSettingsAdmin(void) {
     constructTitle("Administration");
     Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('S'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 20,  60, 130, 40, DEF_N1_FONT_SIZE, 0, "Sensor Calib.");
+    Ft_Gpu_CoCmd_Button(&Gpu, 20,  50, 130, 36, DEF_N1_FONT_SIZE, 0, "Sensor Calib.");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('L'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 170, 60, 130, 40, DEF_N1_FONT_SIZE, 0, "LCD Calib.");
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 50, 130, 36, DEF_N1_FONT_SIZE, 0, "LCD Calib.");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('P'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 20,  120, 130, 40, DEF_N1_FONT_SIZE, 0, "Password");
+    Ft_Gpu_CoCmd_Button(&Gpu, 20,  94, 130, 36, DEF_N1_FONT_SIZE, 0, "Password");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('G'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 170, 120, 130, 40, DEF_N1_FONT_SIZE, 0, "Parameters");
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 94, 130, 36, DEF_N1_FONT_SIZE, 0, "Parameters");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('R'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 170, 180, 130, 40, DEF_N1_FONT_SIZE, 0, "Clock");
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 138, 130, 36, DEF_N1_FONT_SIZE, 0, "Clock");
+
+    if (appDataLogIsLegacy()) {                                                 /* Old log without curves is restarted only from here       */
+        Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('C'));
+        Ft_Gpu_CoCmd_Button(&Gpu, 20, 138, 130, 36, DEF_N1_FONT_SIZE, 0, "Restart Log");
+    }
+    constructButtonBack(DOWN_LEFT, B_IS_ACTIVE);
+    gpuEnd();
+}
+
+static void screenSettingsLogRestart(const union state * state) {
+    gpuBegin();
+    constructBackground(0);
+    constructTitle("Restart Log");
+    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,  POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTERY, "Log entries:");
+    Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_25, POS_ROW_1,   DEF_N1_FONT_SIZE, OPT_CENTERY,
+        state->settingsLogRestart.nEntries);
+    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,  POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTERY, "Not exported:");
+    Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_25, POS_ROW_1_5, DEF_N1_FONT_SIZE, OPT_CENTERY,
+        state->settingsLogRestart.nNewLogs);
+    Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_2,  POS_ROW_2,   DEF_S1_FONT_SIZE, OPT_CENTERY,
+        "All entries are erased, the new log stores curves");
+    Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
+    Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('S'));
+    Ft_Gpu_CoCmd_FgColor(&Gpu, COLOR_RGB(128, 48, 12));
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 180, 130, 40, DEF_N1_FONT_SIZE, 0, "Erase");
     constructButtonBack(DOWN_LEFT, B_IS_ACTIVE);
     gpuEnd();
 }
@@ -709,6 +892,7 @@ static void screenSettingsCalibLcd(void) {
     Ft_Gpu_CoCmd_Text(&Gpu,DISP_WIDTH / 2 ,DISP_HEIGHT/2,26,OPT_CENTERX|OPT_CENTERY, "Please tap on the dot");
     Ft_Gpu_CoCmd_Calibrate(&Gpu, 0);
     gpuEnd();
+    gpuSync();                                                                  /* Calibration results are valid only when fifo is drained  */
 }
 
 static void screenSettingsCalibSensor(void) {
@@ -734,7 +918,8 @@ static void screenSettingsCalibSensorZLH(const union state * state) {
     Ft_Gpu_CoCmd_Text(&Gpu,   POS_COLUMN_18,  POS_ROW_1, DEF_N1_FONT_SIZE, OPT_CENTERY, "[" DEF_VACUUM_UNIT "]:");
     Ft_Gpu_CoCmd_Number(&Gpu, POS_COLUMN_25,  POS_ROW_1, DEF_N1_FONT_SIZE, OPT_CENTERY,
         state->calibSensZHL.vacuumTarget);
-    Ft_Gpu_CoCmd_Number(&Gpu, DISP_WIDTH / 2,  POS_ROW_2, DEF_N2_FONT_SIZE, OPT_CENTER, dutRawToMm(state->calibSensZHL.rawVacuum));
+    Ft_Gpu_CoCmd_Number(&Gpu, DISP_WIDTH / 2,  POS_ROW_2, DEF_N2_FONT_SIZE, OPT_CENTER,
+        dutRawToMm(state->calibSensZHL.rawFullScale - state->calibSensZHL.rawVacuum));
     Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
     Ft_Gpu_CoCmd_Progress(&Gpu, POS_COLUMN_4, POS_ROW_1_5 - 5, DISP_WIDTH - (POS_COLUMN_4 * 2), 10, 0,
         state->calibSensZHL.rawVacuum,
@@ -751,13 +936,19 @@ static void screenSettingsParameter(const union state * state) {
     constructTitle("Parameters");
     Ft_Gpu_Hal_WrCmd32(&Gpu, COLOR_RGB(255, 255, 255));
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('Q'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 20,  60, 130, 40, DEF_N1_FONT_SIZE, 0, "1st Threshold");
+    Ft_Gpu_CoCmd_Button(&Gpu, 20,  50, 130, 36, DEF_N1_FONT_SIZE, 0, "1st Threshold");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('W'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 170, 60, 130, 40, DEF_N1_FONT_SIZE, 0, "2nd Threshold");
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 50, 130, 36, DEF_N1_FONT_SIZE, 0, "2nd Threshold");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('E'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 20,  120, 130, 40, DEF_N1_FONT_SIZE, 0, "1st Timeout");
+    Ft_Gpu_CoCmd_Button(&Gpu, 20,  94, 130, 36, DEF_N1_FONT_SIZE, 0, "1st Timeout");
     Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('R'));
-    Ft_Gpu_CoCmd_Button(&Gpu, 170, 120, 130, 40, DEF_N1_FONT_SIZE, 0, "2nd Timeout");
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 94, 130, 36, DEF_N1_FONT_SIZE, 0, "2nd Timeout");
+    Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('D'));
+    Ft_Gpu_CoCmd_Button(&Gpu, 20,  138, 130, 36, DEF_N1_FONT_SIZE, 0,
+        DecayTimeoutName[state->settingsParameter.decayNo]);
+    Ft_Gpu_Hal_WrCmd32(&Gpu, TAG('P'));
+    Ft_Gpu_CoCmd_Button(&Gpu, 170, 138, 130, 36, DEF_N1_FONT_SIZE, 0,
+        PredictModeName[state->settingsParameter.predictMode]);
     constructButtonBack(DOWN_LEFT, B_IS_ACTIVE);
     gpuEnd();
 }
@@ -805,6 +996,74 @@ static void screenInputBox(const union state * state) {
     gpuEnd();
 }
 
+static bool isZeroCalibDone(void) {
+    uint32_t            station;
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+
+        if (testGetStatus(station)->stage == TEST_STAGE_ZERO) {
+
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+static void sendTestRequest(uint32_t station, uint16_t id) {
+    esEvent *           request;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(*request), id, &request));
+
+    if (error == ES_ERROR_NONE) {
+        ES_ENSURE(esEpaSendEvent(Test[station], request));
+    }
+}
+
+static bool isStationInFocus(const struct wspace * wspace, const esEvent * event) {
+
+    return (((const struct testStatusEvent *)event)->station == wspace->station);
+}
+
+/*
+ * Returns true when the status event is a pad change on the finished station
+ * in focus.
+ */
+static bool isResultUpdate(const struct wspace * wspace, const esEvent * event) {
+
+    return (isStationInFocus(wspace, event) && (testGetStatus(wspace->station)->stage == TEST_STAGE_DONE));
+}
+
+static esAction testResultState(const struct testStatus * status) {
+
+    if (!status->isDutInPlace) {
+
+        return (ES_STATE_TRANSITION(stateTestResultReleased));
+    } else if (status->isNewDut) {
+
+        return (ES_STATE_TRANSITION(stateTestResultReady));
+    } else {
+
+        return (ES_STATE_TRANSITION(stateTestResultStatic));
+    }
+}
+
+static void cancelExport(union state * state) {
+    esEvent *           request;
+    esError             error;
+
+    if (!state->export.isCanceled) {
+        state->export.isCanceled = true;
+        ES_ENSURE(error = esEventCreate(sizeof(*request), EVT_EXPORT_CANCEL, &request));
+
+        if (error == ES_ERROR_NONE) {
+            ES_ENSURE(esEpaSendEvent(Export, request));
+        }
+        screenExportSaving(state);
+    }
+}
+
 /*--  End of SUPPORT  --------------------------------------------------------*/
 
 static esAction stateInit(void * space, const esEvent * event) {
@@ -944,7 +1203,7 @@ static esAction stateZeroCalib(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY: {
-            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_MS), ZERO_CALIB_WAIT_);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_REFRESH_MS), ZERO_CALIB_REFRESH_);
             wspace->state.progress.background  = 0;
             wspace->state.progress.title       = "Zero calibration";
             wspace->state.progress.description = "Please wait...";
@@ -953,10 +1212,29 @@ static esAction stateZeroCalib(void * space, const esEvent * event) {
 
             return (ES_STATE_HANDLED());
         }
-        case ZERO_CALIB_WAIT_: {
-            wspace->rawIdleVacuum = getDutRawValue();
+        case ZERO_CALIB_REFRESH_: {                                             /* Stations may finish before this screen is shown          */
 
-            return (ES_STATE_TRANSITION(stateMain));
+            if (isZeroCalibDone()) {
+
+                return (ES_STATE_TRANSITION(stateMain));
+            }
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_REFRESH_MS), ZERO_CALIB_REFRESH_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TEST_STATUS: {
+
+            if (isZeroCalibDone()) {
+
+                return (ES_STATE_TRANSITION(stateMain));
+            }
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_EXIT: {
+            appTimerCancel(&wspace->refresh);
+
+            return (ES_STATE_HANDLED());
         }
         default : {
 
@@ -971,12 +1249,16 @@ static esAction stateMain(void * space, const esEvent * event) {
     switch (event->id) {
         case ES_ENTRY: {
             struct appTime time;
+            uint32_t       station;
 
             appTimeGet(&time);
             snprintRtcTime(&time, wspace->state.main.time);
             snprintRtcDate(&time, wspace->state.main.date);
             snprintBatteryStatus(wspace->state.main.battery);
-            wspace->state.main.isDutInPlace = false;
+
+            for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+                wspace->stage[station] = testGetStatus(station)->stage;
+            }
             screenMain(&wspace->state);
             appTimerStart(
                 &wspace->refresh,
@@ -995,7 +1277,7 @@ static esAction stateMain(void * space, const esEvent * event) {
 
             switch (touchEvent->tag) {
                 case 'T' : {
-                    wspace->state.test.count = 0u;
+                    wspace->station = 0u;
 
                     return (ES_STATE_TRANSITION(stateTest));
                 }
@@ -1009,18 +1291,35 @@ static esAction stateMain(void * space, const esEvent * event) {
                 }
                 default : {
 
+                    if ((touchEvent->tag >= '0') && (touchEvent->tag < ('0' + CONFIG_NUM_OF_STATIONS))) {
+                        wspace->station = touchEvent->tag - '0';
+
+                        return (ES_STATE_TRANSITION(stateTest));
+                    }
+
                     return (ES_STATE_HANDLED());
                 }
             }
         }
-        case EVT_PDETECT_PRESS  : {
-            wspace->state.main.isDutInPlace = true;
-            screenMain(&wspace->state);
+        case EVT_TEST_STATUS : {
+            const struct testStatusEvent * statusEvent = (const struct testStatusEvent *)event;
+            const struct testStatus *      status;
 
-            return (ES_STATE_HANDLED());
-        }
-        case EVT_PDETECT_RELEASE: {
-            wspace->state.main.isDutInPlace = false;
+            if (statusEvent->isCurveUpdated) {
+
+                return (ES_STATE_HANDLED());
+            }
+            status = testGetStatus(statusEvent->station);
+
+            if ((status->stage == TEST_STAGE_DONE) && (wspace->stage[statusEvent->station] != TEST_STAGE_DONE)) {
+
+                if (isTestPassed(status)) {                                     /* Station finished while nobody was watching it            */
+                    buzzerMelody(SuccessNotification);
+                } else {
+                    buzzerMelody(FailNotification);
+                }
+            }
+            wspace->stage[statusEvent->station] = status->stage;
             screenMain(&wspace->state);
 
             return (ES_STATE_HANDLED());
@@ -1044,44 +1343,20 @@ static esAction stateMain(void * space, const esEvent * event) {
     }
 }
 
+/*
+ * The test itself runs in the station EPA, these states only follow the status
+ * of the station in focus and forward the operator requests to it.
+ */
 static esAction stateTest(void * space, const esEvent * event)
 {
     struct wspace *             wspace = space;
     
     switch (event->id) {
         case ES_ENTRY : {
-            wspace->state.test.count             = 0u;
-            wspace->state.test.th[0].state       = TEST_NOT_EXECUTED;
-            wspace->state.test.th[0].rawMaxValue = 0u;
-            wspace->state.test.th[0].rawThValue  = configGetTh0RawVacuum();
-            wspace->state.test.th[0].time        = configGetTh0Timeout();
-            wspace->state.test.th[1].state       = TEST_NOT_EXECUTED;
-            wspace->state.test.th[1].rawMaxValue = 0u;
-            wspace->state.test.th[1].rawThValue  = configGetTh1RawVacuum();
-            wspace->state.test.th[1].time        = configGetTh1Timeout();
-            wspace->state.test.rawIdleVacuum     = wspace->rawIdleVacuum;
-
-            return (ES_STATE_HANDLED());
-        }
-        case ES_EXIT : {
-            struct appDataLog entry;
 
-            if ((wspace->state.test.th[0].state == TEST_VALID) &&
-                (wspace->state.test.th[1].state == TEST_VALID)) {
-                entry.hasPassed = true;
-            } else {
-                entry.hasPassed = false;
-            }
-            entry.th[0].time        = wspace->state.test.th[0].time;
-            entry.th[0].rawMaxValue = wspace->state.test.th[0].rawMaxValue;
-            entry.th[1].time        = wspace->state.test.th[1].time;
-            entry.th[1].rawMaxValue = wspace->state.test.th[1].rawMaxValue;
-            entry.numOfTests        = wspace->state.test.count;
-            appTimeGet(&entry.timestamp);
-            appUserGetCurrent(&entry.user);
-            appDataLogNumberOfEntries(&wspace->state.testReport.nEntries);
-            screenTestSaving(&wspace->state);
-            appDataLogSave(&entry);
+            if (testGetStatus(wspace->station)->stage == TEST_STAGE_IDLE) {
+                sendTestRequest(wspace->station, EVT_TEST_START);
+            }
 
             return (ES_STATE_HANDLED());
         }
@@ -1091,12 +1366,19 @@ static esAction stateTest(void * space, const esEvent * event)
 
             switch (touchEvent->tag) {
                 case 'B' : {
+
+                    if (testGetStatus(wspace->station)->stage == TEST_STAGE_DONE) {
+                        sendTestRequest(wspace->station, EVT_TEST_FINISH);
+
+                        return (ES_STATE_HANDLED());
+                    }
                     
                     return (ES_STATE_TRANSITION(stateMain));
                 }
                 case 'R' : {
+                    sendTestRequest(wspace->station, EVT_TEST_START);
 
-                    return (ES_STATE_TRANSITION(stateTest));
+                    return (ES_STATE_HANDLED());
                 }
                 default: {
 
@@ -1104,61 +1386,45 @@ static esAction stateTest(void * space, const esEvent * event)
                 }
             }
         }
-        case ES_INIT : {
+        case EVT_TEST_STATUS : {
+            const struct testStatus * status;
 
-            return (ES_STATE_TRANSITION(stateTestInProgress));
-        }
-        default : {
+            if (!isStationInFocus(wspace, event)) {
 
-            return (ES_STATE_IGNORED());
-        }
-    }
-}
-
-static esAction stateTestInProgress(void * space, const esEvent * event)
-{
-    struct wspace *             wspace = space;
+                return (ES_STATE_HANDLED());
+            }
+            status = testGetStatus(wspace->station);
 
-    switch (event->id) {
-        case ES_ENTRY : {
-            wspace->state.test.count++;
-            motorEnable();
+            switch (status->stage) {
+                case TEST_STAGE_ZERO :
+                case TEST_STAGE_IDLE : {
 
-            return (ES_STATE_HANDLED());
-        }
-        case ES_EXIT : {
-            motorDisable();
-            
-            return (ES_STATE_HANDLED());
-        }
-        case ES_INIT : {
+                    return (ES_STATE_TRANSITION(stateMain));
+                }
+                case TEST_STAGE_SAVING : {
+                    screenTestSaving(status);
 
-            return (ES_STATE_TRANSITION(stateTestFirstTh));
-        }
-        case EVT_PDETECT_RELEASE : {
+                    return (ES_STATE_HANDLED());
+                }
+                case TEST_STAGE_DONE : {
 
-            return (ES_STATE_TRANSITION(stateTestResultReleased));
-        }
-        default : {
+                    return (testResultState(status));
+                }
+                default : {
 
-            return (ES_STATE_IGNORED());
+                    return (ES_STATE_TRANSITION(stateTestInProgress));
+                }
+            }
         }
-    }
-}
-
-static esAction stateProgress(void * space, const esEvent * event) {
-    struct wspace * wspace = space;
+        case ES_INIT : {
+            const struct testStatus * status = testGetStatus(wspace->station);
 
-    switch (event->id) {
-        case ES_ENTRY: {
-            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->state.progress.timeout), PROGRESS_TIMEOUT_);
-            screenProgress(&wspace->state);
+            if (status->stage == TEST_STAGE_DONE) {
 
-            return (ES_STATE_HANDLED());
-        }
-        case PROGRESS_TIMEOUT_: {
+                return (testResultState(status));
+            }
 
-            return (wspace->state.progress.nextState);
+            return (ES_STATE_TRANSITION(stateTestInProgress));
         }
         default : {
 
@@ -1167,52 +1433,34 @@ static esAction stateProgress(void * space, const esEvent * event) {
     }
 }
 
-static esAction stateTestFirstTh(void * space, const esEvent * event) {
-    struct wspace * wspace = space;
+static esAction stateTestInProgress(void * space, const esEvent * event)
+{
+    struct wspace *             wspace = space;
 
     switch (event->id) {
-        case ES_ENTRY: {
-            wspace->state.test.th[0].state = TEST_STARTED;
-            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->state.test.th[0].time), FIRST_TH_TIMEOUT_);
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), FIRST_TH_REFRESH_);
-            screenTestTh0(&wspace->state);
+        case ES_ENTRY : {
+            screenTestProgress(testGetStatus(wspace->station));
 
             return (ES_STATE_HANDLED());
         }
-        case FIRST_TH_REFRESH_: {
-            uint32_t rawValue;
+        case EVT_TEST_STATUS : {
+            const struct testStatusEvent * statusEvent = (const struct testStatusEvent *)event;
+            const struct testStatus *      status;
 
-            rawValue = getDutRawValue();
+            if (!isStationInFocus(wspace, event)) {
 
-            if (wspace->rawIdleVacuum > rawValue) {
-                uint32_t rawVacuum;
-
-                rawVacuum = wspace->rawIdleVacuum - rawValue;
-
-                if (wspace->state.test.th[0].rawMaxValue < rawVacuum) {
-                    wspace->state.test.th[0].rawMaxValue = rawVacuum;
-                }
+                return (ES_STATE_IGNORED());
+            }
+            status = testGetStatus(wspace->station);
 
-                if (rawVacuum >= wspace->state.test.th[0].rawThValue) {
-                    wspace->state.test.th[0].state = TEST_VALID;
-                    wspace->state.test.th[0].time -= appTimerGetRemaining(&wspace->timeout);
-                    /* Set the maxumum value for the second pass, too. */
-                    wspace->state.test.th[1].rawMaxValue = wspace->state.test.th[0].rawMaxValue;
+            if ((status->stage < TEST_STAGE_FIRST_TH) || (status->stage > TEST_STAGE_DECAY)) {
 
-                    return (ES_STATE_TRANSITION(stateTestSecondTh));
-                }
+                return (ES_STATE_IGNORED());
             }
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), FIRST_TH_REFRESH_);
 
-            return (ES_STATE_HANDLED());
-        }
-        case FIRST_TH_TIMEOUT_: {
-
-            return (ES_STATE_TRANSITION(stateTestResultStatic));
-        }
-        case ES_EXIT : {
-            appTimerCancel(&wspace->refresh);
-            appTimerCancel(&wspace->timeout);
+            if (!statusEvent->isCurveUpdated || !isGpuBusy()) {                 /* Skip the frame if previous one is not finished yet       */
+                screenTestProgress(status);
+            }
 
             return (ES_STATE_HANDLED());
         }
@@ -1223,52 +1471,19 @@ static esAction stateTestFirstTh(void * space, const esEvent * event) {
     }
 }
 
-static esAction stateTestSecondTh(void * space, const esEvent * event) {
+static esAction stateProgress(void * space, const esEvent * event) {
     struct wspace * wspace = space;
 
     switch (event->id) {
         case ES_ENTRY: {
-            wspace->state.test.th[1].state = TEST_STARTED;
-            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->state.test.th[1].time), SECOND_TH_TIMEOUT_);
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), SECOND_TH_REFRESH_);
-            screenTestTh1(&wspace->state);
-
-            return (ES_STATE_HANDLED());
-        }
-        case SECOND_TH_REFRESH_: {
-            uint32_t rawValue;
-
-            rawValue = getDutRawValue();
-
-            if (wspace->rawIdleVacuum > rawValue) {
-                uint32_t rawVacuum;
-
-                rawVacuum = wspace->rawIdleVacuum - rawValue;
-
-                if (wspace->state.test.th[1].rawMaxValue < rawVacuum) {
-                    wspace->state.test.th[1].rawMaxValue = rawVacuum;
-                }
-
-                if (rawVacuum >= wspace->state.test.th[1].rawThValue) {
-                    wspace->state.test.th[1].state = TEST_VALID;
-                    wspace->state.test.th[1].time -= appTimerGetRemaining(&wspace->timeout);
-
-                    return (ES_STATE_TRANSITION(stateTestResultStatic));
-                }
-            }
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), SECOND_TH_REFRESH_);
+            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->state.progress.timeout), PROGRESS_TIMEOUT_);
+            screenProgress(&wspace->state);
 
             return (ES_STATE_HANDLED());
         }
-        case SECOND_TH_TIMEOUT_: {
-
-            return (ES_STATE_TRANSITION(stateTestResultStatic));
-        }
-        case ES_EXIT: {
-            appTimerCancel(&wspace->refresh);
-            appTimerCancel(&wspace->timeout);
+        case PROGRESS_TIMEOUT_: {
 
-            return (ES_STATE_HANDLED());
+            return (wspace->state.progress.nextState);
         }
         default : {
 
@@ -1282,30 +1497,31 @@ static esAction stateTestResultStatic(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY : {
-            wspace->state.test.testResults.rawMax0Value = wspace->state.test.th[0].rawMaxValue;
-            wspace->state.test.testResults.rawMax1Value = wspace->state.test.th[1].rawMaxValue;
+            const struct testStatus * status = testGetStatus(wspace->station);
+
+            wspace->state.test.testResults.rawMax0Value = status->th[0].rawMaxValue;
+            wspace->state.test.testResults.rawMax1Value = status->th[1].rawMaxValue;
 
-            if (wspace->state.test.th[0].state == TEST_VALID) {
+            if (status->th[0].state == TEST_VALID) {
                 wspace->state.test.testResults.state0 = "PASSED";
             } else {
                 wspace->state.test.testResults.state0 = "FAILED";
             }
 
-            if (wspace->state.test.th[1].state == TEST_VALID) {
+            if (status->th[1].state == TEST_VALID) {
                 wspace->state.test.testResults.state1 = "PASSED";
             } else {
                 wspace->state.test.testResults.state1 = "FAILED";
             }
 
-            if ((wspace->state.test.th[0].state == TEST_VALID) &&
-                (wspace->state.test.th[1].state == TEST_VALID)) {
+            if (isTestPassed(status)) {
                 wspace->state.test.testResults.background = CLEAR_COLOR_RGB(16, 224, 16);
                 wspace->state.test.testResults.title      = "Porator PASSED";
                 wspace->state.test.testResults.button     = "PUT NEXT";
                 wspace->state.test.testResults.is_rbutton_active = false;
                 wspace->state.test.notification           = SuccessNotification;
             } else {
-                if (wspace->state.test.count < configGetRetryCount()) {
+                if (status->count < configGetRetryCount()) {
                     wspace->state.test.testResults.background = CLEAR_COLOR_RGB(224, 224, 16);
                     wspace->state.test.testResults.title      = "Repeat Test";
                     wspace->state.test.testResults.button     = "REPEAT";
@@ -1321,28 +1537,23 @@ static esAction stateTestResultStatic(void * space, const esEvent * event) {
             }
             wspace->state.test.testResults.is_bbutton_active = false;
             buzzerMelody(wspace->state.test.notification);
-            screenTestResults(&wspace->state);
+            screenTestResults(&wspace->state, status);
 
             return (ES_STATE_HANDLED());
         }
-        case EVT_TOUCH_TAG : {
-            const struct touchEvent * touchEvent =
-                (const struct touchEvent *)event;
+        case EVT_TEST_STATUS : {
 
-            switch (touchEvent->tag) {
-                case 'R' : {
+            if (!isResultUpdate(wspace, event)) {
 
-                    return (ES_STATE_TRANSITION(stateTestInProgress));
-                }
-                default: {
-                    
-                    return (ES_STATE_IGNORED());
-                }
+                return (ES_STATE_IGNORED());
+            }
+
+            if (!testGetStatus(wspace->station)->isDutInPlace) {
+
+                return (ES_STATE_TRANSITION(stateTestResultReleased));
             }
-        }
-        case EVT_PDETECT_RELEASE : {
 
-            return (ES_STATE_TRANSITION(stateTestResultReleased));
+            return (ES_STATE_HANDLED());
         }
         default : {
 
@@ -1356,54 +1567,50 @@ static esAction stateTestResultReleased(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY : {
-            wspace->state.test.testResults.rawMax0Value = wspace->state.test.th[0].rawMaxValue;
-            wspace->state.test.testResults.rawMax1Value = wspace->state.test.th[1].rawMaxValue;
+            const struct testStatus * status = testGetStatus(wspace->station);
+
+            wspace->state.test.testResults.rawMax0Value = status->th[0].rawMaxValue;
+            wspace->state.test.testResults.rawMax1Value = status->th[1].rawMaxValue;
             wspace->state.test.testResults.button       = "PUT NEXT";
             wspace->state.test.testResults.is_bbutton_active = true;
             wspace->state.test.testResults.is_rbutton_active = false;
 
-            if (wspace->state.test.th[0].state == TEST_VALID) {
+            if (status->th[0].state == TEST_VALID) {
                 wspace->state.test.testResults.state0 = "PASSED";
             } else {
                 wspace->state.test.testResults.state0 = "FAILED";
             }
 
-            if (wspace->state.test.th[1].state == TEST_VALID) {
+            if (status->th[1].state == TEST_VALID) {
                 wspace->state.test.testResults.state1 = "PASSED";
             } else {
                 wspace->state.test.testResults.state1 = "FAILED";
             }
 
-            if ((wspace->state.test.th[0].state == TEST_VALID) &&
-                (wspace->state.test.th[1].state == TEST_VALID)) {
+            if (isTestPassed(status)) {
                 wspace->state.test.testResults.background = CLEAR_COLOR_RGB(16, 224, 16);
                 wspace->state.test.testResults.title      = "Porator PASSED";
             } else {
                 wspace->state.test.testResults.background = CLEAR_COLOR_RGB(224, 16, 16);
                 wspace->state.test.testResults.title      = "Porator FAILED";
             }
-            screenTestResults(&wspace->state);
+            screenTestResults(&wspace->state, status);
 
             return (ES_STATE_HANDLED());
         }
-        case EVT_TOUCH_TAG : {
-            const struct touchEvent * touchEvent =
-                (const struct touchEvent *)event;
+        case EVT_TEST_STATUS : {
 
-            switch (touchEvent->tag) {
-                case 'B' : {
+            if (!isResultUpdate(wspace, event)) {
 
-                    return (ES_STATE_TRANSITION(stateMain));
-                }
-                default: {
+                return (ES_STATE_IGNORED());
+            }
 
-                    return (ES_STATE_IGNORED());
-                }
+            if (testGetStatus(wspace->station)->isDutInPlace) {
+
+                return (ES_STATE_TRANSITION(stateTestResultReady));
             }
-        }
-        case EVT_PDETECT_PRESS : {
 
-            return (ES_STATE_TRANSITION(stateTestResultReady));
+            return (ES_STATE_HANDLED());
         }
         default : {
 
@@ -1417,26 +1624,27 @@ static esAction stateTestResultReady(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY : {
-            wspace->state.test.testResults.rawMax0Value = wspace->state.test.th[0].rawMaxValue;
-            wspace->state.test.testResults.rawMax1Value = wspace->state.test.th[1].rawMaxValue;
+            const struct testStatus * status = testGetStatus(wspace->station);
+
+            wspace->state.test.testResults.rawMax0Value = status->th[0].rawMaxValue;
+            wspace->state.test.testResults.rawMax1Value = status->th[1].rawMaxValue;
             wspace->state.test.testResults.button       = "TEST NEXT";
             wspace->state.test.testResults.is_rbutton_active = true;
             wspace->state.test.testResults.is_bbutton_active = false;
 
-            if (wspace->state.test.th[0].state == TEST_VALID) {
+            if (status->th[0].state == TEST_VALID) {
                 wspace->state.test.testResults.state0 = "PASSED";
             } else {
                 wspace->state.test.testResults.state0 = "FAILED";
             }
 
-            if (wspace->state.test.th[1].state == TEST_VALID) {
+            if (status->th[1].state == TEST_VALID) {
                 wspace->state.test.testResults.state1 = "PASSED";
             } else {
                 wspace->state.test.testResults.state1 = "FAILED";
             }
 
-            if ((wspace->state.test.th[0].state == TEST_VALID) &&
-                (wspace->state.test.th[1].state == TEST_VALID)) {
+            if (isTestPassed(status)) {
                 wspace->state.test.testResults.background = CLEAR_COLOR_RGB(16, 224, 16);
                 wspace->state.test.testResults.title      = "Porator PASSED";
                 
@@ -1444,17 +1652,23 @@ static esAction stateTestResultReady(void * space, const esEvent * event) {
                 wspace->state.test.testResults.background = CLEAR_COLOR_RGB(224, 16, 16);
                 wspace->state.test.testResults.title      = "Porator FAILED";
             }
-            screenTestResults(&wspace->state);
+            screenTestResults(&wspace->state, status);
 
             return (ES_STATE_HANDLED());
         }
-        case EVT_TOUCH_TAG : {
+        case EVT_TEST_STATUS : {
 
-            return (ES_STATE_IGNORED());
-        }
-        case EVT_PDETECT_RELEASE : {
+            if (!isResultUpdate(wspace, event)) {
+
+                return (ES_STATE_IGNORED());
+            }
 
-            return (ES_STATE_TRANSITION(stateTestResultReleased));
+            if (!testGetStatus(wspace->station)->isDutInPlace) {
+
+                return (ES_STATE_TRANSITION(stateTestResultReleased));
+            }
+
+            return (ES_STATE_HANDLED());
         }
         default : {
 
@@ -1627,6 +1841,14 @@ static esAction stateSettingsAdmin(void * space, const esEvent * event) {
                     
                     return (ES_STATE_TRANSITION(stateSettingsPassword));
                 }
+                case 'C' : {
+
+                    if (appDataLogIsLegacy()) {
+
+                        return (ES_STATE_TRANSITION(stateSettingsLogRestart));
+                    }
+                    break;
+                }
                 case 'B' : {
 
                     return (ES_STATE_TRANSITION(stateSettings));
@@ -1675,6 +1897,61 @@ static esAction stateSettingsPassword(void * space, const esEvent * event) {
         }
     }
 }
+/*
+ * The operator confirms erasing the old log, the number of entries not on a
+ * drive yet is shown first.
+ */
+static esAction stateSettingsLogRestart(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY : {
+            uint32_t    nEntries;
+            uint32_t    cursorNo;
+
+            appDataLogNumberOfEntries(&nEntries);
+            appDataLogExportCursor(&cursorNo);
+            wspace->state.settingsLogRestart.nEntries = nEntries;
+            wspace->state.settingsLogRestart.nNewLogs = nEntries - cursorNo;
+            screenSettingsLogRestart(&wspace->state);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TOUCH_TAG : {
+            const struct touchEvent * touchEvent = (const struct touchEvent *)event;
+
+            switch (touchEvent->tag) {
+                case 'S' : {
+
+                    if (appDataLogRestart() != ES_ERROR_NONE) {
+
+                        return (ES_STATE_TRANSITION(stateSettingsAdmin));
+                    }
+                    wspace->state.progress.title       = "Restart Log";
+                    wspace->state.progress.description = "Saving data...";
+                    wspace->state.progress.background  = 0u;
+                    wspace->state.progress.timeout     = 1000u;
+                    wspace->state.progress.nextState   = ES_STATE_TRANSITION(stateSettingsAdmin);
+
+                    return (ES_STATE_TRANSITION(stateProgress));
+                }
+                case 'B' : {
+
+                    return (ES_STATE_TRANSITION(stateSettingsAdmin));
+                }
+                default : {
+
+                    return (ES_STATE_HANDLED());
+                }
+            }
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
 static esAction stateSettingsCalibLcd(void * space, const esEvent * event) {
     struct wspace * wspace = space;
 
@@ -1761,6 +2038,7 @@ static esAction stateSettingsCalibSens(void * space, const esEvent * event) {
 
                         return (ES_STATE_TRANSITION(stateSettingsAdmin));
                     }
+                    dutLoadCalibration();
                     wspace->state.progress.title       = "Calibrate Sensor";
                     wspace->state.progress.description = "Saving data...";
                     wspace->state.progress.background  = 0u;
@@ -1791,12 +2069,9 @@ static esAction stateSettingsCalibSensL(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY : {
-            uint32_t            rawVacuumTarget;
-
-            rawVacuumTarget = configGetTh0RawVacuum();
-            wspace->state.calibSensZHL.vacuumTarget = dutRawToMm(rawVacuumTarget);
-            wspace->state.calibSensZHL.rawFullScale = wspace->rawIdleVacuum;
-            wspace->state.calibSensZHL.rawVacuum    = min(getDutRawValue(), wspace->rawIdleVacuum);
+            wspace->state.calibSensZHL.vacuumTarget = configGetTh0Vacuum();
+            wspace->state.calibSensZHL.rawFullScale = testGetStatus(0u)->rawIdleVacuum;
+            wspace->state.calibSensZHL.rawVacuum    = min(getDutRawValue(0u), wspace->state.calibSensZHL.rawFullScale);
             screenSettingsCalibSensorZLH(&wspace->state);
             appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS),
                 SETTINGS_SENSZLH_REFRESH_);
@@ -1817,13 +2092,14 @@ static esAction stateSettingsCalibSensL(void * space, const esEvent * event) {
 
                     isSaved = false;
 
-                    if (wspace->state.calibSensZHL.rawVacuum < wspace->rawIdleVacuum) {
+                    if (wspace->state.calibSensZHL.rawVacuum < wspace->state.calibSensZHL.rawFullScale) {
                         uint32_t    rawVacuum;
                     
-                        rawVacuum = wspace->rawIdleVacuum - wspace->state.calibSensZHL.rawVacuum;
+                        rawVacuum = wspace->state.calibSensZHL.rawFullScale - wspace->state.calibSensZHL.rawVacuum;
 
                         if (configSetTh0RawVacuum(rawVacuum) == true) {
                             isSaved = true;
+                            dutLoadCalibration();
                         }
                     }
 
@@ -1851,7 +2127,7 @@ static esAction stateSettingsCalibSensL(void * space, const esEvent * event) {
             }
         }
         case SETTINGS_SENSZLH_REFRESH_ : {
-            wspace->state.calibSensZHL.rawVacuum = min(getDutRawValue(), wspace->state.calibSensZHL.rawFullScale);
+            wspace->state.calibSensZHL.rawVacuum = min(getDutRawValue(0u), wspace->state.calibSensZHL.rawFullScale);
             screenSettingsCalibSensorZLH(&wspace->state);
             appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS),
                 SETTINGS_SENSZLH_REFRESH_);
@@ -1870,9 +2146,9 @@ static esAction stateSettingsCalibSensH(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY : {
-            wspace->state.calibSensZHL.vacuumTarget = 10;
-            wspace->state.calibSensZHL.rawFullScale = wspace->rawIdleVacuum;
-            wspace->state.calibSensZHL.rawVacuum    = min(getDutRawValue(), wspace->rawIdleVacuum);
+            wspace->state.calibSensZHL.vacuumTarget = configGetTh1Vacuum();
+            wspace->state.calibSensZHL.rawFullScale = testGetStatus(0u)->rawIdleVacuum;
+            wspace->state.calibSensZHL.rawVacuum    = min(getDutRawValue(0u), wspace->state.calibSensZHL.rawFullScale);
             screenSettingsCalibSensorZLH(&wspace->state);
             appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS), SETTINGS_SENSZLH_REFRESH_);
 
@@ -1892,14 +2168,15 @@ static esAction stateSettingsCalibSensH(void * space, const esEvent * event) {
 
                     isSaved = false;
 
-                    if (wspace->state.calibSensZHL.rawVacuum < wspace->rawIdleVacuum) {
+                    if (wspace->state.calibSensZHL.rawVacuum < wspace->state.calibSensZHL.rawFullScale) {
                         uint32_t    rawVacuum;
 
-                        rawVacuum = wspace->rawIdleVacuum - wspace->state.calibSensZHL.rawVacuum;
+                        rawVacuum = wspace->state.calibSensZHL.rawFullScale - wspace->state.calibSensZHL.rawVacuum;
 
                         if (rawVacuum > configGetTh0RawVacuum()) {
                             if (configSetTh1RawVacuum(rawVacuum) == true) {
                                 isSaved = true;
+                                dutLoadCalibration();
                             }
                         }
                     }
@@ -1928,7 +2205,7 @@ static esAction stateSettingsCalibSensH(void * space, const esEvent * event) {
             }
         }
         case SETTINGS_SENSZLH_REFRESH_ : {
-            wspace->state.calibSensZHL.rawVacuum = min(getDutRawValue(), wspace->state.calibSensZHL.rawFullScale);
+            wspace->state.calibSensZHL.rawVacuum = min(getDutRawValue(0u), wspace->state.calibSensZHL.rawFullScale);
             screenSettingsCalibSensorZLH(&wspace->state);
             appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS),
                 SETTINGS_SENSZLH_REFRESH_);
@@ -2082,6 +2359,21 @@ static esAction stateSettingsParameter(void * space, const esEvent * event) {
     
     switch (event->id) {
         case ES_ENTRY : {
+            uint32_t    cnt;
+
+            wspace->state.settingsParameter.predictMode = configGetPredictMode();
+
+            if (wspace->state.settingsParameter.predictMode >= PREDICT_LAST_MODE) {
+                wspace->state.settingsParameter.predictMode = PREDICT_DISABLED;
+            }
+            wspace->state.settingsParameter.decayNo = 0u;                       /* Timeouts not in the table show as off until changed      */
+
+            for (cnt = 0u; cnt < NUM_OF_DECAY_TIMEOUTS; cnt++) {
+
+                if (DecayTimeout[cnt] == configGetDecayTimeout()) {
+                    wspace->state.settingsParameter.decayNo = cnt;
+                }
+            }
             screenSettingsParameter(&wspace->state);
             
             return (ES_STATE_HANDLED());
@@ -2108,6 +2400,38 @@ static esAction stateSettingsParameter(void * space, const esEvent * event) {
                     return (ES_STATE_TRANSITION(/*TODO*/));
                 }
 #endif
+                case 'P' : {
+                    uint32_t    predictMode;
+
+                    predictMode = wspace->state.settingsParameter.predictMode + 1u;
+
+                    if (predictMode == PREDICT_LAST_MODE) {
+                        predictMode = PREDICT_DISABLED;
+                    }
+
+                    if (configSetPredictMode(predictMode) == true) {
+                        wspace->state.settingsParameter.predictMode = predictMode;
+                    }
+                    screenSettingsParameter(&wspace->state);
+
+                    return (ES_STATE_HANDLED());
+                }
+                case 'D' : {
+                    uint32_t    decayNo;
+
+                    decayNo = wspace->state.settingsParameter.decayNo + 1u;
+
+                    if (decayNo == NUM_OF_DECAY_TIMEOUTS) {
+                        decayNo = 0u;
+                    }
+
+                    if (configSetDecayTimeout(DecayTimeout[decayNo]) == true) {
+                        wspace->state.settingsParameter.decayNo = decayNo;
+                    }
+                    screenSettingsParameter(&wspace->state);
+
+                    return (ES_STATE_HANDLED());
+                }
                 case 'B' : {
                     return (ES_STATE_TRANSITION(stateSettingsAdmin));
                 }
@@ -2131,7 +2455,13 @@ static esAction stateExport(void * space, const esEvent * event) {
             if (numOfLogs == 0) {
 
                 return (ES_STATE_TRANSITION(stateExportNoData));
-            } else if (isUsbDetected()) {
+            } else if (isUsbMounted()) {
+
+                return (ES_STATE_TRANSITION(stateExportChoose));
+            } else if (isUsbFailed()) {
+
+                return (ES_STATE_TRANSITION(stateExportMountFail));
+            } else if (isUsbAttached()) {
 
                 return (ES_STATE_TRANSITION(stateExportMount));
             } else {
@@ -2174,26 +2504,17 @@ static esAction stateExportNoData(void * space, const esEvent * event) {
 }
 
 static esAction stateExportInsert(void * space, const esEvent * event) {
-    struct wspace * wspace = space;
+    (void)space;
 
     switch (event->id) {
         case ES_ENTRY: {
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS), EXPORT_INSERT_REFRESH_);
             screenExportInsert();
 
             return (ES_STATE_HANDLED());
         }
-        case EXPORT_INSERT_REFRESH_: {
+        case EVT_USB_ATTACH: {
 
-            if (isUsbDetected()) {
-
-                return (ES_STATE_TRANSITION(stateExportMount));
-            } else {
-                appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_MAIN_REFRESH_MS),
-                    EXPORT_INSERT_REFRESH_);
-
-                return (ES_STATE_HANDLED());
-            }
+            return (ES_STATE_TRANSITION(stateExportMount));
         }
         case EVT_TOUCH_TAG : {
             const struct touchEvent * touchEvent = (const struct touchEvent *)event;
@@ -2222,13 +2543,55 @@ static esAction stateExportMount(void * space, const esEvent * event) {
 
             return (ES_STATE_HANDLED());
         }
-        case ES_INIT: {
-            if (isUsbDetected()) {
+        case EVT_USB_READY: {
+            const struct usbReadyEvent * ready = (const struct usbReadyEvent *)event;
+
+            if (ready->isMounted) {
 
                 return (ES_STATE_TRANSITION(stateExportChoose));
             } else {
 
+                return (ES_STATE_TRANSITION(stateExportMountFail));
+            }
+        }
+        case EVT_USB_DETACH: {
+
+            return (ES_STATE_TRANSITION(stateExportInsert));
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*
+ * A drive which did not mount is not retried, it has to be removed and
+ * inserted again.
+ */
+static esAction stateExportMountFail(void * space, const esEvent * event) {
+    (void)space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            screenExportMountFail();
+            buzzerMelody(FailNotification);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_USB_DETACH: {
+
+            return (ES_STATE_TRANSITION(stateExportInsert));
+        }
+        case EVT_TOUCH_TAG : {
+            const struct touchEvent * touchEvent = (const struct touchEvent *)event;
+
+            if (touchEvent->tag == 'B') {
+
                 return (ES_STATE_TRANSITION(stateMain));
+            } else {
+
+                return (ES_STATE_HANDLED());
             }
         }
         default : {
@@ -2244,9 +2607,12 @@ static esAction stateExportChoose(void * space, const esEvent * event) {
     switch (event->id) {
         case ES_ENTRY: {
             struct appDataLog           dataLog;
+            struct usbTiming            timing;
             uint32_t                    numOfLogs;
+            uint32_t                    cursorNo;
 
             appDataLogNumberOfEntries(&numOfLogs);
+            appDataLogExportCursor(&cursorNo);
             appDataLogLoad(numOfLogs - 1u, &dataLog);
             wspace->state.exportChoose.end[EXPORT_DAY]     = dataLog.timestamp.day;
             wspace->state.exportChoose.end[EXPORT_MONTH]   = dataLog.timestamp.month;
@@ -2256,24 +2622,19 @@ static esAction stateExportChoose(void * space, const esEvent * event) {
             wspace->state.exportChoose.begin[EXPORT_MONTH] = dataLog.timestamp.month;
             wspace->state.exportChoose.begin[EXPORT_YEAR]  = dataLog.timestamp.year;
             wspace->state.exportChoose.focus               = 0;
+            wspace->state.exportChoose.nNewLogs            = numOfLogs - cursorNo;
+            appUsbGetTiming(&timing);
+            wspace->state.exportChoose.mountMs             = timing.mounted;
             wspace->state.exportChoose.isExportEnabled     = true;
+            wspace->state.exportChoose.isNewOnly           = false;
+            wspace->state.exportChoose.format              = DATA_LOG_FORMAT_CSV;
             screenExportChoose(&wspace->state);
-            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(100),
-                    EXPORT_CHOOSE_REFRESH_);
 
             return (ES_STATE_HANDLED());
         }
-        case EXPORT_CHOOSE_REFRESH_: {
+        case EVT_USB_DETACH: {
 
-            if (isUsbDetected() == false) {
-                
-                return (ES_STATE_TRANSITION(stateMain));
-            } else {
-                appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(100),
-                    EXPORT_CHOOSE_REFRESH_);
-                
-                return (ES_STATE_HANDLED());
-            }
+            return (ES_STATE_TRANSITION(stateMain));
         }
         case EVT_TOUCH_TAG : {
             const struct touchEvent * touchEvent = (const struct touchEvent *)event;
@@ -2326,6 +2687,19 @@ static esAction stateExportChoose(void * space, const esEvent * event) {
                 case 'E' : {
                     return (ES_STATE_TRANSITION(stateExportSaving));
                 }
+                case 'N' : {
+                    wspace->state.exportChoose.isNewOnly = true;
+
+                    return (ES_STATE_TRANSITION(stateExportSaving));
+                }
+                case 'F' : {
+                    wspace->state.exportChoose.format++;
+
+                    if (wspace->state.exportChoose.format == DATA_LOG_LAST_FORMAT) {
+                        wspace->state.exportChoose.format = DATA_LOG_FORMAT_CSV;
+                    }
+                    break;
+                }
                 default: {
                     break;
                 }
@@ -2382,36 +2756,87 @@ static esAction stateExportSaving(void * space, const esEvent * event) {
 
     switch (event->id) {
         case ES_ENTRY: {
-            appDataLogNumberOfEntries(&wspace->state.export.numOfLogs);
-            wspace->state.export.currentNo = 0u;
+            struct exportStartEvent *   request;
+            struct appTime              begin;
+            struct appTime              end;
+            bool                        isNewOnly;
+            enum dataLogFormat          format;
+            uint32_t                    firstNo;
+            uint32_t                    endNo;
+            esError                     error;
+
+            /*
+             * Export state shares the union with the choose state, the dates
+             * are copied out before the range is written over them.
+             */
+            begin.day   = (uint8_t) wspace->state.exportChoose.begin[EXPORT_DAY];
+            begin.month = (uint8_t) wspace->state.exportChoose.begin[EXPORT_MONTH];
+            begin.year  = (uint16_t)wspace->state.exportChoose.begin[EXPORT_YEAR];
+            end.day     = (uint8_t) wspace->state.exportChoose.end[EXPORT_DAY];
+            end.month   = (uint8_t) wspace->state.exportChoose.end[EXPORT_MONTH];
+            end.year    = (uint16_t)wspace->state.exportChoose.end[EXPORT_YEAR];
+            isNewOnly   = wspace->state.exportChoose.isNewOnly;
+            format      = wspace->state.exportChoose.format;
+
+            if (isNewOnly) {
+                appDataLogExportCursor(&firstNo);
+                appDataLogNumberOfEntries(&endNo);
+            } else if (appDataLogFindRange(&begin, &end, &firstNo, &endNo) != ES_ERROR_NONE) {
+                firstNo = 0u;
+                endNo   = 0u;
+            }
+            wspace->state.export.nDone      = 0u;
+            wspace->state.export.nEntries   = endNo - firstNo;
+            wspace->state.export.isCanceled = false;
+            ES_ENSURE(error = esEventCreate(sizeof(*request), EVT_EXPORT_START, (esEvent **)&request));
+
+            if (error == ES_ERROR_NONE) {
+                request->firstNo   = firstNo;
+                request->endNo     = endNo;
+                request->isNewOnly = isNewOnly;
+                request->format    = format;
+                ES_ENSURE(esEpaSendEvent(Export, (esEvent *)request));
+            }
             screenExportSaving(&wspace->state);
-            appDataLogExportInit();
-            
-            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(100), WAKEUP_TIMEOUT_);
 
             return (ES_STATE_HANDLED());
         }
-        case ES_INIT: {
-            /*TODO: Notify bad drive.*/
-            if (appDataLogExportInit() != ES_ERROR_NONE) {
-                return (ES_STATE_TRANSITION(stateExport));
+        case EVT_EXPORT_PROGRESS: {
+            const struct exportProgressEvent * progress = (const struct exportProgressEvent *)event;
+
+            wspace->state.export.nDone    = progress->nDone;
+            wspace->state.export.nEntries = progress->nEntries;
+
+            if (!isGpuBusy()) {                                                 /* Skip the frame if previous one is not finished yet       */
+                screenExportSaving(&wspace->state);
             }
 
             return (ES_STATE_HANDLED());
         }
-        case WAKEUP_TIMEOUT_: {
-            uint32_t entries;
-            uint32_t entryNo;
+        case EVT_EXPORT_DONE: {
+            const struct exportDoneEvent * done = (const struct exportDoneEvent *)event;
 
-            appDataLogNumberOfEntries(&entries);
+            if (done->result == EXPORT_FAILED) {                                /*TODO: Notify bad drive.                                   */
 
-            for (entryNo = 0; entryNo < entries; entryNo++) {
-                appDataLogExport(entryNo);
+                return (ES_STATE_TRANSITION(stateExport));
             }
-            appDataLogExportTerm();
 
             return (ES_STATE_TRANSITION(stateMain));
         }
+        case EVT_USB_DETACH: {                                                  /* Stop before the drive could be mounted again             */
+            cancelExport(&wspace->state);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TOUCH_TAG : {
+            const struct touchEvent * touchEvent = (const struct touchEvent *)event;
+
+            if (touchEvent->tag == 'C') {
+                cancelExport(&wspace->state);
+            }
+
+            return (ES_STATE_HANDLED());
+        }
         default : {
 
             return (ES_STATE_IGNORED());
@@ -0,0 +1,792 @@
+/*=========================================================  INCLUDE FILES  ==*/
+
+#include "epa_test.h"
+#include "eds/epa.h"
+#include "vtimer/vtimer.h"
+
+#include "app_config.h"
+#include "app_motor.h"
+#include "app_psensor.h"
+#include "app_pdetector.h"
+#include "app_timer.h"
+#include "app_time.h"
+#include "app_user.h"
+#include "app_data_log.h"
+#include "app_curve.h"
+#include "app_predict.h"
+#include "app_leak.h"
+
+/*=========================================================  LOCAL MACRO's  ==*/
+
+#define CONFIG_ZERO_CALIB_MS            2000
+#define CONFIG_ZERO_CALIB_REFRESH_MS    100
+#define CONFIG_IDLE_REFRESH_MS          1000
+#define CONFIG_TEST_REFRESH_MS          50
+#define CONFIG_TEST_CAPTURE_DECIMATION  5
+#define CONFIG_TEST_DRAIN_SIZE          16
+
+/*
+ * When enabled the pump is driven in closed loop towards the second threshold
+ * plus 1/2^CONFIG_TEST_PUMP_HEADROOM_SHIFT of it, otherwise it only soft
+ * starts to full duty. The loop gains are not tuned yet: with them
+ * tools/pump_sim shows the loop reaching the threshold later than full duty
+ * and cutting the overshoot only a little. Enable it only with gains for which
+ * pump_sim beats full duty on both.
+ */
+#define CONFIG_TEST_PUMP_CONTROL        0
+#define CONFIG_TEST_PUMP_HEADROOM_SHIFT 3
+
+#define TEST_TABLE(entry)                                                       \
+    entry(stateInit,                TOP)                                        \
+    entry(stateZero,                TOP)                                        \
+    entry(stateIdle,                TOP)                                        \
+    entry(stateRun,                 TOP)                                        \
+    entry(stateRunFirstTh,          stateRun)                                   \
+    entry(stateRunSecondTh,         stateRun)                                   \
+    entry(stateRunDecay,            stateRun)                                   \
+    entry(stateDone,                TOP)                                        \
+    entry(stateSaving,              TOP)
+
+/*======================================================  LOCAL DATA TYPES  ==*/
+
+enum testStateId {
+    ES_STATE_ID_INIT(TEST_TABLE)
+};
+
+enum testLocalEventId {
+    ZERO_WAIT_ = ES_EVENT_LOCAL_ID,
+    ZERO_REFRESH_,
+    IDLE_REFRESH_,
+    FIRST_TH_TIMEOUT_,
+    FIRST_TH_REFRESH_,
+    SECOND_TH_TIMEOUT_,
+    SECOND_TH_REFRESH_,
+    DECAY_TIMEOUT_,
+    DECAY_REFRESH_,
+    SAVE_
+};
+
+struct wspace {
+    struct appTimer     timeout;
+    struct appTimer     refresh;
+    uint32_t            station;
+    struct testStatus * status;
+    uint32_t            timestamp;
+    uint32_t            armSeq;                                                 /* Of the threshold currently armed                         */
+    enum predictMode    predictMode;
+    enum predictVerdict verdict;
+    struct predict      predict;
+    struct leak         leak;
+    esAction            nextState;
+};
+
+/*=============================================  LOCAL FUNCTION PROTOTYPES  ==*/
+
+static esAction stateInit               (void *, const esEvent *);
+static esAction stateZero               (void *, const esEvent *);
+static esAction stateIdle               (void *, const esEvent *);
+static esAction stateRun                (void *, const esEvent *);
+static esAction stateRunFirstTh         (void *, const esEvent *);
+static esAction stateRunSecondTh        (void *, const esEvent *);
+static esAction stateRunDecay           (void *, const esEvent *);
+static esAction stateDone               (void *, const esEvent *);
+static esAction stateSaving             (void *, const esEvent *);
+
+/*=======================================================  LOCAL VARIABLES  ==*/
+
+static const ES_MODULE_INFO_CREATE("Test", CONFIG_EPA_TEST_NAME, "Nenad Radulovic");
+
+static const esSmTable  TestTable[] = ES_STATE_TABLE_INIT(TEST_TABLE);
+
+static struct testStatus Status[CONFIG_NUM_OF_STATIONS];
+
+/*======================================================  GLOBAL VARIABLES  ==*/
+
+const struct esEpaDefine TestEpa[CONFIG_NUM_OF_STATIONS] = {
+    ES_EPA_DEFINE(
+        CONFIG_EPA_TEST_NAME,
+        CONFIG_EPA_TEST_PRIORITY,
+        CONFIG_EPA_TEST_QUEUE_SIZE),
+#if (CONFIG_NUM_OF_STATIONS > 1)
+    ES_EPA_DEFINE(
+        CONFIG_EPA_TEST_NAME,
+        CONFIG_EPA_TEST_PRIORITY - 1,
+        CONFIG_EPA_TEST_QUEUE_SIZE),
+#endif
+};
+const struct esSmDefine  TestSm = ES_SM_DEFINE(
+    TestTable,
+    sizeof(struct wspace),
+    stateInit);
+struct esEpa *           Test[CONFIG_NUM_OF_STATIONS];
+
+/*============================================  LOCAL FUNCTION DEFINITIONS  ==*/
+
+/*--  SUPPORT  ---------------------------------------------------------------*/
+
+static void notifyStatus(const struct wspace * wspace, bool isCurveUpdated) {
+    struct testStatusEvent * notify;
+    esError             error;
+
+    ES_ENSURE(error = esEventCreate(sizeof(struct testStatusEvent), EVT_TEST_STATUS, (esEvent **)&notify));
+
+    if (error == ES_ERROR_NONE) {
+        notify->station        = wspace->station;
+        notify->isCurveUpdated = isCurveUpdated;
+        ES_ENSURE(esEpaSendEvent(CONFIG_EPA_TEST_CONSUMER, (esEvent *)notify));
+    }
+}
+
+static void setStage(struct wspace * wspace, enum testStage stage) {
+    wspace->status->stage = stage;
+    notifyStatus(wspace, false);
+}
+
+/*
+ * Pad detector events are the same in every state. A part which was removed
+ * after the result is a new part once it is put back.
+ */
+static void padChanged(struct wspace * wspace, bool isDutInPlace) {
+    wspace->status->isDutInPlace = isDutInPlace;
+
+    if (!isDutInPlace) {
+        wspace->status->isNewDut = true;
+    }
+    notifyStatus(wspace, false);
+}
+
+/*
+ * Drain captured samples into the maximum value, the curve and the predictor.
+ * Returns true when the curve got a new point.
+ */
+static bool drainTestCapture(struct wspace * wspace, struct testThStatus * th) {
+    struct adcSample    samples[CONFIG_TEST_DRAIN_SIZE];
+    uint32_t            nSamples;
+    bool                isUpdated;
+
+    isUpdated = false;
+
+    while ((nSamples = dutReadCapture(wspace->station, samples, CONFIG_TEST_DRAIN_SIZE)) != 0u) {
+        uint32_t        cnt;
+
+        for (cnt = 0u; cnt < nSamples; cnt++) {
+            uint32_t    rawVacuum;
+
+            rawVacuum = 0u;
+
+            if (wspace->status->rawIdleVacuum > (uint32_t)samples[cnt].value) {
+                rawVacuum = wspace->status->rawIdleVacuum - (uint32_t)samples[cnt].value;
+            }
+
+            if (th->rawMaxValue < rawVacuum) {
+                th->rawMaxValue = rawVacuum;
+            }
+
+            if (curvePush(&wspace->status->curve, rawVacuum)) {
+                isUpdated = true;
+            }
+
+            if (wspace->predictMode != PREDICT_DISABLED) {
+                wspace->verdict = predictPush(&wspace->predict, rawVacuum);
+            }
+
+            if (wspace->status->decay.state == TEST_STARTED) {
+                leakPush(&wspace->leak, rawVacuum);
+            }
+        }
+    }
+
+    return (isUpdated);
+}
+
+static void saveTestEntry(const struct testStatus * status) {
+    struct appDataLog   entry;
+    const uint16_t *    samples;
+    uint32_t            nSamples;
+
+    entry.hasPassed         = isTestPassed(status);
+    entry.isPredicted       = status->isPredicted;
+    entry.th[0].time        = status->th[0].time;
+    entry.th[0].rawMaxValue = status->th[0].rawMaxValue;
+    entry.th[1].time        = status->th[1].time;
+    entry.th[1].rawMaxValue = status->th[1].rawMaxValue;
+    entry.numOfTests        = status->count;
+    entry.decay.rawRate     = status->decay.rawRate;
+
+    if (status->decay.state == TEST_VALID) {
+        entry.decay.state = DATA_LOG_DECAY_PASSED;
+    } else if (status->decay.state == TEST_FAILED) {
+        entry.decay.state = DATA_LOG_DECAY_FAILED;
+    } else {
+        entry.decay.state = DATA_LOG_DECAY_NOT_EXECUTED;
+    }
+    nSamples = curveGetSamples(&status->curve, &samples);
+    appDataLogSetCurve(&entry, samples, nSamples,
+        curveGetDecimation(&status->curve) * dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION));
+    appTimeGet(&entry.timestamp);
+    appUserGetCurrent(&entry.user);
+    appDataLogSave(&entry);
+}
+
+/*--  End of SUPPORT  --------------------------------------------------------*/
+
+/*
+ * The station is not known when the EPA is created, it is found by comparing
+ * the running EPA with the handles of all stations. An EPA which is not one of
+ * them is a start-up error.
+ */
+static esAction stateInit(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_INIT: {
+
+            for (wspace->station = 0u; wspace->station < CONFIG_NUM_OF_STATIONS; wspace->station++) {
+
+                if (Test[wspace->station] == esEdsGetCurrent()) {
+                    break;
+                }
+            }
+            ES_REQUIRE(ES_API_RANGE, wspace->station < CONFIG_NUM_OF_STATIONS);
+            wspace->status               = &Status[wspace->station];
+            wspace->status->stage        = TEST_STAGE_ZERO;
+            wspace->status->isDutInPlace = false;
+            wspace->status->isNewDut     = false;
+            wspace->status->count        = 0u;
+            appTimerInit(&wspace->timeout);
+            appTimerInit(&wspace->refresh);
+
+            return (ES_STATE_TRANSITION(stateZero));
+        }
+        default: {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateZero(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_MS), ZERO_WAIT_);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_REFRESH_MS), ZERO_REFRESH_);
+            dutStartZero(wspace->station);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ZERO_REFRESH_: {
+
+            if (dutUpdateZero(wspace->station)) {
+                wspace->status->rawIdleVacuum = dutGetZero(wspace->station);
+
+                return (ES_STATE_TRANSITION(stateIdle));
+            }
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_ZERO_CALIB_REFRESH_MS), ZERO_REFRESH_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ZERO_WAIT_: {                                                      /* Never got stable, use whatever we have                   */
+            dutUpdateZero(wspace->station);
+            wspace->status->rawIdleVacuum = dutGetZero(wspace->station);
+
+            return (ES_STATE_TRANSITION(stateIdle));
+        }
+        case EVT_PDETECT_PRESS : {
+            padChanged(wspace, true);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PDETECT_RELEASE : {
+            padChanged(wspace, false);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_EXIT: {
+            appTimerCancel(&wspace->refresh);
+            appTimerCancel(&wspace->timeout);
+            dutStopZero(wspace->station);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateIdle(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            setStage(wspace, TEST_STAGE_IDLE);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_IDLE_REFRESH_MS), IDLE_REFRESH_);
+            dutStartZero(wspace->station);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_EXIT: {
+            appTimerCancel(&wspace->refresh);
+            dutStopZero(wspace->station);
+
+            return (ES_STATE_HANDLED());
+        }
+        case IDLE_REFRESH_: {
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_IDLE_REFRESH_MS), IDLE_REFRESH_);
+
+            if (dutUpdateZero(wspace->station)) {                               /* Follow the drift of the atmospheric level between tests  */
+                wspace->status->rawIdleVacuum = dutTrackZero(wspace->station, wspace->status->rawIdleVacuum);
+            }
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TEST_START : {
+
+            if (!wspace->status->isDutInPlace) {
+
+                return (ES_STATE_HANDLED());
+            }
+
+            return (ES_STATE_TRANSITION(stateRun));
+        }
+        case EVT_PDETECT_PRESS : {
+            padChanged(wspace, true);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PDETECT_RELEASE : {
+            padChanged(wspace, false);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*
+ * Every attempt starts from the configured thresholds and timeouts, only the
+ * attempt counter is kept for the same part.
+ */
+static esAction stateRun(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY : {
+            struct testStatus * status = wspace->status;
+
+            status->count++;
+            status->isNewDut          = false;
+            status->isPredicted       = false;
+            status->th[0].state       = TEST_NOT_EXECUTED;
+            status->th[0].rawMaxValue = 0u;
+            status->th[0].rawThValue  = configGetTh0RawVacuum();
+            status->th[0].time        = configGetTh0Timeout();
+            status->th[1].state       = TEST_NOT_EXECUTED;
+            status->th[1].rawMaxValue = 0u;
+            status->th[1].rawThValue  = configGetTh1RawVacuum();
+            status->th[1].time        = configGetTh1Timeout();
+            status->decay.state       = TEST_NOT_EXECUTED;
+            status->decay.time        = configGetDecayTimeout();
+            status->decay.rawLimit    = configGetDecayRawLeakRate();
+            status->decay.rawRate     = 0;
+            wspace->predictMode       = (enum predictMode)configGetPredictMode();
+            curveStart(
+                &status->curve,
+                status->th[0].rawThValue,
+                status->th[1].rawThValue,
+                (status->th[0].time + status->th[1].time + status->decay.time) /
+                    dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION));
+            dutStartCapture(wspace->station, CONFIG_TEST_CAPTURE_DECIMATION);
+            predictStart(&wspace->predict);
+#if (CONFIG_TEST_PUMP_CONTROL == 1)
+            motorEnableControl(
+                wspace->station,
+                status->rawIdleVacuum,
+                status->th[1].rawThValue + (status->th[1].rawThValue >> CONFIG_TEST_PUMP_HEADROOM_SHIFT));
+#else
+            motorEnable(wspace->station);
+#endif
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_EXIT : {
+            motorDisable(wspace->station);
+            dutStopCapture(wspace->station);
+
+            return (ES_STATE_HANDLED());
+        }
+        case ES_INIT : {
+
+            return (ES_STATE_TRANSITION(stateRunFirstTh));
+        }
+        case EVT_PDETECT_PRESS : {
+            padChanged(wspace, true);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PDETECT_RELEASE : {
+            padChanged(wspace, false);
+
+            return (ES_STATE_TRANSITION(stateDone));
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateRunFirstTh(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            wspace->status->th[0].state = TEST_STARTED;
+            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->status->th[0].time), FIRST_TH_TIMEOUT_);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), FIRST_TH_REFRESH_);
+            wspace->timestamp = getDutTimestamp();
+            wspace->verdict   = PREDICT_UNKNOWN;
+            predictSetTarget(&wspace->predict, wspace->status->th[0].rawThValue,
+                wspace->status->th[0].time / dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION));
+            wspace->armSeq = dutArmThreshold(wspace->station, wspace->status->rawIdleVacuum,
+                wspace->status->th[0].rawThValue);
+            setStage(wspace, TEST_STAGE_FIRST_TH);
+
+            return (ES_STATE_HANDLED());
+        }
+        case FIRST_TH_REFRESH_: {
+
+            if (drainTestCapture(wspace, &wspace->status->th[0])) {
+                notifyStatus(wspace, true);
+            }
+
+            if (wspace->verdict == PREDICT_FAIL) {
+                wspace->status->th[0].state = TEST_FAILED;
+                wspace->status->isPredicted = true;
+
+                return (ES_STATE_TRANSITION(stateDone));
+            }
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), FIRST_TH_REFRESH_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PSENSOR_THRESHOLD : {
+            const struct psensorEvent * psensorEvent =
+                (const struct psensorEvent *)event;
+            uint32_t rawVacuum;
+
+            if (psensorEvent->armSeq != wspace->armSeq) {                       /* Queued before the comparator was disarmed                */
+
+                return (ES_STATE_HANDLED());
+            }
+            rawVacuum = wspace->status->rawIdleVacuum - psensorEvent->rawValue;
+
+            if (wspace->status->th[0].rawMaxValue < rawVacuum) {
+                wspace->status->th[0].rawMaxValue = rawVacuum;
+            }
+            wspace->status->th[0].state = TEST_VALID;
+            wspace->status->th[0].time  = dutTimestampToMs(psensorEvent->timestamp - wspace->timestamp);
+            /* Set the maxumum value for the second pass, too. */
+            wspace->status->th[1].rawMaxValue = wspace->status->th[0].rawMaxValue;
+
+            return (ES_STATE_TRANSITION(stateRunSecondTh));
+        }
+        case FIRST_TH_TIMEOUT_: {
+
+            return (ES_STATE_TRANSITION(stateDone));
+        }
+        case ES_EXIT : {
+            dutDisarmThreshold(wspace->station);
+            appTimerCancel(&wspace->refresh);
+            appTimerCancel(&wspace->timeout);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+static esAction stateRunSecondTh(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            wspace->status->th[1].state = TEST_STARTED;
+            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->status->th[1].time), SECOND_TH_TIMEOUT_);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), SECOND_TH_REFRESH_);
+            wspace->timestamp = getDutTimestamp();
+            wspace->verdict   = PREDICT_UNKNOWN;
+            predictSetTarget(&wspace->predict, wspace->status->th[1].rawThValue,
+                wspace->status->th[1].time / dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION));
+            wspace->armSeq = dutArmThreshold(wspace->station, wspace->status->rawIdleVacuum,
+                wspace->status->th[1].rawThValue);
+            setStage(wspace, TEST_STAGE_SECOND_TH);
+
+            return (ES_STATE_HANDLED());
+        }
+        case SECOND_TH_REFRESH_: {
+
+            if (drainTestCapture(wspace, &wspace->status->th[1])) {
+                notifyStatus(wspace, true);
+            }
+
+            if (wspace->verdict == PREDICT_FAIL) {
+                wspace->status->th[1].state = TEST_FAILED;
+                wspace->status->isPredicted = true;
+
+                return (ES_STATE_TRANSITION(stateDone));
+            }
+
+            if ((wspace->verdict == PREDICT_PASS) &&
+                (wspace->predictMode == PREDICT_PASS_FAIL) &&
+                (wspace->status->decay.time == 0u)) {                           /* Leak test must start from the real threshold             */
+                wspace->status->th[1].state = TEST_VALID;
+                wspace->status->isPredicted = true;
+                wspace->status->th[1].time  = predictGetCrossing(&wspace->predict) *
+                    dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION);
+
+                return (ES_STATE_TRANSITION(stateDone));
+            }
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), SECOND_TH_REFRESH_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PSENSOR_THRESHOLD : {
+            const struct psensorEvent * psensorEvent =
+                (const struct psensorEvent *)event;
+            uint32_t rawVacuum;
+
+            if (psensorEvent->armSeq != wspace->armSeq) {                       /* Queued before the comparator was disarmed                */
+
+                return (ES_STATE_HANDLED());
+            }
+            rawVacuum = wspace->status->rawIdleVacuum - psensorEvent->rawValue;
+
+            if (wspace->status->th[1].rawMaxValue < rawVacuum) {
+                wspace->status->th[1].rawMaxValue = rawVacuum;
+            }
+            wspace->status->th[1].state = TEST_VALID;
+            wspace->status->th[1].time  = dutTimestampToMs(psensorEvent->timestamp - wspace->timestamp);
+
+            if (wspace->status->decay.time != 0u) {
+
+                return (ES_STATE_TRANSITION(stateRunDecay));
+            }
+
+            return (ES_STATE_TRANSITION(stateDone));
+        }
+        case SECOND_TH_TIMEOUT_: {
+
+            return (ES_STATE_TRANSITION(stateDone));
+        }
+        case ES_EXIT: {
+            dutDisarmThreshold(wspace->station);
+            appTimerCancel(&wspace->refresh);
+            appTimerCancel(&wspace->timeout);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*
+ * Pump is stopped and the vacuum is left to decay. The part fails when the
+ * vacuum loss rate over the window is above the configured limit.
+ */
+static esAction stateRunDecay(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            motorDisable(wspace->station);
+            drainTestCapture(wspace, &wspace->status->th[1]);                   /* Samples taken while pumping are not part of the fit      */
+            wspace->status->decay.state = TEST_STARTED;
+            leakStart(&wspace->leak, dutCapturePeriodMs(CONFIG_TEST_CAPTURE_DECIMATION));
+            appTimerStart(&wspace->timeout, ES_VTMR_TIME_TO_TICK_MS(wspace->status->decay.time), DECAY_TIMEOUT_);
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), DECAY_REFRESH_);
+            setStage(wspace, TEST_STAGE_DECAY);
+
+            return (ES_STATE_HANDLED());
+        }
+        case DECAY_REFRESH_: {
+
+            if (drainTestCapture(wspace, &wspace->status->th[1])) {
+                notifyStatus(wspace, true);
+            }
+            appTimerStart(&wspace->refresh, ES_VTMR_TIME_TO_TICK_MS(CONFIG_TEST_REFRESH_MS), DECAY_REFRESH_);
+
+            return (ES_STATE_HANDLED());
+        }
+        case DECAY_TIMEOUT_: {
+            drainTestCapture(wspace, &wspace->status->th[1]);
+            wspace->status->decay.rawRate = leakGetRate(&wspace->leak);
+
+            if (wspace->status->decay.rawRate <= (int32_t)wspace->status->decay.rawLimit) {
+                wspace->status->decay.state = TEST_VALID;
+            } else {
+                wspace->status->decay.state = TEST_FAILED;
+            }
+
+            return (ES_STATE_TRANSITION(stateDone));
+        }
+        case ES_EXIT: {
+            appTimerCancel(&wspace->refresh);
+            appTimerCancel(&wspace->timeout);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*
+ * The result is kept until the part is finished. The same part may be tested
+ * again while it failed and retries are left, a new part is tested only after
+ * the result of the previous one is saved.
+ */
+static esAction stateDone(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            setStage(wspace, TEST_STAGE_DONE);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TEST_START : {
+
+            if (!wspace->status->isDutInPlace) {
+
+                return (ES_STATE_HANDLED());
+            }
+
+            if (wspace->status->isNewDut) {
+                wspace->nextState = ES_STATE_TRANSITION(stateRun);
+
+                return (ES_STATE_TRANSITION(stateSaving));
+            }
+
+            if (!isTestPassed(wspace->status) && (wspace->status->count < configGetRetryCount())) {
+
+                return (ES_STATE_TRANSITION(stateRun));
+            }
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_TEST_FINISH : {
+            wspace->nextState = ES_STATE_TRANSITION(stateIdle);
+
+            return (ES_STATE_TRANSITION(stateSaving));
+        }
+        case EVT_PDETECT_PRESS : {
+            padChanged(wspace, true);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PDETECT_RELEASE : {
+            padChanged(wspace, false);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*
+ * Saving is deferred by one event so the GUI, which runs at higher priority,
+ * can show the saving screen before the storage is busy.
+ */
+static esAction stateSaving(void * space, const esEvent * event) {
+    struct wspace * wspace = space;
+
+    switch (event->id) {
+        case ES_ENTRY: {
+            esEvent *   save;
+            esError     error;
+
+            appDataLogNumberOfEntries(&wspace->status->nEntries);
+            setStage(wspace, TEST_STAGE_SAVING);
+            ES_ENSURE(error = esEventCreate(sizeof(esEvent), SAVE_, &save));
+
+            if (error == ES_ERROR_NONE) {
+                ES_ENSURE(esEpaSendEvent(Test[wspace->station], save));
+            }
+
+            return (ES_STATE_HANDLED());
+        }
+        case SAVE_: {
+            saveTestEntry(wspace->status);
+            wspace->status->count = 0u;
+
+            return (wspace->nextState);
+        }
+        case EVT_PDETECT_PRESS : {
+            padChanged(wspace, true);
+
+            return (ES_STATE_HANDLED());
+        }
+        case EVT_PDETECT_RELEASE : {
+            padChanged(wspace, false);
+
+            return (ES_STATE_HANDLED());
+        }
+        default : {
+
+            return (ES_STATE_IGNORED());
+        }
+    }
+}
+
+/*===================================  GLOBAL PRIVATE FUNCTION DEFINITIONS  ==*/
+/*====================================  GLOBAL PUBLIC FUNCTION DEFINITIONS  ==*/
+
+const struct testStatus * testGetStatus(uint32_t station) {
+
+    return (&Status[station]);
+}
+
+bool isTestPassed(const struct testStatus * status) {
+
+    if ((status->th[0].state == TEST_VALID) &&
+        (status->th[1].state == TEST_VALID) &&
+        ((status->decay.state == TEST_VALID) || (status->decay.state == TEST_NOT_EXECUTED))) {
+
+        return (true);
+    } else {
+
+        return (false);
+    }
+}
+
+/*================================*//** @cond *//*==  CONFIGURATION ERRORS  ==*/
+
+#if (CONFIG_NUM_OF_STATIONS < 1) || (CONFIG_NUM_OF_STATIONS > 2)
+# error "Test: CONFIG_NUM_OF_STATIONS must be 1 or 2, define the pins of other stations first."
+#endif
+
+#if (CONFIG_NUM_OF_STATIONS > 1) && !defined(CONFIG_PSENSOR_1_ADC_CHANNEL)
+# error "Test: the board has no second station, define its pins in pinout_config.h first."
+#endif
+
+/** @endcond *//***************************************************************
+ * END of epa_test.c
+ ******************************************************************************/
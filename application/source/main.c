@@ -15,6 +15,7 @@
 #include "driver/intr.h"
 #include "driver/spi.h"
 #include "driver/adc.h"
+#include "driver/pwm.h"
 #include "driver/s25fl.h"
 #include "driver/rtc.h"
 #include "driver/systick.h"
@@ -35,6 +36,8 @@
 #include "events.h"
 #include "epa_touch.h"
 #include "epa_gui.h"
+#include "epa_test.h"
+#include "epa_export.h"
 
 #include "main.h"
 
@@ -72,6 +75,7 @@ static void nativeFsm(void) {
 
 int main(void) {
     void *              heap;
+    uint32_t            station;
     
     /*--  Initialize drivers  ------------------------------------------------*/
     initClockDriver();
@@ -79,6 +83,7 @@ int main(void) {
     initGpioDriver();
     initSpiDriver();
     initAdcDriver();
+    initPwmDriver();
     initFlashDriver();
     initRtcDriver();
     initSysTickDriver();
@@ -113,10 +118,12 @@ int main(void) {
     storageRegisterEntry(&TouchStorage);
     storageRegisterEntry(&ConfigStorage);
     storageRegisterEntry(&ArrayDescStorage);
+    storageRegisterEntry(&ExportCursorStorage);
 
     /*--  Boot the rest of modules  ------------------------------------------*/
     initAppDataLog();
     initAppConfig();
+    dutLoadCalibration();
 
     appUserSetCurrent(APPUSER_OPERATOR_ID);
     
@@ -135,6 +142,11 @@ int main(void) {
     /*--  Create EPAs  -------------------------------------------------------*/
     ES_ENSURE(esEpaCreate(&GuiEpa,     &GuiSm,     &StaticMem, &Gui));
     ES_ENSURE(esEpaCreate(&TouchEpa,   &TouchSm,   &StaticMem, &Touch));
+
+    for (station = 0u; station < CONFIG_NUM_OF_STATIONS; station++) {
+        ES_ENSURE(esEpaCreate(&TestEpa[station], &TestSm, &StaticMem, &Test[station]));
+    }
+    ES_ENSURE(esEpaCreate(&ExportEpa,  &ExportSm,  &StaticMem, &Export));
     
     /*--  Set application idle routine  --------------------------------------*/
     esEdsSetIdle(nativeFsm);
@@ -9,15 +9,64 @@
 #define	ADC_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+enum adcCompareType {
+    ADC_COMPARE_BELOW,
+    ADC_COMPARE_ABOVE
+};
+
+struct adcSample {
+    uint32_t            timestamp;
+    int32_t             value;
+};
+
+/*
+ * Single producer, single consumer ring. Only the ISR writes head and only the
+ * consumer writes tail, so neither side needs to disable interrupts. Compiler
+ * barriers keep the slot accesses on the right side of the head and tail
+ * updates, the single core needs no hardware barrier. Size must be a power of
+ * two.
+ */
+struct adcCapture {
+    struct adcSample *  buffer;
+    uint32_t            size;
+    volatile uint32_t   head;
+    volatile uint32_t   tail;
+    uint32_t            decimation;
+    uint32_t            decimationCount;
+    uint32_t            overflows;
+};
+
+struct adcFilter {
+    uint32_t            windowShift;                                            /* Box-car window is 2^windowShift samples, max 4           */
+    uint32_t            extraBits;                                              /* Bits kept above 10-bit resolution, max windowShift       */
+    uint32_t            iirShift;                                               /* IIR low-pass coefficient 1/2^iirShift, 0 disables it     */
+    bool                isMedianEnabled;                                        /* Median of three spike rejection                          */
+};
+
 void initAdcDriver(void);
 void adcEnableChannel(uint32_t id, void (* callback)(int32_t));
 void adcDisableChannel(uint32_t id);
+void adcSetCallback(uint32_t id, void (* callback)(int32_t));
 int32_t adcReadChannel(uint32_t id);
+bool adcSetFilter(uint32_t id, const struct adcFilter * filter);
+void adcArmComparator(uint32_t id, int32_t threshold, enum adcCompareType type,
+    void (* handler)(uint32_t, int32_t, uint32_t));
+void adcDisarmComparator(uint32_t id);
+uint32_t adcGetTimestamp(void);
+uint32_t adcTimestampToMs(uint32_t timestamp);
+uint32_t adcSamplesToMs(uint32_t nSamples);
+uint32_t adcGetIsrCycles(void);
+void adcCaptureInit(struct adcCapture * capture, struct adcSample * buffer, uint32_t size);
+void adcCaptureSetDecimation(struct adcCapture * capture, uint32_t decimation);
+uint32_t adcCaptureRead(struct adcCapture * capture, struct adcSample * samples, uint32_t count);
+void adcStartCapture(uint32_t id, struct adcCapture * capture);
+void adcStopCapture(uint32_t id);
 
 #ifdef	__cplusplus
 }
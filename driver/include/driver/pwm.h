@@ -0,0 +1,25 @@
+#ifndef PWM_H
+#define	PWM_H
+
+#include <stdint.h>
+
+/*
+ * Duty cycle is given as a fraction of PWM_DUTY_MAX.
+ */
+#define PWM_DUTY_MAX                    (0x1u << 16)
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+void initPwmDriver(void);
+void pwmStart(uint32_t frequency);
+void pwmSetDuty(uint32_t duty);
+void pwmStop(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PWM_H */
+
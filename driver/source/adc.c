@@ -1,6 +1,7 @@
 
 #include <xc.h>
 #include <sys/attribs.h>
+#include <string.h>
 
 #include "driver/clock.h"
 #include "driver/adc.h"
@@ -13,7 +14,9 @@
 
 #define CONFIG_NUM_OF_CHANNELS          16
 
-#define CONFIG_NUM_OF_SAMPLES           8
+#define CONFIG_NUM_OF_SAMPLES_SHIFT     3
+#define CONFIG_MAX_WINDOW_SHIFT         4
+#define CONFIG_MAX_WINDOW               (0x1u << CONFIG_MAX_WINDOW_SHIFT)
 
 #if (CONFIG_ADC_FREQUENCY < 250)
 #define TMR3_PRESCALER                  3
@@ -62,16 +65,135 @@
 #define T_CON_ON                        (0x1u << 15)
 #define T_CON_TCKPS(x)                  ((x) << 4)
 
+/*
+ * ADC1BUFx registers are not contiguous words, each one is followed by three
+ * reserved words.
+ */
+#define ADC1BUF(x)                      ((&ADC1BUF0)[(x) * 4u])
+
+#define CHANNEL_ID_MASK                 (CONFIG_NUM_OF_CHANNELS - 1u)
+
 struct adcChannel {
-    int32_t             output[CONFIG_NUM_OF_SAMPLES];
+    int16_t             window[CONFIG_MAX_WINDOW];
+    int16_t             history[2];
+    uint32_t            windowIndex;
+    int32_t             sum;
+    int32_t             iir;
+    struct adcFilter    filter;
+    bool                isPrimed;                                               /* Filter state holds samples of the input                  */
+    volatile int32_t    output;
+    struct adcCapture * volatile capture;
     void             (* callback)(int32_t);
+    void             (* compare)(uint32_t, int32_t, uint32_t);
+    int32_t             threshold;
+    enum adcCompareType compareType;
 };
 
 static uint32_t adcEnabledChannels;
 static uint32_t adcNumOfEnabledChannels;
-static uint32_t adcNumOfSamples;
+static struct adcChannel * adcScanTable[CONFIG_NUM_OF_CHANNELS];
+static volatile uint32_t adcTimestamp;
+static uint32_t adcIsrCycles;
 static struct adcChannel Channel[CONFIG_NUM_OF_CHANNELS];
 
+static int32_t median3(int32_t a, int32_t b, int32_t c) {
+
+    if (a > b) {
+        int32_t         tmp;
+
+        tmp = a;
+        a   = b;
+        b   = tmp;
+    }
+
+    if (c < a) {
+
+        return (a);
+    } else if (c > b) {
+
+        return (b);
+    } else {
+
+        return (c);
+    }
+}
+
+/*
+ * The first sample after enabling the channel or changing its filter fills the
+ * whole filter state, as if the input had been steady at that level. Starting
+ * from zero would show a transient from 0 up to the input which lasts for the
+ * window and the IIR time constant.
+ */
+static void primeFilter(struct adcChannel * channel, int32_t value) {
+    uint32_t            cnt;
+
+    for (cnt = 0u; cnt < CONFIG_MAX_WINDOW; cnt++) {
+        channel->window[cnt] = (int16_t)value;
+    }
+    channel->history[0] = (int16_t)value;
+    channel->history[1] = (int16_t)value;
+    channel->sum        = value << channel->filter.windowShift;
+    channel->iir        = (value << channel->filter.extraBits) << channel->filter.iirShift;
+    channel->isPrimed   = true;
+}
+
+/*
+ * Filter chain, evaluated in the ISR for each new sample:
+ * 1. optional median of the last three samples for spike rejection,
+ * 2. box-car window of 2^windowShift samples, its sum is shifted so that
+ *    extraBits of resolution are kept above the 10-bit converter,
+ * 3. optional first order IIR low-pass, y += (x - y) / 2^iirShift.
+ */
+static int32_t filterSample(struct adcChannel * channel, int32_t value) {
+
+    if (!channel->isPrimed) {
+        primeFilter(channel, value);
+    }
+
+    if (channel->filter.isMedianEnabled) {
+        int32_t         sample;
+
+        sample = value;
+        value  = median3(channel->history[0], channel->history[1], value);
+        channel->history[0] = channel->history[1];
+        channel->history[1] = (int16_t)sample;
+    }
+    channel->sum -= channel->window[channel->windowIndex];
+    channel->sum += value;
+    channel->window[channel->windowIndex] = (int16_t)value;
+    channel->windowIndex++;
+    channel->windowIndex &= (0x1u << channel->filter.windowShift) - 1u;
+    value = channel->sum >> (channel->filter.windowShift - channel->filter.extraBits);
+
+    if (channel->filter.iirShift != 0u) {
+        channel->iir += value - (channel->iir >> channel->filter.iirShift);
+        value = channel->iir >> channel->filter.iirShift;
+    }
+
+    return (value);
+}
+
+static void capturePush(struct adcCapture * capture, int32_t value) {
+    uint32_t            head;
+
+    if (++capture->decimationCount < capture->decimation) {
+
+        return;
+    }
+    capture->decimationCount = 0u;
+    head = capture->head;
+
+    if ((head - capture->tail) == capture->size) {
+        capture->overflows++;
+
+        return;
+    }
+    capture->buffer[head & (capture->size - 1u)].timestamp = adcTimestamp;
+    capture->buffer[head & (capture->size - 1u)].value     = value;
+    __asm__ volatile("" ::: "memory");                                          /* Slot is written before it is published                   */
+    capture->head = head + 1u;
+}
+
 static void enableTmr(void) {
     T3CON    = T_CON_TCKPS(TMR3_PRESCALER);
     TMR3     = 0u;
@@ -83,7 +205,25 @@ static void disableTmr(void) {
     T3CON   = 0u;
 }
 
+/*
+ * The converter scans enabled inputs in ascending order and stores result N
+ * into ADC1BUFN, so the scan table maps buffer slots to channel descriptors.
+ */
+static void buildScanTable(void) {
+    uint32_t            id;
+    uint32_t            slot;
+
+    for (id = 0u, slot = 0u; id < CONFIG_NUM_OF_CHANNELS; id++) {
+
+        if ((adcEnabledChannels & (0x1u << id)) != 0u) {
+            adcScanTable[slot++] = &Channel[id];
+        }
+    }
+    adcNumOfEnabledChannels = slot;
+}
+
 static void enableAdc(uint32_t numOfEnabledChannels) {
+    AD1CSSL = adcEnabledChannels;
     AD1CON1 = AD_CON1_FORM_U16_INTEGER    | AD_CON1_SSRC_TIMER3 | AD_CON1_ASAM;
     AD1CON2 = AD_CON2_VCFG_AVDD_AVSS      | AD_CON2_CSCNA       | AD_CON2_SMPI(numOfEnabledChannels);
     AD1CON3 = AD_CON3_ADCS(0xffu);
@@ -108,84 +248,239 @@ void initAdcDriver(void) {
     IPC5SET = IPC5_AD1_PRIORITY(CONFIG_ADC_ISR_PRIORITY) | IPC5_AD1_SUBPRIORITY(CONFIG_ADC_ISR_SUBPRIORITY);
 }
 
+/*
+ * Timer3 keeps running while the scan is reconfigured, only the converter is
+ * restarted. This keeps the sample timestamps of other channels continuous.
+ */
 void adcEnableChannel(uint32_t id, void (* callback)(int32_t)) {
-    id &= 0x1fu;
+    bool                isTmrRunning;
 
-    memset(&Channel[id].output, 0, sizeof(Channel[id].output));
+    id &= CHANNEL_ID_MASK;
+    isTmrRunning = (adcEnabledChannels != 0u);
+    disableAdc();
+    memset(&Channel[id], 0, sizeof(Channel[id]));
+    Channel[id].filter.windowShift = CONFIG_NUM_OF_SAMPLES_SHIFT;
     Channel[id].callback = callback;
-
-    if (adcEnabledChannels != 0u) {
-        disableTmr();
-        disableAdc();
-    }
     adcEnabledChannels |= (0x1u << id);
-    AD1CSSL = adcEnabledChannels;
-    adcNumOfEnabledChannels++;
+    buildScanTable();
     enableAdc(adcNumOfEnabledChannels);
-    enableTmr();
+
+    if (!isTmrRunning) {
+        enableTmr();
+    }
 }
 
 void adcDisableChannel(uint32_t id) {
-    id &= 0x1fu;
-    Channel[id].callback = NULL;
-    disableTmr();
+    id &= CHANNEL_ID_MASK;
+
+    if ((adcEnabledChannels & (0x1u << id)) == 0u) {
+
+        return;
+    }
     disableAdc();
+    Channel[id].callback = NULL;
+    Channel[id].compare  = NULL;
     adcEnabledChannels &= ~(0x1u << id);
-    adcNumOfEnabledChannels--;
+    buildScanTable();
 
     if (adcEnabledChannels != 0u) {
-        AD1CSSL = adcEnabledChannels;
         enableAdc(adcNumOfEnabledChannels);
-        enableTmr();
+    } else {
+        disableTmr();
     }
 }
 
+/*
+ * Callback runs in interrupt context for every filtered sample of the channel.
+ */
+void adcSetCallback(uint32_t id, void (* callback)(int32_t)) {
+    id &= CHANNEL_ID_MASK;
+    IEC0CLR = IEC0_AD1IE;
+    Channel[id].callback = callback;
+
+    if (adcEnabledChannels != 0u) {
+        IEC0SET = IEC0_AD1IE;
+    }
+}
+
+/*
+ * The ISR publishes the filtered value as a single aligned word, so reading it
+ * can not tear and needs no locking.
+ */
 int32_t adcReadChannel(uint32_t id) {
-    id &= 0x1fu;
+    id &= CHANNEL_ID_MASK;
 
     if ((adcEnabledChannels & (0x1u << id)) != 0u) {
-        int32_t         retval;
-        uint32_t        itr;
 
-        for (retval = 0, itr = 0; itr < CONFIG_NUM_OF_SAMPLES; itr++) {
-            retval += Channel[id].output[itr];
-        }
-        retval /= CONFIG_NUM_OF_SAMPLES;
-
-        return (retval);
+        return (Channel[id].output);
     } else {
 
         return (0);
     }
 }
 
+/*
+ * The comparator is one-shot: it is disarmed by the ISR just before the
+ * handler is called. The handler runs in interrupt context and receives the
+ * channel id and the averaged value together with the timestamp of the sample
+ * which crossed the threshold, so one handler may serve several channels.
+ */
+void adcArmComparator(uint32_t id, int32_t threshold, enum adcCompareType type,
+    void (* handler)(uint32_t, int32_t, uint32_t)) {
+    id &= CHANNEL_ID_MASK;
+    IEC0CLR = IEC0_AD1IE;
+    Channel[id].threshold   = threshold;
+    Channel[id].compareType = type;
+    Channel[id].compare     = handler;
+
+    if (adcEnabledChannels != 0u) {
+        IEC0SET = IEC0_AD1IE;
+    }
+}
+
+bool adcSetFilter(uint32_t id, const struct adcFilter * filter) {
+    id &= CHANNEL_ID_MASK;
+
+    if ((filter->windowShift > CONFIG_MAX_WINDOW_SHIFT) ||
+        (filter->extraBits   > filter->windowShift)) {
+
+        return (false);
+    }
+    IEC0CLR = IEC0_AD1IE;
+    memset(&Channel[id].window, 0, sizeof(Channel[id].window));
+    Channel[id].history[0]  = 0;
+    Channel[id].history[1]  = 0;
+    Channel[id].windowIndex = 0u;
+    Channel[id].sum         = 0;
+    Channel[id].iir         = 0;
+    Channel[id].isPrimed    = false;
+    Channel[id].filter      = *filter;
+
+    if (adcEnabledChannels != 0u) {
+        IEC0SET = IEC0_AD1IE;
+    }
+
+    return (true);
+}
+
+void adcDisarmComparator(uint32_t id) {
+    id &= CHANNEL_ID_MASK;
+    Channel[id].compare = NULL;
+}
+
+uint32_t adcGetTimestamp(void) {
+
+    return (adcTimestamp);
+}
+
+/*
+ * Timestamps count conversions. Timer3 starts one conversion every
+ * 1/CONFIG_ADC_FREQUENCY s and the scan visits the enabled channels in turn,
+ * so a channel gets a new sample once per adcNumOfEnabledChannels counts.
+ */
+uint32_t adcTimestampToMs(uint32_t timestamp) {
+
+    return ((timestamp * 1000u) / CONFIG_ADC_FREQUENCY);
+}
+
+/*
+ * Time taken by nSamples samples of one channel with the current scan.
+ */
+uint32_t adcSamplesToMs(uint32_t nSamples) {
+
+    return (adcTimestampToMs(nSamples * adcNumOfEnabledChannels));
+}
+
+uint32_t adcGetIsrCycles(void) {
+
+    return (adcIsrCycles);
+}
+
+void adcCaptureInit(struct adcCapture * capture, struct adcSample * buffer, uint32_t size) {
+    capture->buffer          = buffer;
+    capture->size            = size;
+    capture->head            = 0u;
+    capture->tail            = 0u;
+    capture->decimation      = 1u;
+    capture->decimationCount = 0u;
+    capture->overflows       = 0u;
+}
+
+void adcCaptureSetDecimation(struct adcCapture * capture, uint32_t decimation) {
+    capture->decimation = (decimation != 0u ? decimation : 1u);
+}
+
+uint32_t adcCaptureRead(struct adcCapture * capture, struct adcSample * samples, uint32_t count) {
+    uint32_t            tail;
+    uint32_t            available;
+    uint32_t            cnt;
+
+    tail      = capture->tail;
+    available = capture->head - tail;
+    __asm__ volatile("" ::: "memory");                                          /* Slots are read after head                                */
+
+    if (count > available) {
+        count = available;
+    }
+
+    for (cnt = 0u; cnt < count; cnt++) {
+        samples[cnt] = capture->buffer[(tail + cnt) & (capture->size - 1u)];
+    }
+    __asm__ volatile("" ::: "memory");                                          /* Slots are read before they are released                  */
+    capture->tail = tail + count;
+
+    return (count);
+}
+
+void adcStartCapture(uint32_t id, struct adcCapture * capture) {
+    id &= CHANNEL_ID_MASK;
+    Channel[id].capture = capture;
+}
+
+void adcStopCapture(uint32_t id) {
+    id &= CHANNEL_ID_MASK;
+    Channel[id].capture = NULL;
+}
+
 void __ISR(_ADC_VECTOR) adcHandler(void) {
     int32_t             value;
-    uint32_t            cnt;
-    uint32_t            id;
+    uint32_t            slot;
+    uint32_t            cycles;
+
+    cycles = _CP0_GET_COUNT();
 
-    id = 0u;
+    for (slot = 0u; slot < adcNumOfEnabledChannels; slot++) {
+        struct adcChannel * channel;
 
-    for (cnt = 0; cnt < 16; cnt++) {
-        value = (int32_t)(&ADC1BUF0)[cnt];
+        channel = adcScanTable[slot];
+        value   = filterSample(channel, (int32_t)ADC1BUF(slot));
+        channel->output = value;
+
+        if (channel->capture != NULL) {
+            capturePush(channel->capture, value);
+        }
 
-        while ((adcEnabledChannels & (0x1u << id)) == 0u) {
-            id++;
+        if (channel->callback != NULL) {
+            channel->callback(value);
         }
 
-        if (id < CONFIG_NUM_OF_CHANNELS) {
-            Channel[id].output[adcNumOfSamples] = value;
+        if (channel->compare != NULL) {
 
-            if (Channel[id].callback != NULL) {
-                Channel[id].callback(value);
+            if (((channel->compareType == ADC_COMPARE_BELOW) && (value <= channel->threshold)) ||
+                ((channel->compareType == ADC_COMPARE_ABOVE) && (value >= channel->threshold))) {
+                void     (* compare)(uint32_t, int32_t, uint32_t);
+
+                compare = channel->compare;
+                channel->compare = NULL;
+                compare((uint32_t)(channel - Channel), value, adcTimestamp);
             }
-            id++;
         }
     }
-    adcNumOfSamples++;
+    adcTimestamp += adcNumOfEnabledChannels;                                    /* One interrupt per scan, one conversion per channel       */
+    IFS0CLR = IFS0_AD1IF;
+    cycles = _CP0_GET_COUNT() - cycles;
 
-    if (adcNumOfSamples >= CONFIG_NUM_OF_SAMPLES) {
-        adcNumOfSamples = 0;
+    if (adcIsrCycles < cycles) {
+        adcIsrCycles = cycles;
     }
-    IFS0CLR = IFS0_AD1IF;
 }
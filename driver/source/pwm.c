@@ -0,0 +1,52 @@
+#include <xc.h>
+
+#include "driver/clock.h"
+#include "driver/pwm.h"
+
+/*
+ * Output compare 4 in PWM mode, clocked by Timer2. Timer3 is reserved for the
+ * ADC trigger. The output pin is routed to OC4 by the user of the driver.
+ */
+
+#define OC_CON_OCM_PWM                  (0x6u << 0)
+#define OC_CON_OCTSEL_TMR2              (0x0u << 3)
+#define OC_CON_ON                       (0x1u << 15)
+
+#define T_CON_ON                        (0x1u << 15)
+#define T_CON_TCKPS(x)                  ((x) << 4)
+
+static uint32_t PwmPeriod;
+
+void initPwmDriver(void) {
+    pwmStop();
+}
+
+void pwmStart(uint32_t frequency) {
+    pwmStop();
+    PwmPeriod = clockGetPeripheralClock() / frequency;
+    T2CON     = T_CON_TCKPS(0);
+    TMR2      = 0u;
+    PR2       = PwmPeriod - 1u;
+    OC4R      = 0u;
+    OC4RS     = 0u;
+    OC4CON    = OC_CON_OCM_PWM | OC_CON_OCTSEL_TMR2;
+    OC4CONSET = OC_CON_ON;
+    T2CONSET  = T_CON_ON;
+}
+
+/*
+ * The new duty cycle is latched by hardware at the start of next period, so
+ * this may be called from any context.
+ */
+void pwmSetDuty(uint32_t duty) {
+
+    if (duty > PWM_DUTY_MAX) {
+        duty = PWM_DUTY_MAX;
+    }
+    OC4RS = (duty * PwmPeriod) >> 16;
+}
+
+void pwmStop(void) {
+    OC4CON = 0u;
+    T2CON  = 0u;
+}
@@ -77,6 +77,12 @@ typedef struct {
         ft_uint16_t ft_cmd_fifo_wp; //coprocessor fifo write pointer
         ft_uint16_t ft_dl_buff_wp;  //display command memory write pointer
 
+#ifdef FT_GPU_HAL_PROFILE
+        ft_uint32_t prof_cmd_words;  //words written into coprocessor fifo
+        ft_uint32_t prof_spi_bytes;  //bytes exchanged over SPI bus
+        ft_uint32_t prof_wait_ticks; //CP0 Count ticks spent waiting for fifo space or for it to drain
+#endif
+
 	FT_GPU_HAL_STATUS_E        status;        //OUT
 	ft_void_t*                 hal_handle;        //IN/OUT
 }Ft_Gpu_Hal_Context_t;
@@ -116,6 +122,7 @@ ft_void_t Ft_Gpu_Hal_Updatecmdfifo(Ft_Gpu_Hal_Context_t *host,ft_uint16_t count)
 ft_void_t Ft_Gpu_Hal_WrCmd32(Ft_Gpu_Hal_Context_t *host,ft_uint32_t cmd);
 ft_void_t Ft_Gpu_Hal_WrCmdBuf(Ft_Gpu_Hal_Context_t *host,ft_uint8_t *buffer,ft_uint16_t count);
 ft_void_t Ft_Gpu_Hal_WaitCmdfifo_empty(Ft_Gpu_Hal_Context_t *host);
+ft_bool_t Ft_Gpu_Hal_IsCmdfifo_empty(Ft_Gpu_Hal_Context_t *host);
 ft_void_t Ft_Gpu_Hal_ResetCmdFifo(Ft_Gpu_Hal_Context_t *host);
 ft_void_t Ft_Gpu_Hal_CheckCmdBuffer(Ft_Gpu_Hal_Context_t *host,ft_uint16_t count);
 
@@ -45,6 +45,18 @@
 #define FT800_INT_PIN                   CONFIG_FT800_INT_PIN
 #define FT800_PD_N_PORT                 CONFIG_FT800_PD_N_PORT
 #define FT800_PD_N_PIN                  CONFIG_FT800_PD_N_PIN
+/*
+ * Set CONFIG_GPU_PROFILE to 1, for example with -DCONFIG_GPU_PROFILE=1, to
+ * count fifo words, SPI bytes and wait time per frame. The profile is also
+ * written to GPUPROF.TXT at the end of every USB export, so keep it off in
+ * production builds.
+ */
+#if !defined(CONFIG_GPU_PROFILE)
+#define CONFIG_GPU_PROFILE              0
+#endif
+#if (CONFIG_GPU_PROFILE == 1)
+#define FT_GPU_HAL_PROFILE
+#endif
 #endif
 
 #include "FT_DataTypes.h"
@@ -2,6 +2,16 @@
 #include "USB/usb_hal_pic32.h"
 #include "driver/gpio.h"
 
+#ifdef FT_GPU_HAL_PROFILE
+#include <xc.h>
+
+#define HAL_PROFILE_ADD(host, field, value)     (host)->field += (value)
+#define HAL_PROFILE_TICKS()                     _CP0_GET_COUNT()
+#else
+#define HAL_PROFILE_ADD(host, field, value)     (void)0
+#define HAL_PROFILE_TICKS()                     0u
+#endif
+
 /* API to initialize the SPI interface */
 ft_bool_t  Ft_Gpu_Hal_Init(Ft_Gpu_HalInit_t *halinit)
 {
@@ -82,6 +92,9 @@ ft_bool_t    Ft_Gpu_Hal_Open(Ft_Gpu_Hal_Context_t *host)
     spiOpen((struct spiHandle *)host->hal_handle, &spiConfig);
 #endif
 	host->ft_cmd_fifo_wp = host->ft_dl_buff_wp = 0;
+#ifdef FT_GPU_HAL_PROFILE
+	host->prof_cmd_words = host->prof_spi_bytes = host->prof_wait_ticks = 0;
+#endif
 	host->status = FT_GPU_HAL_OPENED;
 	return (true);
 }
@@ -143,6 +156,7 @@ ft_void_t  Ft_Gpu_Hal_StartTransfer(Ft_Gpu_Hal_Context_t *host,FT_GPU_TRANSFERDI
 		Transfer_Array[3] = 0; //Dummy Read byte
         spiSSActivate((struct spiHandle *)host->hal_handle);
 		spiExchange((struct spiHandle *)host->hal_handle, Transfer_Array, 4);
+        HAL_PROFILE_ADD(host, prof_spi_bytes, 4);
 #endif
 		host->status = FT_GPU_HAL_READING;
 	}else{
@@ -171,6 +185,7 @@ ft_void_t  Ft_Gpu_Hal_StartTransfer(Ft_Gpu_Hal_Context_t *host,FT_GPU_TRANSFERDI
 		Transfer_Array[2] = addr;
         spiSSActivate((struct spiHandle *)host->hal_handle);
 		spiExchange((struct spiHandle *)host->hal_handle, Transfer_Array, 3u);
+        HAL_PROFILE_ADD(host, prof_spi_bytes, 3);
 #endif
 		host->status = FT_GPU_HAL_WRITING;
 	}
@@ -217,6 +232,7 @@ ft_uint8_t    Ft_Gpu_Hal_Transfer8(Ft_Gpu_Hal_Context_t *host,ft_uint8_t value)
 #endif
 #ifdef PIC32_PLATFORM
         spiExchange((struct spiHandle *)host->hal_handle, &value, 1u);
+        HAL_PROFILE_ADD(host, prof_spi_bytes, 1);
 
         return (value);
 #endif
@@ -337,6 +353,7 @@ ft_void_t Ft_Gpu_HostCommand(Ft_Gpu_Hal_Context_t *host,ft_uint8_t cmd)
 
   spiSSActivate((struct spiHandle *)host->hal_handle);
   spiExchange((struct spiHandle *)host->hal_handle, Transfer_Array, 3u);
+  HAL_PROFILE_ADD(host, prof_spi_bytes, 3);
   spiSSDeactivate((struct spiHandle *)host->hal_handle);
 #endif
 }
@@ -382,7 +399,12 @@ ft_void_t Ft_Gpu_Hal_WrCmdBuf(Ft_Gpu_Hal_Context_t *host,ft_uint8_t *buffer,ft_u
 {
 	ft_uint32_t length =0, SizeTransfered = 0;   
 
+#ifdef PIC32_PLATFORM
+/* Let Ft_Gpu_Hal_CheckCmdBuffer() wait for the space instead of draining the whole fifo after each chunk */
+#define MAX_CMD_FIFO_TRANSFER   (FT_CMD_FIFO_SIZE - 4)
+#else
 #define MAX_CMD_FIFO_TRANSFER   Ft_Gpu_Cmdfifo_Freespace(host)  
+#endif
 	do {                
 		length = count;
 		if (length > MAX_CMD_FIFO_TRANSFER){
@@ -421,8 +443,11 @@ ft_void_t Ft_Gpu_Hal_WrCmdBuf(Ft_Gpu_Hal_Context_t *host,ft_uint8_t *buffer,ft_u
 #endif
 		Ft_Gpu_Hal_EndTransfer(host);
 		Ft_Gpu_Hal_Updatecmdfifo(host,length);
+		HAL_PROFILE_ADD(host, prof_cmd_words, (length + 3) >> 2);
 
+#ifndef PIC32_PLATFORM
 		Ft_Gpu_Hal_WaitCmdfifo_empty(host);
+#endif
 
 		count -= length;
 	}while (count > 0);
@@ -466,15 +491,30 @@ ft_void_t Ft_Gpu_Hal_WrCmdBufFromFlash(Ft_Gpu_Hal_Context_t *host,FT_PROGMEM ft_
 ft_void_t Ft_Gpu_Hal_CheckCmdBuffer(Ft_Gpu_Hal_Context_t *host,ft_uint16_t count)
 {
    ft_uint16_t getfreespace;
+#ifdef FT_GPU_HAL_PROFILE
+   ft_uint32_t begin = HAL_PROFILE_TICKS();
+#endif
+
    do{
         getfreespace = Ft_Gpu_Cmdfifo_Freespace(host);
    }while(getfreespace < count);
+   HAL_PROFILE_ADD(host, prof_wait_ticks, HAL_PROFILE_TICKS() - begin);
 }
 ft_void_t Ft_Gpu_Hal_WaitCmdfifo_empty(Ft_Gpu_Hal_Context_t *host)
 {
+#ifdef FT_GPU_HAL_PROFILE
+   ft_uint32_t begin = HAL_PROFILE_TICKS();
+#endif
+
    while(Ft_Gpu_Hal_Rd16(host,REG_CMD_READ) != Ft_Gpu_Hal_Rd16(host,REG_CMD_WRITE));
    
    host->ft_cmd_fifo_wp = Ft_Gpu_Hal_Rd16(host,REG_CMD_WRITE);
+   HAL_PROFILE_ADD(host, prof_wait_ticks, HAL_PROFILE_TICKS() - begin);
+}
+
+ft_bool_t Ft_Gpu_Hal_IsCmdfifo_empty(Ft_Gpu_Hal_Context_t *host)
+{
+   return (Ft_Gpu_Hal_Rd16(host,REG_CMD_READ) == host->ft_cmd_fifo_wp);
 }
 
 ft_void_t Ft_Gpu_Hal_WaitLogo_Finish(Ft_Gpu_Hal_Context_t *host)
@@ -502,6 +542,7 @@ ft_void_t Ft_Gpu_Hal_WrCmd32(Ft_Gpu_Hal_Context_t *host,ft_uint32_t cmd)
          Ft_Gpu_Hal_Wr32(host,RAM_CMD + host->ft_cmd_fifo_wp,cmd);
       
          Ft_Gpu_Hal_Updatecmdfifo(host,sizeof(cmd));
+         HAL_PROFILE_ADD(host, prof_cmd_words, 1);
 }
 
 
@@ -638,6 +679,7 @@ ft_void_t Ft_Gpu_Hal_RdMem(Ft_Gpu_Hal_Context_t *host,ft_uint32_t addr, ft_uint8
     (void)SizeTransfered;
     
     spiExchange((struct spiHandle *)host->hal_handle, buffer, length);
+    HAL_PROFILE_ADD(host, prof_spi_bytes, length);
 #endif
 
 	Ft_Gpu_Hal_EndTransfer(host);
@@ -13,3 +13,28 @@ uint8_t checksumParity8(const void * buffer, size_t size) {
 
     return ((sum ^ 0xffu) + 1u);
 }
+
+/*
+ * CRC-32 as used by zip and Ethernet, reflected polynomial 0xedb88320. Start
+ * with crc set to zero and pass the previous result to continue over the next
+ * buffer. The table is per nibble to keep it small.
+ */
+uint32_t checksumCrc32(uint32_t crc, const void * buffer, size_t size) {
+    static const uint32_t Table[16] = {
+        0x00000000u, 0x1db71064u, 0x3b6e20c8u, 0x26d930acu,
+        0x76dc4190u, 0x6b6b51f4u, 0x4db26158u, 0x5005713cu,
+        0xedb88320u, 0xf00f9344u, 0xd6d6a3e8u, 0xcb61b38cu,
+        0x9b64c2b0u, 0x86d3d2d4u, 0xa00ae278u, 0xbdbdf21cu
+    };
+    size_t              byte;
+
+    crc = ~crc;
+
+    for (byte = 0u; byte < size; byte++) {
+        crc ^= ((const uint8_t *)buffer)[byte];
+        crc  = (crc >> 4) ^ Table[crc & 0x0fu];
+        crc  = (crc >> 4) ^ Table[crc & 0x0fu];
+    }
+
+    return (~crc);
+}
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 uint8_t checksumParity8(const void * buffer, size_t size);
+uint32_t checksumCrc32(uint32_t crc, const void * buffer, size_t size);
 
 
 #ifdef	__cplusplus
@@ -0,0 +1,111 @@
+
+#include "delta/delta.h"
+
+/*
+ * Samples are stored as differences to the previous sample. Differences are
+ * zig-zag mapped to unsigned numbers and written as little endian base 128
+ * varints, so slowly changing curves take one byte per sample.
+ */
+
+static size_t putVarint(uint32_t value, uint8_t * buffer, size_t size) {
+    size_t              length;
+
+    length = 0u;
+
+    do {
+        if (length == size) {
+
+            return (0u);
+        }
+        buffer[length] = (uint8_t)(value & 0x7fu);
+        value >>= 7;
+
+        if (value != 0u) {
+            buffer[length] |= 0x80u;
+        }
+        length++;
+    } while (value != 0u);
+
+    return (length);
+}
+
+static size_t getVarint(const uint8_t * buffer, size_t size, uint32_t * value) {
+    size_t              length;
+    uint32_t            shift;
+
+    *value = 0u;
+    shift  = 0u;
+
+    for (length = 0u; (length < size) && (shift < 32u); length++) {
+        *value |= (uint32_t)(buffer[length] & 0x7fu) << shift;
+        shift  += 7u;
+
+        if ((buffer[length] & 0x80u) == 0u) {
+
+            return (length + 1u);
+        }
+    }
+
+    return (0u);
+}
+
+/*
+ * Returns the number of bytes written, or zero when the encoded samples do not
+ * fit into the buffer.
+ */
+size_t deltaEncode(const uint16_t * samples, size_t nSamples, uint8_t * buffer, size_t size) {
+    size_t              length;
+    size_t              cnt;
+    int32_t             previous;
+
+    length   = 0u;
+    previous = 0;
+
+    for (cnt = 0u; cnt < nSamples; cnt++) {
+        int32_t         delta;
+        uint32_t        zigzag;
+        size_t          written;
+
+        delta    = (int32_t)samples[cnt] - previous;
+        previous = (int32_t)samples[cnt];
+        zigzag   = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        written  = putVarint(zigzag, &buffer[length], size - length);
+
+        if (written == 0u) {
+
+            return (0u);
+        }
+        length += written;
+    }
+
+    return (length);
+}
+
+/*
+ * Returns the number of decoded samples. Decoding stops at the end of the
+ * buffer, after nSamples samples or at the first malformed varint.
+ */
+size_t deltaDecode(const uint8_t * buffer, size_t size, uint16_t * samples, size_t nSamples) {
+    size_t              length;
+    size_t              cnt;
+    int32_t             previous;
+
+    length   = 0u;
+    previous = 0;
+
+    for (cnt = 0u; (cnt < nSamples) && (length < size); cnt++) {
+        uint32_t        zigzag;
+        size_t          read;
+
+        read = getVarint(&buffer[length], size - length, &zigzag);
+
+        if (read == 0u) {
+            break;
+        }
+        length   += read;
+        previous += (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 0x1u);
+        samples[cnt] = (uint16_t)previous;
+    }
+
+    return (cnt);
+}
@@ -0,0 +1,19 @@
+#ifndef DELTA_H
+#define	DELTA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+size_t deltaEncode(const uint16_t * samples, size_t nSamples, uint8_t * buffer, size_t size);
+size_t deltaDecode(const uint8_t * buffer, size_t size, uint16_t * samples, size_t nSamples);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* DELTA_H */
+
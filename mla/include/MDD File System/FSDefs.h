@@ -438,6 +438,9 @@ typedef struct {
 // Description: A macro for the boot sector start cluster of root directory value offset
 #define  BSI_ROOTCLUS      44
 
+// Description: A macro for the boot sector FSInfo sector number value offset
+#define  BSI_FSINFO        48
+
 // Description: A macro for the FAT32 boot sector boot signature offset
 #define  BSI_FAT32_BOOTSIG 66
 
@@ -158,15 +158,16 @@
 
 
 // Summary:  Indicates flag conditions for a file object
-// Description: The FILEFLAGS structure is used to indicate conditions in a file.  It contains three flags: 'write' indicates
+// Description: The FILEFLAGS structure is used to indicate conditions in a file.  It contains four flags: 'write' indicates
 //              that the file was opened in a mode that allows writes, 'read' indicates that the file was opened in a mode
-//              that allows reads, and 'FileWriteEOF' indicates that additional data that is written to the file will increase
-//              the file size.
+//              that allows reads, 'FileWriteEOF' indicates that additional data that is written to the file will increase
+//              the file size, and 'Preallocated' indicates that clusters past the end of the file were reserved by FSfpreallocate.
 typedef struct
 {
     unsigned    write :1;           // Indicates a file was opened in a mode that allows writes
     unsigned    read :1;            // Indicates a file was opened in a mode that allows reads
     unsigned    FileWriteEOF :1;    // Indicates the current position in a file is at the end of the file
+    unsigned    Preallocated :1;    // Indicates the file's cluster chain may extend past the end of the file
 }FILEFLAGS;
 
 
@@ -1042,6 +1043,35 @@ int wFSremove (const unsigned short int * fileName);
 
 size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream);
 
+/*********************************************************************************
+  Function:
+    int FSfpreallocate(FSFILE *fo, DWORD size)
+  Summary:
+    Reserve clusters for data that will be written to a file
+  Conditions:
+    File opened in FS_WRITE, FS_APPEND, FS_WRITE+, FS_APPEND+, FS_READ+ mode
+  Input:
+    fo -    Pointer to file structure
+    size -  Number of bytes that will be written from the current position
+  Return Values:
+    0 -   The clusters were reserved
+    EOF - Not all clusters could be reserved
+  Side Effects:
+    The FSerrno variable will be changed.
+  Description:
+    The FSfpreallocate function extends the cluster chain of a file so that
+    'size' more bytes from the current position fit without allocating.  The
+    clusters are taken in one pass, next to each other wherever the FAT allows,
+    and their FAT entries are written through the FAT sector cache.  FSfwrite
+    follows the reserved chain instead of searching for empty clusters.  When
+    the file is closed, reserved clusters past the end of the file are freed
+    again, so an estimate that is too large costs no space.
+  Remarks:
+    Clusters reserved before an error stay with the file until it is closed.
+  *********************************************************************************/
+
+int FSfpreallocate(FSFILE *fo, DWORD size);
+
 #endif
 
 #ifdef ALLOW_DIRS
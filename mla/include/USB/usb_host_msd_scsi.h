@@ -250,6 +250,38 @@ BYTE    USBHostMSDSCSIMediaReset( void  );
 BYTE    USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer );
 
 
+/****************************************************************************
+  Function:
+    BYTE USBHostMSDSCSISectorsRead( DWORD sectorAddress, WORD sectorCount,
+                BYTE *dataBuffer )
+
+  Summary:
+    This function reads consecutive sectors.
+
+  Description:
+    This function uses a single SCSI command READ10 to read sectorCount
+    consecutive sectors starting at sectorAddress.  The data is stored in the
+    application buffer which must hold sectorCount sectors.
+
+  Precondition:
+    None
+
+  Parameters:
+    DWORD   sectorAddress   - address of the first sector to read
+    WORD    sectorCount     - number of sectors to read
+    BYTE    *dataBuffer     - buffer to store data
+
+  Return Values:
+    TRUE    - read performed successfully
+    FALSE   - read was not successful
+
+  Remarks:
+    None
+  ***************************************************************************/
+
+BYTE    USBHostMSDSCSISectorsRead( DWORD sectorAddress, WORD sectorCount, BYTE *dataBuffer );
+
+
 /****************************************************************************
   Function:
     BYTE USBHostMSDSCSISectorWrite( DWORD sectorAddress, BYTE *dataBuffer, BYTE allowWriteToZero )
@@ -297,6 +329,39 @@ BYTE    USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer );
 BYTE    USBHostMSDSCSISectorWrite( DWORD sectorAddress, BYTE *dataBuffer, BYTE allowWriteToZero);
 
 
+/****************************************************************************
+  Function:
+    BYTE USBHostMSDSCSISectorsWrite( DWORD sectorAddress, WORD sectorCount,
+                BYTE *dataBuffer, BYTE allowWriteToZero )
+
+  Summary:
+    This function writes consecutive sectors.
+
+  Description:
+    This function uses a single SCSI command WRITE10 to write sectorCount
+    consecutive sectors starting at sectorAddress.  The data is read from the
+    application buffer which must hold sectorCount sectors.
+
+  Precondition:
+    None
+
+  Parameters:
+    DWORD   sectorAddress   - address of the first sector to write
+    WORD    sectorCount     - number of sectors to write
+    BYTE    *dataBuffer     - buffer with application data
+    BYTE    allowWriteToZero- If a write to sector 0 is allowed.
+
+  Return Values:
+    TRUE    - write performed successfully
+    FALSE   - write was not successful
+
+  Remarks:
+    To follow convention, this function blocks until the write is complete.
+  ***************************************************************************/
+
+BYTE    USBHostMSDSCSISectorsWrite( DWORD sectorAddress, WORD sectorCount, BYTE *dataBuffer, BYTE allowWriteToZero );
+
+
 /****************************************************************************
   Function:
     BYTE USBHostMSDSCSIWriteProtectState( void )
@@ -171,7 +171,16 @@ WORD    gTimeWrtTime;   // Global time variable (for timestamps) used to indicat
 WORD    gTimeWrtDate;   // Global time variable (for timestamps) used to indicate last update date
 #endif
 
-DWORD       gLastFATSectorRead = 0xFFFFFFFF;    // Global variable indicating which FAT sector was read last
+// The FAT buffer of the PIC18 sits at a fixed address and holds one sector
+#if !defined(FS_FAT_CACHE_SECTORS) || defined(__18CXX)
+    #undef  FS_FAT_CACHE_SECTORS
+    #define FS_FAT_CACHE_SECTORS    1
+#endif
+
+DWORD       gFATCacheSector[FS_FAT_CACHE_SECTORS];  // Global variable indicating which FAT sector is held in each slot of gFATBuffer
+DWORD       gFATCacheUsed[FS_FAT_CACHE_SECTORS];    // Global variable indicating when each slot of gFATBuffer was used last (0 for an empty slot)
+DWORD       gFATCacheTick = 0;                  // Global variable counting FAT cache accesses, used to find the least recently used slot
+BYTE        gFATCacheDirty[FS_FAT_CACHE_SECTORS];   // Global variable indicating which slots of gFATBuffer were changed and not written yet
 BYTE        gNeedFATWrite = FALSE;              // Global variable indicating that there is information that needs to be written to the FAT
 FSFILE  *   gBufferOwner = NULL;                // Global variable indicating which file is using the data buffer
 DWORD       gLastDataSectorRead = 0xFFFFFFFF;   // Global variable indicating which data sector was read last
@@ -197,17 +206,24 @@ FSFILE * cwdptr = &cwd;     // Pointer to the current working directory
     #pragma udata dataBuffer = DATA_BUFFER_ADDRESS
     BYTE gDataBuffer[MEDIA_SECTOR_SIZE];    // The global data sector buffer
     #pragma udata FATBuffer = FAT_BUFFER_ADDRESS
-    BYTE gFATBuffer[MEDIA_SECTOR_SIZE];     // The global FAT sector buffer
+    BYTE gFATBuffer[FS_FAT_CACHE_SECTORS][MEDIA_SECTOR_SIZE];   // The global FAT sector buffer
     #pragma udata
 #endif
 
 #if defined (__C30__) || defined (__PIC32MX__)
     BYTE __attribute__ ((aligned(4)))   gDataBuffer[MEDIA_SECTOR_SIZE];     // The global data sector buffer
-    BYTE __attribute__ ((aligned(4)))   gFATBuffer[MEDIA_SECTOR_SIZE];      // The global FAT sector buffer
+    BYTE __attribute__ ((aligned(4)))   gFATBuffer[FS_FAT_CACHE_SECTORS][MEDIA_SECTOR_SIZE];    // The global FAT sector cache
 #endif
 
 DISK gDiskData;         // Global structure containing device information.
 
+#ifdef ALLOW_WRITES
+DWORD   gNextFreeCluster = 0;               // Global variable containing the cluster where the search for an empty cluster starts (0 if unknown)
+DWORD   gFreeClusterCount = 0xFFFFFFFF;     // Global variable containing the number of free clusters (FSI_UNKNOWN if unknown)
+DWORD   gFSInfoSector = 0;                  // Global variable containing the LBA of the FAT32 FSInfo sector (0 if the volume has none)
+BYTE    gFSInfoChanged = FALSE;             // Global variable indicating that the free cluster information changed since it was read or written
+#endif
+
 /* Global Variables to handle ASCII & UTF16 file operations */
 char *asciiFilename;
 unsigned short int fileNameLength;
@@ -216,6 +232,110 @@ unsigned short int fileNameLength;
 	BOOL	utfModeFileName = FALSE;
 	BOOL	twoByteMode = FALSE;
 #endif
+
+#if defined(ALLOW_WRITES) && defined(FS_MULTI_SECTOR_COUNT) && defined(MDD_SectorsWrite)
+    #define FS_MULTI_SECTOR_WRITE
+#endif
+
+#ifdef FS_MULTI_SECTOR_WRITE
+/************************************************************************/
+/*                       Multi-sector write buffer                      */
+/************************************************************************/
+
+// Data sectors flushed from gDataBuffer are collected here while they are
+// consecutive and written out with one MDD_SectorsWrite call. Every other
+// sector access goes through the wrappers below, which write the collected
+// sectors first, so the media sees the writes in the same order as before.
+
+BYTE __attribute__ ((aligned(4)))   gMultiBuffer[FS_MULTI_SECTOR_COUNT * MEDIA_SECTOR_SIZE];   // Collected data sectors
+DWORD   gMultiFirstSector;          // Global variable containing the first sector held in gMultiBuffer
+WORD    gMultiCount = 0;            // Global variable containing the number of sectors held in gMultiBuffer
+
+/******************************************************************************
+ * Function:        BYTE MultiSectorFlush (void)
+ *
+ * Output:          TRUE - The collected sectors were written or there were none
+ *                  FALSE - The write failed
+ *
+ * Overview:        Writes the collected sectors with one command. The buffer
+ *                  is emptied even when the write fails.
+ *****************************************************************************/
+
+static BYTE MultiSectorFlush (void)
+{
+    BYTE    result = TRUE;
+
+    if (gMultiCount != 0)
+    {
+        result = MDD_SectorsWrite (gMultiFirstSector, gMultiCount, gMultiBuffer, FALSE);
+        gMultiCount = 0;
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * Function:        BYTE MultiSectorStage (DWORD sector, BYTE * buffer)
+ *
+ * Output:          TRUE - The sector was collected
+ *                  FALSE - Writing out the previous sectors failed
+ *
+ * Overview:        Adds a data sector to gMultiBuffer. A sector that is
+ *                  already held is replaced, a sector that does not continue
+ *                  the held run writes the run out first.
+ *****************************************************************************/
+
+static BYTE MultiSectorStage (DWORD sector, BYTE * buffer)
+{
+    if ((gMultiCount != 0) && (sector >= gMultiFirstSector) && (sector < (gMultiFirstSector + gMultiCount)))
+    {
+        memcpy (&gMultiBuffer[(sector - gMultiFirstSector) * MEDIA_SECTOR_SIZE], buffer, MEDIA_SECTOR_SIZE);
+
+        return TRUE;
+    }
+
+    if ((gMultiCount == FS_MULTI_SECTOR_COUNT) || ((gMultiCount != 0) && (sector != (gMultiFirstSector + gMultiCount))))
+    {
+        if (MultiSectorFlush() != TRUE)
+            return FALSE;
+    }
+
+    if (gMultiCount == 0)
+        gMultiFirstSector = sector;
+
+    memcpy (&gMultiBuffer[gMultiCount * MEDIA_SECTOR_SIZE], buffer, MEDIA_SECTOR_SIZE);
+    gMultiCount++;
+
+    return TRUE;
+}
+
+static BYTE MultiSectorRead (DWORD sector, BYTE * buffer)
+{
+    if ((gMultiCount != 0) && (sector >= gMultiFirstSector) && (sector < (gMultiFirstSector + gMultiCount)))
+    {
+        memcpy (buffer, &gMultiBuffer[(sector - gMultiFirstSector) * MEDIA_SECTOR_SIZE], MEDIA_SECTOR_SIZE);
+
+        return TRUE;
+    }
+
+    return MDD_SectorRead (sector, buffer);
+}
+
+static BYTE MultiSectorWrite (DWORD sector, BYTE * buffer, BYTE allowWriteToZero)
+{
+    if (MultiSectorFlush() != TRUE)
+        return FALSE;
+
+    return MDD_SectorWrite (sector, buffer, allowWriteToZero);
+}
+
+// From here on all sector accesses of the file system see the collected sectors
+#undef  MDD_SectorRead
+#undef  MDD_SectorWrite
+#define MDD_SectorRead      MultiSectorRead
+#define MDD_SectorWrite     MultiSectorWrite
+#endif
+
 /************************************************************************/
 /*                        Structures and defines                        */
 /************************************************************************/
@@ -244,6 +364,17 @@ typedef _DIRENTRY * DIRENTRY;                   // A pointer to a directory entr
 
 #define DIRENTRIES_PER_SECTOR   (MEDIA_SECTOR_SIZE / 32)        // The number of directory entries in a sector
 
+// FAT32 FSInfo sector
+#define FSI_LEADSIG             0               // Offset of the lead signature
+#define FSI_STRUCSIG            484             // Offset of the structure signature
+#define FSI_FREE_COUNT          488             // Offset of the free cluster count
+#define FSI_NXT_FREE            492             // Offset of the next free cluster hint
+#define FSI_TRAILSIG            508             // Offset of the trail signature
+#define FSI_LEADSIG_VALUE       0x41615252
+#define FSI_STRUCSIG_VALUE      0x61417272
+#define FSI_TRAILSIG_VALUE      0xAA550000
+#define FSI_UNKNOWN             0xFFFFFFFF      // Value of a count or hint that is not known
+
 // Maximum number of UTF16 words in single Root directory entry
 #define MAX_UTF16_CHARS_IN_LFN_ENTRY      (BYTE)13
 
@@ -315,6 +446,8 @@ typedef FSFILE   * FILEOBJ;         // Pointer to an FSFILE object
 /************************************************************************************/
 
 DWORD ReadFAT (DISK *dsk, DWORD ccls);
+void FATCacheInvalidate (void);
+BYTE * FATCacheLoad (DISK *dsk, DWORD sector, BYTE forWrite);
 DIRENTRY Cache_File_Entry( FILEOBJ fo, WORD * curEntry, BYTE ForceRead);
 BYTE Fill_File_Object(FILEOBJ fo, WORD *fHandle);
 DWORD Cluster2Sector(DISK * disk, DWORD cluster);
@@ -355,7 +488,13 @@ BYTE Fill_LFN_Object(FILEOBJ fo, LFN_ENTRY *lfno, WORD *fHandle);
     BYTE EraseCluster(DISK *disk, DWORD cluster);
     CETYPE CreateFirstCluster(FILEOBJ fo);
     DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite);
+    BYTE FATCacheFlush (DISK *dsk);
+#ifdef SUPPORT_FAT32
+    void LoadFSInfo (DISK *dsk);
+    BYTE WriteFSInfo (DISK *dsk);
+#endif
     CETYPE CreateFileEntry(FILEOBJ fo, WORD *fHandle, BYTE mode, BOOL createFirstCluster);
+    BYTE FILEfree_preallocated (FILEOBJ fo);
 #endif
 
 // Directory functions
@@ -434,9 +573,11 @@ int FSInit(void)
 #endif
 
     gBufferZeroed = FALSE;
-    gNeedFATWrite = FALSE;             
-    gLastFATSectorRead = 0xFFFFFFFF;       
+    FATCacheInvalidate();
     gLastDataSectorRead = 0xFFFFFFFF;  
+#ifdef FS_MULTI_SECTOR_WRITE
+    gMultiCount = 0;
+#endif
 
     MDD_InitIO();
 
@@ -1419,6 +1560,7 @@ CETYPE FILEopen (FILEOBJ fo, WORD *fHandle, char type)
             } // -- found
 
             fo->flags.FileWriteEOF = FALSE;
+            fo->flags.Preallocated = FALSE;
             // Set flag for operation type
 #ifdef ALLOW_WRITES
             if ((type == 'w') || (type == 'a'))
@@ -1561,6 +1703,12 @@ BYTE DISKmount( DISK *dsk)
 
     dsk->mount = FALSE; // default invalid
     dsk->buffer = gDataBuffer;    // assign buffer
+#ifdef ALLOW_WRITES
+    gNextFreeCluster = 0;
+    gFreeClusterCount = FSI_UNKNOWN;
+    gFSInfoSector = 0;
+    gFSInfoChanged = FALSE;
+#endif
 
     // Initialize the device
     mediaInformation = MDD_MediaInitialize();
@@ -1589,7 +1737,12 @@ BYTE DISKmount( DISK *dsk)
         {
             // Now the boot sector
             if((error = LoadBootSector(dsk)) == CE_GOOD)
+            {
                 dsk->mount = TRUE; // Mark that the DISK mounted successfully
+#if defined(SUPPORT_FAT32) && defined(ALLOW_WRITES)
+                LoadFSInfo(dsk);
+#endif
+            }
         }
     } // -- Load file parameters
 
@@ -1925,6 +2078,18 @@ BYTE LoadBootSector(DISK *dsk)
                             #else
                                 FatRootDirClusterValue = ReadDWord( dsk->buffer, BSI_ROOTCLUS );
                             #endif
+                            #ifdef ALLOW_WRITES
+                                // 0 and 0xFFFF mean that there is no FSInfo sector
+                                #ifdef __18CXX
+                                    gFSInfoSector = BSec->FAT.FAT_32.BootSec_FSInfo;
+                                #else
+                                    gFSInfoSector = ReadWord( dsk->buffer, BSI_FSINFO );
+                                #endif
+                                if ((gFSInfoSector == 0) || (gFSInfoSector == 0xFFFF))
+                                    gFSInfoSector = 0;
+                                else
+                                    gFSInfoSector += dsk->firsts;
+                            #endif
                             dsk->data = dsk->root + RootDirSectors;
                         }
                         else
@@ -2252,8 +2417,7 @@ int FSformat (char mode, long int serialNumber, char * volumeID)
     FSerrno = CE_GOOD;
 
     gBufferZeroed = FALSE;
-    gNeedFATWrite = FALSE;             
-    gLastFATSectorRead = 0xFFFFFFFF;       
+    FATCacheInvalidate();
     gLastDataSectorRead = 0xFFFFFFFF;  
 
     disk->buffer = gDataBuffer;
@@ -3014,6 +3178,12 @@ BYTE FAT_erase_cluster_chain (DWORD cluster, DISK * dsk)
                     // Now erase this FAT entry
                     if(WriteFAT(dsk, cluster, CLUSTER_EMPTY, FALSE) == ClusterFailValue)
                         status = Fail;
+                    else
+                    {
+                        if ((gFreeClusterCount != FSI_UNKNOWN) && (gFreeClusterCount < dsk->maxcls))
+                            gFreeClusterCount++;
+                        gFSInfoChanged = TRUE;
+                    }
 
                     // now update what the current cluster is
                     cluster = c;
@@ -4228,6 +4398,11 @@ DWORD FATfindEmptyCluster(FILEOBJ fo)
             break;
     }
 
+    // A file without a cluster starts where the last search stopped,
+    // a file that has one starts at its own to stay contiguous
+    if ((c < 2) && (gNextFreeCluster >= 2) && (gNextFreeCluster < (disk->maxcls+2)))
+        c = gNextFreeCluster;
+
     // just in case
     if(c < 2)
         c = 2;
@@ -4262,11 +4437,138 @@ DWORD FATfindEmptyCluster(FILEOBJ fo)
         }
     }  // scanning for an empty cluster
 
+    // The caller takes the cluster, the next search starts after it
+    if (c != 0)
+    {
+        gNextFreeCluster = c + 1;
+        if (gNextFreeCluster >= (disk->maxcls+2))
+            gNextFreeCluster = 2;
+        if ((gFreeClusterCount != FSI_UNKNOWN) && (gFreeClusterCount != 0))
+            gFreeClusterCount--;
+        gFSInfoChanged = TRUE;
+    }
+
     return(c);
 }
 #endif
 
 
+#if defined(ALLOW_WRITES) && defined(SUPPORT_FAT32)
+/***********************************************
+  Function:
+    void LoadFSInfo (DISK *dsk)
+  Summary:
+    Load the free cluster information of a FAT32 volume
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    dsk -  The mounted disk structure
+  Return:
+    None
+  Side Effects:
+    The data buffer is overwritten.
+  Description:
+    Reads the FSInfo sector of a FAT32 volume and
+    takes the free cluster count and the next free
+    cluster hint from it. Values outside of the
+    volume are ignored. A volume without a valid
+    FSInfo sector keeps both unknown, the first
+    search for an empty cluster then scans the FAT
+    and later searches continue from there.
+  Remarks:
+    The values are hints, a wrong value only makes
+    the search for an empty cluster slower.
+  ***********************************************/
+
+void LoadFSInfo (DISK *dsk)
+{
+    DWORD count, next;
+
+    if ((dsk->type != FAT32) || (gFSInfoSector == 0))
+        return;
+
+    gLastDataSectorRead = 0xFFFFFFFF;
+    gBufferZeroed = FALSE;
+
+    if (MDD_SectorRead (gFSInfoSector, dsk->buffer) != TRUE)
+    {
+        gFSInfoSector = 0;
+        return;
+    }
+
+    if ((RAMreadD (dsk->buffer, FSI_LEADSIG) != FSI_LEADSIG_VALUE) ||
+        (RAMreadD (dsk->buffer, FSI_STRUCSIG) != FSI_STRUCSIG_VALUE))
+    {
+        gFSInfoSector = 0;
+        return;
+    }
+
+    count = RAMreadD (dsk->buffer, FSI_FREE_COUNT);
+    next = RAMreadD (dsk->buffer, FSI_NXT_FREE);
+
+    if (count <= dsk->maxcls)
+        gFreeClusterCount = count;
+    if ((next >= 2) && (next < (dsk->maxcls+2)))
+        gNextFreeCluster = next;
+}
+
+
+/***********************************************
+  Function:
+    BYTE WriteFSInfo (DISK *dsk)
+  Summary:
+    Store the free cluster information of a FAT32 volume
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    dsk -  The mounted disk structure
+  Return Values:
+    TRUE -  The FSInfo sector was written or there is none
+    FALSE - The FSInfo sector could not be written
+  Side Effects:
+    The data buffer is overwritten.
+  Description:
+    Builds a new FSInfo sector from the free cluster
+    count and the next free cluster hint and writes
+    it. All other fields of the sector are reserved
+    and zero, so the old sector is not read first.
+  Remarks:
+    None.
+  ***********************************************/
+
+BYTE WriteFSInfo (DISK *dsk)
+{
+    WORD i;
+
+    if ((dsk->type != FAT32) || (gFSInfoSector == 0))
+    {
+        gFSInfoChanged = FALSE;
+        return TRUE;
+    }
+
+    gLastDataSectorRead = 0xFFFFFFFF;
+    gBufferZeroed = FALSE;
+    memset (dsk->buffer, 0x00, dsk->sectorSize);
+
+    for (i = 0; i < 4; i++)
+    {
+        RAMwrite (dsk->buffer, FSI_LEADSIG + i, (BYTE)(FSI_LEADSIG_VALUE >> (i * 8)));
+        RAMwrite (dsk->buffer, FSI_STRUCSIG + i, (BYTE)(FSI_STRUCSIG_VALUE >> (i * 8)));
+        RAMwrite (dsk->buffer, FSI_FREE_COUNT + i, (BYTE)(gFreeClusterCount >> (i * 8)));
+        RAMwrite (dsk->buffer, FSI_NXT_FREE + i, (BYTE)((gNextFreeCluster < 2 ? FSI_UNKNOWN : gNextFreeCluster) >> (i * 8)));
+        RAMwrite (dsk->buffer, FSI_TRAILSIG + i, (BYTE)(FSI_TRAILSIG_VALUE >> (i * 8)));
+    }
+
+    if (MDD_SectorWrite (gFSInfoSector, dsk->buffer, FALSE) != TRUE)
+        return FALSE;
+
+    gFSInfoChanged = FALSE;
+
+    return TRUE;
+}
+#endif
+
+
 /*********************************************************************************
   Function:
     void FSGetDiskProperties(FS_DISK_PROPERTIES* properties)
@@ -4519,13 +4821,24 @@ int FSfclose(FSFILE   *fo)
             }
         }
 
+        // Give back what FSfpreallocate reserved and the file did not use
+        if (fo->flags.Preallocated)
+        {
+            fo->flags.Preallocated = FALSE;
+            if (!FILEfree_preallocated (fo))
+            {
+                FSerrno = CE_WRITE_ERROR;
+                return EOF;
+            }
+        }
+
         // Write the current FAT sector to the disk
         WriteFAT (fo->dsk, 0, 0, TRUE);
 
-        // Invalidate the currently cached FAT entry so that the next read will
+        // Invalidate the cached FAT sectors so that the next read will
         //   result in an acutal read from the physical media instead of a read
         //   from the RAM cache.
-        gLastFATSectorRead = 0;
+        FATCacheInvalidate();
 
         // Read the FAT entry from the physical media.  This is required because
         //   some physical media cache the entries in RAM and only write them 
@@ -4573,6 +4886,24 @@ int FSfclose(FSFILE   *fo)
             error = EOF;
         }
 
+#ifdef SUPPORT_FAT32
+        // Keep the free cluster information on the media up to date
+        if (gFSInfoChanged && !WriteFSInfo (fo->dsk))
+        {
+            FSerrno = CE_WRITE_ERROR;
+            error = EOF;
+        }
+#endif
+
+#ifdef FS_MULTI_SECTOR_WRITE
+        // Nothing of this file may stay behind in the multi-sector buffer
+        if (MultiSectorFlush() != TRUE)
+        {
+            FSerrno = CE_WRITE_ERROR;
+            error = EOF;
+        }
+#endif
+
         // Clear the write acess to file
         fo->flags.write = FALSE;
     }
@@ -6519,6 +6850,68 @@ int FSattrib (FSFILE * file, unsigned char attributes)
 #endif
 
 
+#ifdef ALLOW_WRITES
+/******************************************************************************
+ * Function:        WORD WholeSectors (FILEOBJ fo, WORD pos, DWORD count, BYTE * src)
+ *
+ * Output:          Number of sectors FSfwrite can write straight from 'src',
+ *                  0 when the data has to go through the data buffer
+ *
+ * Overview:        Data that starts at the beginning of a sector, covers whole
+ *                  sectors and sits at a word aligned address does not need the
+ *                  data buffer. The run ends with the current cluster, only
+ *                  the sectors of one cluster are known to be consecutive.
+ *****************************************************************************/
+
+static WORD WholeSectors (FILEOBJ fo, WORD pos, DWORD count, BYTE * src)
+{
+    DISK *  dsk = fo->dsk;
+    DWORD   sectors;
+
+    if ((pos != 0) || (((size_t)src & 3) != 0))
+        return 0;
+
+    sectors = count / dsk->sectorSize;
+    if (sectors > (DWORD)(dsk->SecPerClus - fo->sec))
+        sectors = dsk->SecPerClus - fo->sec;
+
+    return (WORD)sectors;
+}
+
+/******************************************************************************
+ * Function:        BYTE WriteSectors (DISK * dsk, DWORD sector, WORD count, BYTE * buffer)
+ *
+ * Output:          TRUE - The sectors were written
+ *                  FALSE - A write failed
+ *
+ * Overview:        Writes consecutive sectors straight from 'buffer', with one
+ *                  command when the media layer supports it.
+ *****************************************************************************/
+
+static BYTE WriteSectors (DISK * dsk, DWORD sector, WORD count, BYTE * buffer)
+{
+#ifdef FS_MULTI_SECTOR_WRITE
+    // Collected sectors go first, they may be older versions of these
+    if (MultiSectorFlush() != TRUE)
+        return FALSE;
+#endif
+
+#ifdef MDD_SectorsWrite
+    if (dsk->sectorSize == MEDIA_SECTOR_SIZE)
+        return MDD_SectorsWrite (sector, count, buffer, FALSE);
+#endif
+
+    while (count-- != 0)
+    {
+        if (MDD_SectorWrite (sector++, buffer, FALSE) != TRUE)
+            return FALSE;
+        buffer += dsk->sectorSize;
+    }
+
+    return TRUE;
+}
+#endif
+
 /*********************************************************************************
   Function:
     size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream)
@@ -6542,7 +6935,10 @@ int FSattrib (FSFILE * file, unsigned char attributes)
     the device from the specified buffer until the specified amount has been written.
     If the end of a cluster is reached, the next cluster will be loaded, unless
     the end-of-file flag for the specified file has been set.  If it has, a new
-    cluster will be allocated to the file.  Finally, the new position and filesize
+    cluster will be allocated to the file.  Whole sectors that start at a sector
+    boundary of the file and at a word aligned address in the source buffer are
+    written to the device straight from the source buffer, without passing through
+    the data buffer.  Finally, the new position and filesize
     will be stored in the FSFILE object.  The parameters 'size' and 'n' indicate how
     much data to write.  'Size' refers to the size of one object to write (in bytes),
     and 'n' will refer to the number of these objects to write.  The value returned
@@ -6561,7 +6957,8 @@ size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream
     WORD        pos;
     DWORD       l;                     // absolute lba of sector to load
     DWORD       seek, filesize;
-    WORD        writeCount = 0;
+    DWORD       writeCount = 0;
+    WORD        sectors;
 
     // see if the file was opened in a write mode
     if(!(stream->flags.write))
@@ -6615,13 +7012,17 @@ size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream
             }
         }
 
-        gBufferZeroed = FALSE;
-        if(!MDD_SectorRead( l, dsk->buffer) )
+        // A sector that is full or that will be overwritten whole is not read
+        if ((pos != dsk->sectorSize) && (WholeSectors (stream, pos, count, src) == 0))
         {
-            FSerrno = CE_BADCACHEREAD;
-            error = CE_BAD_SECTOR_READ;
+            gBufferZeroed = FALSE;
+            if(!MDD_SectorRead( l, dsk->buffer) )
+            {
+                FSerrno = CE_BADCACHEREAD;
+                error = CE_BAD_SECTOR_READ;
+            }
+            gLastDataSectorRead = l;
         }
-        gLastDataSectorRead = l;
     }
     // exit loop if EOF reached
     filesize = stream->size;
@@ -6657,13 +7058,32 @@ size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream
 
                 if(stream->flags.FileWriteEOF)
                 {
-                    error = FILEallocate_new_cluster(stream, 0);    // add new cluster to the file
+                    // Use a cluster reserved by FSfpreallocate before searching for one
+                    error = CE_FAT_EOF;
+                    if (stream->flags.Preallocated)
+                    {
+                        l = stream->ccls;
+                        error = FILEget_next_cluster( stream, 1);
+                        if (error == CE_FAT_EOF)
+                        {
+                            // The reserved chain is used up
+                            stream->ccls = l;
+                            stream->flags.Preallocated = FALSE;
+                        }
+                    }
+                    if (error == CE_FAT_EOF)
+                        error = FILEallocate_new_cluster(stream, 0);    // add new cluster to the file
                     needRead = FALSE;
                 }
                 else
                     error = FILEget_next_cluster( stream, 1);
             }
 
+            // A sector past the end of the file holds nothing the file needs,
+            // one that is overwritten whole does not need its old data either
+            if (stream->flags.FileWriteEOF || (WholeSectors (stream, pos, count, src) != 0))
+                needRead = FALSE;
+
             if (error == CE_DISK_FULL)
             {
                 FSerrno = CE_DISK_FULL;
@@ -6697,6 +7117,40 @@ size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream
             }
         } //  load new sector
 
+        if ((error == CE_GOOD) && ((sectors = WholeSectors (stream, pos, count, src)) != 0))
+        {
+            DWORD   bytes = (DWORD)sectors * dsk->sectorSize;
+
+            if (gNeedDataWrite)
+                if (flushData())
+                {
+                    FSerrno = CE_WRITE_ERROR;
+                    return 0;
+                }
+
+            if (!WriteSectors (dsk, l, sectors, src))
+            {
+                FSerrno = CE_WRITE_ERROR;
+                return 0;
+            }
+
+            // The data buffer must not keep an old copy of a written sector
+            if ((gLastDataSectorRead >= l) && (gLastDataSectorRead < (l + sectors)))
+                gLastDataSectorRead = 0xFFFFFFFF;
+
+            // Continue as if the last sector was filled through the data buffer
+            stream->sec += sectors - 1;
+            l += sectors - 1;
+            pos = dsk->sectorSize;
+            src += bytes;
+            seek += bytes;
+            count -= bytes;
+            writeCount += bytes;
+            if (seek > filesize)
+                filesize = seek;
+            continue;
+        }
+
         if(error == CE_GOOD)
         {
             // Write one byte at a time
@@ -6726,54 +7180,256 @@ size_t FSfwrite(const void *data_to_write, size_t size, size_t n, FSFILE *stream
 #endif
 
 
-/**********************************************************
+/*********************************************************************************
   Function:
-    BYTE flushData (void)
+    int FSfpreallocate(FSFILE *fo, DWORD size)
   Summary:
-    Flush unwritten data to a file
+    Reserve clusters for data that will be written to a file
   Conditions:
-    File opened in a write mode, data needs to be written
+    File opened in FS_WRITE, FS_APPEND, FS_WRITE+, FS_APPEND+, FS_READ+ mode
+  Input:
+    fo -    Pointer to file structure
+    size -  Number of bytes that will be written from the current position
   Return Values:
-    CE_GOOD -        Data was updated successfully
-    CE_WRITE_ERROR - Data could not be updated
+    0 -   The clusters were reserved
+    EOF - Not all clusters could be reserved
   Side Effects:
-    None
+    The FSerrno variable will be changed.
   Description:
-    The flushData function is called when it is necessary to
-    read new data into the global data buffer and the
-    gNeedDataWrite variable indicates that there is data
-    in the buffer that hasn't been written to the device.
-    The flushData function will write the data from the
-    buffer into the current cluster of the FSFILE object
-    that is stored in the gBufferOwner global variable.
+    Counts the clusters already in the file's chain and appends as many as
+    are missing for 'size' more bytes from the current position.  Each new
+    cluster is searched for starting at the last one in the chain, so the
+    chain stays contiguous wherever the next cluster is free.  The FAT entries
+    are changed in the FAT sector cache and reach the media a sector at a time.
+    FSfclose frees the clusters that were not needed.
   Remarks:
-    None
-  **********************************************************/
+    None.
+  *********************************************************************************/
 
 #ifdef ALLOW_WRITES
-BYTE flushData (void)
+int FSfpreallocate (FSFILE *fo, DWORD size)
 {
-    DWORD l;
-    DISK * dsk;
-
-    // This will either be the pointer to the last file, or the handle
-    FILEOBJ stream = gBufferOwner;
+    DISK *      dsk;
+    DWORD       clusterSize, needed, chain, c, current, LastClusterLimit;
 
-    dsk = stream->dsk;
+    FSerrno = CE_GOOD;
 
-    // figure out the lba
-    l = Cluster2Sector(dsk,stream->ccls);
-    l += (WORD)stream->sec;      // add the sector number to it
+    if (!(fo->flags.write))
+    {
+        FSerrno = CE_READONLY;
+        return EOF;
+    }
 
-    if(!MDD_SectorWrite( l, dsk->buffer, FALSE))
+    if (fo->cluster == 0)
     {
-        return CE_WRITE_ERROR;
+        FSerrno = CE_INVALID_CLUSTER;
+        return EOF;
     }
 
-    gNeedDataWrite = FALSE;
+    dsk = fo->dsk;
 
-    return CE_GOOD;
-}
+    switch (dsk->type)
+    {
+#ifdef SUPPORT_FAT32 // If FAT32 supported.
+        case FAT32:
+            LastClusterLimit = LAST_CLUSTER_FAT32;
+            break;
+#endif
+        case FAT12:
+            LastClusterLimit = LAST_CLUSTER_FAT12;
+            break;
+        case FAT16:
+        default:
+            LastClusterLimit = LAST_CLUSTER_FAT16;
+            break;
+    }
+
+    // Number of clusters the file needs when 'size' more bytes are written
+    clusterSize = (DWORD)dsk->SecPerClus * dsk->sectorSize;
+    needed = (fo->seek + size + clusterSize - 1) / clusterSize;
+
+    // Find the end of the chain the file has now
+    c = fo->cluster;
+    chain = 1;
+    while ((current = ReadFAT (dsk, c)) < LastClusterLimit)
+    {
+        if ((current < 2) || (current >= (dsk->maxcls + 2)))
+        {
+            FSerrno = CE_INVALID_CLUSTER;
+            return EOF;
+        }
+        c = current;
+        chain++;
+    }
+
+    if (chain >= needed)
+        return 0;
+
+    // FILEallocate_new_cluster links to the cluster in 'ccls'
+    current = fo->ccls;
+    fo->ccls = c;
+    fo->flags.Preallocated = TRUE;
+
+    for (; chain < needed; chain++)
+    {
+        if (FILEallocate_new_cluster (fo, 0) != CE_GOOD)
+        {
+            fo->ccls = current;
+            FSerrno = CE_DISK_FULL;
+            return EOF;
+        }
+    }
+
+    fo->ccls = current;
+
+    return 0;
+}
+
+
+/**********************************************************
+  Function:
+    BYTE FILEfree_preallocated (FILEOBJ fo)
+  Summary:
+    Free the clusters reserved past the end of a file
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    fo -  The file that is being closed
+  Return Values:
+    TRUE -  The chain ends with the last cluster the file needs
+    FALSE - The FAT could not be read or written
+  Side Effects:
+    None
+  Description:
+    Finds the cluster that holds the last byte of the
+    file, marks it as the last cluster and erases the
+    rest of the chain.  When the file is positioned at
+    its end that is the current cluster, otherwise the
+    chain is walked from the first cluster.
+  Remarks:
+    None
+  **********************************************************/
+
+BYTE FILEfree_preallocated (FILEOBJ fo)
+{
+    DISK *      dsk;
+    DWORD       clusterSize, keep, c, next, LastClusterValue, ClusterFailValue;
+
+    dsk = fo->dsk;
+
+    switch (dsk->type)
+    {
+#ifdef SUPPORT_FAT32 // If FAT32 supported.
+        case FAT32:
+            LastClusterValue = LAST_CLUSTER_FAT32;
+            ClusterFailValue = CLUSTER_FAIL_FAT32;
+            break;
+#endif
+        case FAT12:
+            LastClusterValue = LAST_CLUSTER_FAT12;
+            ClusterFailValue = CLUSTER_FAIL_FAT16;
+            break;
+        case FAT16:
+        default:
+            LastClusterValue = LAST_CLUSTER_FAT16;
+            ClusterFailValue = CLUSTER_FAIL_FAT16;
+            break;
+    }
+
+    if ((fo->seek == fo->size) && (fo->size != 0))
+    {
+        // At a cluster boundary 'ccls' still is the cluster of the last byte
+        c = fo->ccls;
+    }
+    else
+    {
+        // An empty file keeps its first cluster
+        clusterSize = (DWORD)dsk->SecPerClus * dsk->sectorSize;
+        keep = (fo->size + clusterSize - 1) / clusterSize;
+        if (keep == 0)
+            keep = 1;
+
+        c = fo->cluster;
+        while (--keep != 0)
+        {
+            c = ReadFAT (dsk, c);
+            if ((c == ClusterFailValue) || (c >= LastClusterValue))
+                return (c == ClusterFailValue) ? FALSE : TRUE;
+        }
+    }
+
+    next = ReadFAT (dsk, c);
+    if (next == ClusterFailValue)
+        return FALSE;
+    if (next >= LastClusterValue)
+        return TRUE;
+
+    if (WriteFAT (dsk, c, LastClusterValue, FALSE) == ClusterFailValue)
+        return FALSE;
+
+    return FAT_erase_cluster_chain (next, dsk);
+}
+#endif
+
+
+/**********************************************************
+  Function:
+    BYTE flushData (void)
+  Summary:
+    Flush unwritten data to a file
+  Conditions:
+    File opened in a write mode, data needs to be written
+  Return Values:
+    CE_GOOD -        Data was updated successfully
+    CE_WRITE_ERROR - Data could not be updated
+  Side Effects:
+    None
+  Description:
+    The flushData function is called when it is necessary to
+    read new data into the global data buffer and the
+    gNeedDataWrite variable indicates that there is data
+    in the buffer that hasn't been written to the device.
+    The flushData function will write the data from the
+    buffer into the current cluster of the FSFILE object
+    that is stored in the gBufferOwner global variable.
+  Remarks:
+    None
+  **********************************************************/
+
+#ifdef ALLOW_WRITES
+BYTE flushData (void)
+{
+    DWORD l;
+    DISK * dsk;
+
+    // This will either be the pointer to the last file, or the handle
+    FILEOBJ stream = gBufferOwner;
+
+    dsk = stream->dsk;
+
+    // figure out the lba
+    l = Cluster2Sector(dsk,stream->ccls);
+    l += (WORD)stream->sec;      // add the sector number to it
+
+#ifdef FS_MULTI_SECTOR_WRITE
+    if (dsk->sectorSize == MEDIA_SECTOR_SIZE)
+    {
+        if (!MultiSectorStage (l, dsk->buffer))
+        {
+            return CE_WRITE_ERROR;
+        }
+    }
+    else
+#endif
+    if(!MDD_SectorWrite( l, dsk->buffer, FALSE))
+    {
+        return CE_WRITE_ERROR;
+    }
+
+    gNeedDataWrite = FALSE;
+
+    return CE_GOOD;
+}
 #endif
 
 /****************************************************
@@ -8167,6 +8823,7 @@ int FindFirstpgm (const rom char * fileName, unsigned int attr, SearchRec * rec)
 DWORD ReadFAT (DISK *dsk, DWORD ccls)
 {
     BYTE q;
+    BYTE * buffer;
     DWORD p, l;  // "l" is the sector Address
     DWORD c = 0, d, ClusterFailValue,LastClusterLimit;   // ClusterEntries
 
@@ -8202,102 +8859,44 @@ DWORD ReadFAT (DISK *dsk, DWORD ccls)
     l = dsk->fat + (p / dsk->sectorSize);     //
     p &= dsk->sectorSize - 1;                 // Restrict 'p' within the FATbuffer size
 
-    // Check if the appropriate FAT sector is already loaded
-    if (gLastFATSectorRead == l)
-    {
+    // Get the FAT sector from the cache, a changed sector that has to make
+    // room is written to the card first
+    buffer = FATCacheLoad (dsk, l, FALSE);
+    if (buffer == NULL)
+        return ClusterFailValue;
+
 #ifdef SUPPORT_FAT32 // If FAT32 supported.
-        if (dsk->type == FAT32)
-            c = RAMreadD (gFATBuffer, p);
-        else
+    if (dsk->type == FAT32)
+        c = RAMreadD (buffer, p);
+    else
 #endif
-            if(dsk->type == FAT16)
-                c = RAMreadW (gFATBuffer, p);
-            else if(dsk->type == FAT12)
+        if(dsk->type == FAT16)
+            c = RAMreadW (buffer, p);
+        else if(dsk->type == FAT12)
+        {
+            c = RAMread (buffer, p);
+            if (q)
             {
-                c = RAMread (gFATBuffer, p);
-                if (q)
-                {
-                    c >>= 4;
-                }
-                // Check if the MSB is across the sector boundry
-                p = (p +1) & (dsk->sectorSize-1);
-                if (p == 0)
-                {
-                    // Start by writing the sector we just worked on to the card
-                    // if we need to
-#ifdef ALLOW_WRITES
-                    if (gNeedFATWrite)
-                        if(WriteFAT (dsk, 0, 0, TRUE))
-                            return ClusterFailValue;
-#endif
-                    if (!MDD_SectorRead (l+1, gFATBuffer))
-                    {
-                        gLastFATSectorRead = 0xFFFF;
-                        return ClusterFailValue;
-                    }
-                    else
-                    {
-                        gLastFATSectorRead = l +1;
-                    }
-                }
-                d = RAMread (gFATBuffer, p);
-                if (q)
-                {
-                    c += (d <<4);
-                }
-                else
-                {
-                    c += ((d & 0x0F)<<8);
-                }
+                c >>= 4;
             }
-        }
-        else
-        {
-            // If there's a currently open FAT sector,
-            // write it back before reading into the buffer
-#ifdef ALLOW_WRITES
-            if (gNeedFATWrite)
+            // Check if the MSB is across the sector boundry
+            p = (p +1) & (dsk->sectorSize-1);
+            if (p == 0)
             {
-                if(WriteFAT (dsk, 0, 0, TRUE))
+                buffer = FATCacheLoad (dsk, l+1, FALSE);
+                if (buffer == NULL)
                     return ClusterFailValue;
             }
-#endif
-            if (!MDD_SectorRead (l, gFATBuffer))
+            d = RAMread (buffer, p);
+            if (q)
             {
-                gLastFATSectorRead = 0xFFFF;  // Note: It is Sector not Cluster.
-                return ClusterFailValue;
+                c += (d <<4);
             }
             else
             {
-                gLastFATSectorRead = l;
-
-#ifdef SUPPORT_FAT32 // If FAT32 supported.
-                if (dsk->type == FAT32)
-                    c = RAMreadD (gFATBuffer, p);
-                else
-#endif
-                    if(dsk->type == FAT16)
-                        c = RAMreadW (gFATBuffer, p);
-                    else if (dsk->type == FAT12)
-                    {
-                        c = RAMread (gFATBuffer, p);
-                        if (q)
-                        {
-                            c >>= 4;
-                        }
-                        p = (p +1) & (dsk->sectorSize-1);
-                        d = RAMread (gFATBuffer, p);
-                        if (q)
-                        {
-                            c += (d <<4);
-                        }
-                        else
-                        {
-                            c += ((d & 0x0F)<<8);
-                        }
-                    }
+                c += ((d & 0x0F)<<8);
             }
-    }
+        }
 
     // Normalize it so 0xFFFF is an error
     if (c >= LastClusterLimit)
@@ -8307,6 +8906,198 @@ DWORD ReadFAT (DISK *dsk, DWORD ccls)
 }   // ReadFAT
 
 
+/***********************************************
+  Function:
+    void FATCacheInvalidate (void)
+  Summary:
+    Empty the FAT sector cache
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    None
+  Return:
+    None
+  Side Effects:
+    Changed sectors that were not written are lost.
+  Description:
+    The FATCacheInvalidate function marks every slot
+    of the FAT sector cache as empty, so the next
+    access to any FAT sector reads it from the media.
+  Remarks:
+    None.
+  ***********************************************/
+
+void FATCacheInvalidate (void)
+{
+    BYTE i;
+
+    for (i = 0; i < FS_FAT_CACHE_SECTORS; i++)
+    {
+        gFATCacheSector[i] = 0xFFFFFFFF;
+        gFATCacheUsed[i] = 0;
+        gFATCacheDirty[i] = FALSE;
+    }
+    gNeedFATWrite = FALSE;
+}
+
+
+#ifdef ALLOW_WRITES
+/***********************************************
+  Function:
+    static BYTE FATCacheWriteSlot (DISK *dsk, BYTE slot)
+  Summary:
+    Write one cached FAT sector to every FAT copy
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    dsk -   The disk structure
+    slot -  The cache slot to write
+  Return Values:
+    TRUE -  The sector was written
+    FALSE - The sector could not be written
+  Side Effects:
+    None
+  Description:
+    Writes the sector held in 'slot' to each copy
+    of the FAT and marks the slot as unchanged.
+  Remarks:
+    None.
+  ***********************************************/
+
+static BYTE FATCacheWriteSlot (DISK *dsk, BYTE slot)
+{
+    BYTE i;
+    DWORD li;
+
+    for (i = 0, li = gFATCacheSector[slot]; i < dsk->fatcopy; i++, li += dsk->fatsize)
+    {
+        if (!MDD_SectorWrite (li, gFATBuffer[slot], FALSE))
+        {
+            return FALSE;
+        }
+    }
+    gFATCacheDirty[slot] = FALSE;
+
+    return TRUE;
+}
+
+
+/***********************************************
+  Function:
+    BYTE FATCacheFlush (DISK *dsk)
+  Summary:
+    Write all changed FAT sectors to the media
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    dsk -  The disk structure
+  Return Values:
+    TRUE -  All changed sectors were written
+    FALSE - A sector could not be written
+  Side Effects:
+    None
+  Description:
+    Writes every changed slot of the FAT sector
+    cache to the media. The sectors stay cached.
+  Remarks:
+    None.
+  ***********************************************/
+
+BYTE FATCacheFlush (DISK *dsk)
+{
+    BYTE i;
+
+    for (i = 0; i < FS_FAT_CACHE_SECTORS; i++)
+    {
+        if (gFATCacheDirty[i] && !FATCacheWriteSlot (dsk, i))
+        {
+            return FALSE;
+        }
+    }
+    gNeedFATWrite = FALSE;
+
+    return TRUE;
+}
+#endif
+
+
+/***********************************************
+  Function:
+    BYTE * FATCacheLoad (DISK *dsk, DWORD sector, BYTE forWrite)
+  Summary:
+    Get a FAT sector from the FAT sector cache
+  Conditions:
+    This function should not be called by the user.
+  Input:
+    dsk -       The disk structure
+    sector -    The LBA of the FAT sector
+    forWrite -  TRUE if the caller will change the sector
+  Return:
+    BYTE * - Pointer to the cached sector
+    NULL -   The sector could not be read
+  Side Effects:
+    None
+  Description:
+    The FATCacheLoad function returns the cache
+    slot holding 'sector.' When the sector is not
+    cached, the least recently used slot is written
+    back if it was changed and the sector is read
+    into it. With 'forWrite' set the slot is marked
+    as changed, it is written to the media when it
+    is evicted or when the cache is flushed.
+  Remarks:
+    None.
+  ***********************************************/
+
+BYTE * FATCacheLoad (DISK *dsk, DWORD sector, BYTE forWrite)
+{
+    BYTE i, slot;
+
+    for (slot = 0; slot < FS_FAT_CACHE_SECTORS; slot++)
+    {
+        if (gFATCacheSector[slot] == sector)
+            break;
+    }
+
+    if (slot == FS_FAT_CACHE_SECTORS)
+    {
+        // Reuse the slot that was not used for the longest time
+        slot = 0;
+        for (i = 1; i < FS_FAT_CACHE_SECTORS; i++)
+        {
+            if (gFATCacheUsed[i] < gFATCacheUsed[slot])
+                slot = i;
+        }
+
+#ifdef ALLOW_WRITES
+        if (gFATCacheDirty[slot] && !FATCacheWriteSlot (dsk, slot))
+        {
+            return NULL;
+        }
+#endif
+
+        if (!MDD_SectorRead (sector, gFATBuffer[slot]))
+        {
+            gFATCacheSector[slot] = 0xFFFFFFFF;
+            gFATCacheUsed[slot] = 0;
+            return NULL;
+        }
+        gFATCacheSector[slot] = sector;
+    }
+    gFATCacheUsed[slot] = ++gFATCacheTick;
+
+#ifdef ALLOW_WRITES
+    if (forWrite)
+    {
+        gFATCacheDirty[slot] = TRUE;
+        gNeedFATWrite = TRUE;
+    }
+#endif
+
+    return gFATBuffer[slot];
+}
+
+
 
 /****************************************************************************
   Function:
@@ -8338,8 +9129,9 @@ DWORD ReadFAT (DISK *dsk, DWORD ccls)
 #ifdef ALLOW_WRITES
 DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
 {
-    BYTE i, q, c;
-    DWORD p, li, l, ClusterFailValue;
+    BYTE q, c;
+    BYTE * buffer;
+    DWORD p, l, ClusterFailValue;
 
 #ifdef SUPPORT_FAT32 // If FAT32 supported.
     if ((dsk->type != FAT32) && (dsk->type != FAT16) && (dsk->type != FAT12))
@@ -8367,19 +9159,14 @@ DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
     gBufferZeroed = FALSE;
 
     // The only purpose for calling this function with forceWrite
-    // is to write the current FAT sector to the card
+    // is to write the changed FAT sectors to the card
     if (forceWrite)
     {
-        for (i = 0, li = gLastFATSectorRead; i < dsk->fatcopy; i++, li += dsk->fatsize)
+        if (!FATCacheFlush (dsk))
         {
-            if (!MDD_SectorWrite (li, gFATBuffer, FALSE))
-            {
-                return ClusterFailValue;
-            }
+            return ClusterFailValue;
         }
 
-        gNeedFATWrite = FALSE;
-
         return 0;
     }
 
@@ -8407,42 +9194,20 @@ DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
     l = dsk->fat + (p / dsk->sectorSize);     //
     p &= dsk->sectorSize - 1;                 // Restrict 'p' within the FATbuffer size
 
-    if (gLastFATSectorRead != l)
+    // Get the FAT sector from the cache and mark it as changed
+    buffer = FATCacheLoad (dsk, l, TRUE);
+    if (buffer == NULL)
     {
-        // If we are loading a new sector then write
-        // the current one to the card if we need to
-        if (gNeedFATWrite)
-        {
-            for (i = 0, li = gLastFATSectorRead; i < dsk->fatcopy; i++, li += dsk->fatsize)
-            {
-                if (!MDD_SectorWrite (li, gFATBuffer, FALSE))
-                {
-                    return ClusterFailValue;
-                }
-            }
-
-            gNeedFATWrite = FALSE;
-        }
-
-        // Load the new sector
-        if (!MDD_SectorRead (l, gFATBuffer))
-        {
-            gLastFATSectorRead = 0xFFFF;
-            return ClusterFailValue;
-        }
-        else
-        {
-            gLastFATSectorRead = l;
-        }
+        return ClusterFailValue;
     }
 
 #ifdef SUPPORT_FAT32 // If FAT32 supported.
     if (dsk->type == FAT32)  // Refer page 16 of FAT requirement.
     {
-        RAMwrite (gFATBuffer, p,   ((value & 0x000000ff)));         // lsb,1st byte of cluster value
-        RAMwrite (gFATBuffer, p+1, ((value & 0x0000ff00) >> 8));
-        RAMwrite (gFATBuffer, p+2, ((value & 0x00ff0000) >> 16));
-        RAMwrite (gFATBuffer, p+3, ((value & 0x0f000000) >> 24));   // the MSB nibble is supposed to be "0" in FAT32. So mask it.
+        RAMwrite (buffer, p,   ((value & 0x000000ff)));         // lsb,1st byte of cluster value
+        RAMwrite (buffer, p+1, ((value & 0x0000ff00) >> 8));
+        RAMwrite (buffer, p+2, ((value & 0x00ff0000) >> 16));
+        RAMwrite (buffer, p+3, ((value & 0x0f000000) >> 24));   // the MSB nibble is supposed to be "0" in FAT32. So mask it.
     }
     else
     
@@ -8450,13 +9215,13 @@ DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
     {
         if (dsk->type == FAT16)
         {
-            RAMwrite (gFATBuffer, p, value);            //lsB
-            RAMwrite (gFATBuffer, p+1, ((value&0x0000ff00) >> 8));    // msB
+            RAMwrite (buffer, p, value);            //lsB
+            RAMwrite (buffer, p+1, ((value&0x0000ff00) >> 8));    // msB
         }
         else if (dsk->type == FAT12)
         {
             // Get the current byte from the FAT
-            c = RAMread (gFATBuffer, p);
+            c = RAMread (buffer, p);
             if (q)
             {
                 c = ((value & 0x0F) << 4) | ( c & 0x0F);
@@ -8466,31 +9231,23 @@ DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
                 c = (value & 0xFF);
             }
             // Write in those bits
-            RAMwrite (gFATBuffer, p, c);
+            RAMwrite (buffer, p, c);
 
             // FAT12 entries can cross sector boundaries
             // Check if we need to load a new sector
             p = (p +1) & (dsk->sectorSize-1);
             if (p == 0)
             {
-                // call this function to update the FAT on the card
-                if (WriteFAT (dsk, 0,0,TRUE))
-                    return ClusterFailValue;
-
                 // Load the next sector
-                if (!MDD_SectorRead (l +1, gFATBuffer))
+                buffer = FATCacheLoad (dsk, l+1, TRUE);
+                if (buffer == NULL)
                 {
-                    gLastFATSectorRead = 0xFFFF;
                     return ClusterFailValue;
                 }
-                else
-                {
-                    gLastFATSectorRead = l + 1;
-                }
             }
 
             // Get the second byte of the table entry
-            c = RAMread (gFATBuffer, p);
+            c = RAMread (buffer, p);
             if (q)
             {
                 c = (value >> 4);
@@ -8499,10 +9256,9 @@ DWORD WriteFAT (DISK *dsk, DWORD ccls, DWORD value, BYTE forceWrite)
             {
                 c = ((value >> 8) & 0x0F) | (c & 0xF0);
             }
-            RAMwrite (gFATBuffer, p, c);
+            RAMwrite (buffer, p, c);
         }
     }
-    gNeedFATWrite = TRUE;
 
     return 0;
 }
@@ -685,8 +685,42 @@ BYTE USBHostMSDSCSIMediaReset( void  )
            9        [                    Control                            ]
     </code>
   ***************************************************************************/
-
 BYTE USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer )
+{
+    return USBHostMSDSCSISectorsRead( sectorAddress, 1, dataBuffer );
+}
+
+/****************************************************************************
+  Function:
+    BYTE USBHostMSDSCSISectorsRead( DWORD sectorAddress, WORD sectorCount,
+                BYTE *dataBuffer )
+
+  Summary:
+    This function reads consecutive sectors.
+
+  Description:
+    This function uses a single SCSI command READ10 to read sectorCount
+    consecutive sectors starting at sectorAddress.  The data is stored in the
+    application buffer which must hold sectorCount sectors.
+
+  Precondition:
+    None
+
+  Parameters:
+    DWORD   sectorAddress   - address of the first sector to read
+    WORD    sectorCount     - number of sectors to read
+    BYTE    *dataBuffer     - buffer to store data
+
+  Return Values:
+    TRUE    - read performed successfully
+    FALSE   - read was not successful
+
+  Remarks:
+    See USBHostMSDSCSISectorRead() for the READ10 command block.
+  ***************************************************************************/
+
+
+BYTE USBHostMSDSCSISectorsRead( DWORD sectorAddress, WORD sectorCount, BYTE *dataBuffer )
 {
     DWORD   byteCount;
     BYTE    commandBlock[10];
@@ -703,7 +737,7 @@ BYTE USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer )
         UART2PrintString( "\r\n" );
     #endif
 
-    if (deviceAddress == 0)
+    if ((deviceAddress == 0) || (sectorCount == 0))
     {
         return FALSE;       // USB_MSD_DEVICE_NOT_FOUND;
     }
@@ -716,12 +750,13 @@ BYTE USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer )
     commandBlock[4] = (BYTE) (sectorAddress >> 8);
     commandBlock[5] = (BYTE) (sectorAddress);
     commandBlock[6] = 0x00;     // Group Number
-    commandBlock[7] = 0x00;     // Number of blocks - Big endian!
-    commandBlock[8] = 0x01;
+    commandBlock[7] = (BYTE) (sectorCount >> 8);        // Number of blocks - Big endian!
+    commandBlock[8] = (BYTE) (sectorCount);
     commandBlock[9] = 0x00;     // Control
 
     // Currently using LUN=0.  When the File System supports multiple LUN's, this will change.
-    errorCode = USBHostMSDRead( deviceAddress, 0, commandBlock, 10, dataBuffer, mediaInformation.sectorSize );
+    errorCode = USBHostMSDRead( deviceAddress, 0, commandBlock, 10, dataBuffer,
+                    (DWORD)mediaInformation.sectorSize * sectorCount );
     #ifdef DEBUG_MODE
         UART2PrintString( "SCSI: Read sector init error " );
         UART2PutHex( errorCode );
@@ -796,8 +831,47 @@ BYTE USBHostMSDSCSISectorRead( DWORD sectorAddress, BYTE *dataBuffer )
            9        [                    Control                            ]
     </code>
   ***************************************************************************/
-
 BYTE USBHostMSDSCSISectorWrite( DWORD sectorAddress, BYTE *dataBuffer, BYTE allowWriteToZero )
+{
+    return USBHostMSDSCSISectorsWrite( sectorAddress, 1, dataBuffer, allowWriteToZero );
+}
+
+
+/****************************************************************************
+  Function:
+    BYTE USBHostMSDSCSISectorsWrite( DWORD sectorAddress, WORD sectorCount,
+                BYTE *dataBuffer, BYTE allowWriteToZero )
+
+  Summary:
+    This function writes consecutive sectors.
+
+  Description:
+    This function uses a single SCSI command WRITE10 to write sectorCount
+    consecutive sectors starting at sectorAddress.  The data is read from the
+    application buffer which must hold sectorCount sectors.  Compared to
+    sectorCount single sector writes this saves the command and status
+    stages of all but one transfer.
+
+  Precondition:
+    None
+
+  Parameters:
+    DWORD   sectorAddress   - address of the first sector to write
+    WORD    sectorCount     - number of sectors to write
+    BYTE    *dataBuffer     - buffer with application data
+    BYTE    allowWriteToZero- If a write to sector 0 is allowed.
+
+  Return Values:
+    TRUE    - write performed successfully
+    FALSE   - write was not successful
+
+  Remarks:
+    To follow convention, this function blocks until the write is complete.
+    See USBHostMSDSCSISectorWrite() for the WRITE10 command block.
+  ***************************************************************************/
+
+
+BYTE USBHostMSDSCSISectorsWrite( DWORD sectorAddress, WORD sectorCount, BYTE *dataBuffer, BYTE allowWriteToZero )
 {
     DWORD   byteCount;
     BYTE    commandBlock[10];
@@ -814,7 +888,7 @@ BYTE USBHostMSDSCSISectorWrite( DWORD sectorAddress, BYTE *dataBuffer, BYTE allo
         UART2PrintString( "\r\n" );
     #endif
 
-    if (deviceAddress == 0)
+    if ((deviceAddress == 0) || (sectorCount == 0))
     {
         return FALSE;   //USB_MSD_DEVICE_NOT_FOUND;
     }
@@ -832,12 +906,13 @@ BYTE USBHostMSDSCSISectorWrite( DWORD sectorAddress, BYTE *dataBuffer, BYTE allo
     commandBlock[4] = (BYTE) (sectorAddress >> 8);
     commandBlock[5] = (BYTE) (sectorAddress);
     commandBlock[6] = 0x00;     // Group Number
-    commandBlock[7] = 0x00;     // Number of blocks - Big endian!
-    commandBlock[8] = 0x01;
+    commandBlock[7] = (BYTE) (sectorCount >> 8);        // Number of blocks - Big endian!
+    commandBlock[8] = (BYTE) (sectorCount);
     commandBlock[9] = 0x00;     // Control
 
     // Currently using LUN=0.  When the File System supports multiple LUN's, this will change.
-    errorCode = USBHostMSDWrite( deviceAddress, 0, commandBlock, 10, dataBuffer, mediaInformation.sectorSize );
+    errorCode = USBHostMSDWrite( deviceAddress, 0, commandBlock, 10, dataBuffer,
+                    (DWORD)mediaInformation.sectorSize * sectorCount );
     #ifdef DEBUG_MODE
         UART2PrintString( "SCSI: Write sector init error " );
         UART2PutHex( errorCode );
@@ -45,17 +45,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=application/source/main.c application/source/app_config.c application/source/app_usb.c application/source/app_psensor.c application/source/app_motor.c application/source/app_battery.c application/source/app_buzzer.c application/source/support.c application/source/epa_gui.c application/source/app_time.c application/source/logo.c application/source/app_storage.c application/source/app_timer.c application/source/app_data_log.c application/source/app_user.c application/source/app_gpu.c application/source/epa_touch.c application/source/app_pdetector.c application/source/app_string.c driver/source/lld_spis.c driver/source/lld_spi1.c driver/source/spi.c driver/source/lld_spi2.c driver/source/clock.c driver/source/gpio.c driver/source/intr.c driver/source/adc.c driver/source/s25fl.c driver/source/i2c.c driver/source/rtc.c driver/source/systick.c driver/source/lld_i2c1.c esolid-base/port/pic32-none-gcc/mips-m4k/cpu.c esolid-base/port/pic32-none-gcc/mips-m4k/intr.c esolid-base/port/pic32-none-gcc/mips-m4k/systimer.c esolid-base/src/debug.c esolid-base/src/error.c esolid-base/src/prio_queue.c esolid-base/src/base.c esolid-eds/src/smp.c esolid-eds/src/event.c esolid-eds/src/epa.c esolid-mem/src/mem_class.c esolid-mem/src/heap.c esolid-mem/src/static.c esolid-mem/src/pool.c esolid-vtimer/src/vtimer.c ft800/source/FT_CoPro_Cmds.c ft800/source/FT_Gpu_Hal.c lib/checksum/checksum.c mla/source/common/TimeDelay.c mla/source/MDDFS/FSIO.c mla/source/USB/usb_host.c mla/source/USB/usb_host_msd_scsi.c mla/source/USB/usb_host_msd.c
+SOURCEFILES_QUOTED_IF_SPACED=application/source/main.c application/source/app_config.c application/source/app_usb.c application/source/app_psensor.c application/source/app_motor.c application/source/app_battery.c application/source/app_buzzer.c application/source/support.c application/source/epa_gui.c application/source/app_time.c application/source/logo.c application/source/app_storage.c application/source/app_timer.c application/source/app_data_log.c application/source/app_user.c application/source/app_gpu.c application/source/epa_touch.c application/source/epa_test.c application/source/epa_export.c application/source/app_pdetector.c application/source/app_string.c application/source/app_curve.c application/source/app_predict.c application/source/app_leak.c application/source/app_pump.c driver/source/lld_spis.c driver/source/lld_spi1.c driver/source/spi.c driver/source/lld_spi2.c driver/source/clock.c driver/source/gpio.c driver/source/intr.c driver/source/adc.c driver/source/pwm.c driver/source/s25fl.c driver/source/i2c.c driver/source/rtc.c driver/source/systick.c driver/source/lld_i2c1.c esolid-base/port/pic32-none-gcc/mips-m4k/cpu.c esolid-base/port/pic32-none-gcc/mips-m4k/intr.c esolid-base/port/pic32-none-gcc/mips-m4k/systimer.c esolid-base/src/debug.c esolid-base/src/error.c esolid-base/src/prio_queue.c esolid-base/src/base.c esolid-eds/src/smp.c esolid-eds/src/event.c esolid-eds/src/epa.c esolid-mem/src/mem_class.c esolid-mem/src/heap.c esolid-mem/src/static.c esolid-mem/src/pool.c esolid-vtimer/src/vtimer.c ft800/source/FT_CoPro_Cmds.c ft800/source/FT_Gpu_Hal.c lib/checksum/checksum.c lib/delta/delta.c mla/source/common/TimeDelay.c mla/source/MDDFS/FSIO.c mla/source/USB/usb_host.c mla/source/USB/usb_host_msd_scsi.c mla/source/USB/usb_host_msd.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/application/source/main.o ${OBJECTDIR}/application/source/app_config.o ${OBJECTDIR}/application/source/app_usb.o ${OBJECTDIR}/application/source/app_psensor.o ${OBJECTDIR}/application/source/app_motor.o ${OBJECTDIR}/application/source/app_battery.o ${OBJECTDIR}/application/source/app_buzzer.o ${OBJECTDIR}/application/source/support.o ${OBJECTDIR}/application/source/epa_gui.o ${OBJECTDIR}/application/source/app_time.o ${OBJECTDIR}/application/source/logo.o ${OBJECTDIR}/application/source/app_storage.o ${OBJECTDIR}/application/source/app_timer.o ${OBJECTDIR}/application/source/app_data_log.o ${OBJECTDIR}/application/source/app_user.o ${OBJECTDIR}/application/source/app_gpu.o ${OBJECTDIR}/application/source/epa_touch.o ${OBJECTDIR}/application/source/app_pdetector.o ${OBJECTDIR}/application/source/app_string.o ${OBJECTDIR}/driver/source/lld_spis.o ${OBJECTDIR}/driver/source/lld_spi1.o ${OBJECTDIR}/driver/source/spi.o ${OBJECTDIR}/driver/source/lld_spi2.o ${OBJECTDIR}/driver/source/clock.o ${OBJECTDIR}/driver/source/gpio.o ${OBJECTDIR}/driver/source/intr.o ${OBJECTDIR}/driver/source/adc.o ${OBJECTDIR}/driver/source/s25fl.o ${OBJECTDIR}/driver/source/i2c.o ${OBJECTDIR}/driver/source/rtc.o ${OBJECTDIR}/driver/source/systick.o ${OBJECTDIR}/driver/source/lld_i2c1.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o ${OBJECTDIR}/esolid-base/src/debug.o ${OBJECTDIR}/esolid-base/src/error.o ${OBJECTDIR}/esolid-base/src/prio_queue.o ${OBJECTDIR}/esolid-base/src/base.o ${OBJECTDIR}/esolid-eds/src/smp.o ${OBJECTDIR}/esolid-eds/src/event.o ${OBJECTDIR}/esolid-eds/src/epa.o ${OBJECTDIR}/esolid-mem/src/mem_class.o ${OBJECTDIR}/esolid-mem/src/heap.o ${OBJECTDIR}/esolid-mem/src/static.o ${OBJECTDIR}/esolid-mem/src/pool.o ${OBJECTDIR}/esolid-vtimer/src/vtimer.o ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o ${OBJECTDIR}/lib/checksum/checksum.o ${OBJECTDIR}/mla/source/common/TimeDelay.o ${OBJECTDIR}/mla/source/MDDFS/FSIO.o ${OBJECTDIR}/mla/source/USB/usb_host.o ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o ${OBJECTDIR}/mla/source/USB/usb_host_msd.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/application/source/main.o.d ${OBJECTDIR}/application/source/app_config.o.d ${OBJECTDIR}/application/source/app_usb.o.d ${OBJECTDIR}/application/source/app_psensor.o.d ${OBJECTDIR}/application/source/app_motor.o.d ${OBJECTDIR}/application/source/app_battery.o.d ${OBJECTDIR}/application/source/app_buzzer.o.d ${OBJECTDIR}/application/source/support.o.d ${OBJECTDIR}/application/source/epa_gui.o.d ${OBJECTDIR}/application/source/app_time.o.d ${OBJECTDIR}/application/source/logo.o.d ${OBJECTDIR}/application/source/app_storage.o.d ${OBJECTDIR}/application/source/app_timer.o.d ${OBJECTDIR}/application/source/app_data_log.o.d ${OBJECTDIR}/application/source/app_user.o.d ${OBJECTDIR}/application/source/app_gpu.o.d ${OBJECTDIR}/application/source/epa_touch.o.d ${OBJECTDIR}/application/source/app_pdetector.o.d ${OBJECTDIR}/application/source/app_string.o.d ${OBJECTDIR}/driver/source/lld_spis.o.d ${OBJECTDIR}/driver/source/lld_spi1.o.d ${OBJECTDIR}/driver/source/spi.o.d ${OBJECTDIR}/driver/source/lld_spi2.o.d ${OBJECTDIR}/driver/source/clock.o.d ${OBJECTDIR}/driver/source/gpio.o.d ${OBJECTDIR}/driver/source/intr.o.d ${OBJECTDIR}/driver/source/adc.o.d ${OBJECTDIR}/driver/source/s25fl.o.d ${OBJECTDIR}/driver/source/i2c.o.d ${OBJECTDIR}/driver/source/rtc.o.d ${OBJECTDIR}/driver/source/systick.o.d ${OBJECTDIR}/driver/source/lld_i2c1.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o.d ${OBJECTDIR}/esolid-base/src/debug.o.d ${OBJECTDIR}/esolid-base/src/error.o.d ${OBJECTDIR}/esolid-base/src/prio_queue.o.d ${OBJECTDIR}/esolid-base/src/base.o.d ${OBJECTDIR}/esolid-eds/src/smp.o.d ${OBJECTDIR}/esolid-eds/src/event.o.d ${OBJECTDIR}/esolid-eds/src/epa.o.d ${OBJECTDIR}/esolid-mem/src/mem_class.o.d ${OBJECTDIR}/esolid-mem/src/heap.o.d ${OBJECTDIR}/esolid-mem/src/static.o.d ${OBJECTDIR}/esolid-mem/src/pool.o.d ${OBJECTDIR}/esolid-vtimer/src/vtimer.o.d ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o.d ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o.d ${OBJECTDIR}/lib/checksum/checksum.o.d ${OBJECTDIR}/mla/source/common/TimeDelay.o.d ${OBJECTDIR}/mla/source/MDDFS/FSIO.o.d ${OBJECTDIR}/mla/source/USB/usb_host.o.d ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o.d ${OBJECTDIR}/mla/source/USB/usb_host_msd.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/application/source/main.o ${OBJECTDIR}/application/source/app_config.o ${OBJECTDIR}/application/source/app_usb.o ${OBJECTDIR}/application/source/app_psensor.o ${OBJECTDIR}/application/source/app_motor.o ${OBJECTDIR}/application/source/app_battery.o ${OBJECTDIR}/application/source/app_buzzer.o ${OBJECTDIR}/application/source/support.o ${OBJECTDIR}/application/source/epa_gui.o ${OBJECTDIR}/application/source/app_time.o ${OBJECTDIR}/application/source/logo.o ${OBJECTDIR}/application/source/app_storage.o ${OBJECTDIR}/application/source/app_timer.o ${OBJECTDIR}/application/source/app_data_log.o ${OBJECTDIR}/application/source/app_user.o ${OBJECTDIR}/application/source/app_gpu.o ${OBJECTDIR}/application/source/epa_touch.o ${OBJECTDIR}/application/source/epa_test.o ${OBJECTDIR}/application/source/epa_export.o ${OBJECTDIR}/application/source/app_pdetector.o ${OBJECTDIR}/application/source/app_string.o ${OBJECTDIR}/application/source/app_curve.o ${OBJECTDIR}/application/source/app_predict.o ${OBJECTDIR}/application/source/app_leak.o ${OBJECTDIR}/application/source/app_pump.o ${OBJECTDIR}/driver/source/lld_spis.o ${OBJECTDIR}/driver/source/lld_spi1.o ${OBJECTDIR}/driver/source/spi.o ${OBJECTDIR}/driver/source/lld_spi2.o ${OBJECTDIR}/driver/source/clock.o ${OBJECTDIR}/driver/source/gpio.o ${OBJECTDIR}/driver/source/intr.o ${OBJECTDIR}/driver/source/adc.o ${OBJECTDIR}/driver/source/pwm.o ${OBJECTDIR}/driver/source/s25fl.o ${OBJECTDIR}/driver/source/i2c.o ${OBJECTDIR}/driver/source/rtc.o ${OBJECTDIR}/driver/source/systick.o ${OBJECTDIR}/driver/source/lld_i2c1.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o ${OBJECTDIR}/esolid-base/src/debug.o ${OBJECTDIR}/esolid-base/src/error.o ${OBJECTDIR}/esolid-base/src/prio_queue.o ${OBJECTDIR}/esolid-base/src/base.o ${OBJECTDIR}/esolid-eds/src/smp.o ${OBJECTDIR}/esolid-eds/src/event.o ${OBJECTDIR}/esolid-eds/src/epa.o ${OBJECTDIR}/esolid-mem/src/mem_class.o ${OBJECTDIR}/esolid-mem/src/heap.o ${OBJECTDIR}/esolid-mem/src/static.o ${OBJECTDIR}/esolid-mem/src/pool.o ${OBJECTDIR}/esolid-vtimer/src/vtimer.o ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o ${OBJECTDIR}/lib/checksum/checksum.o ${OBJECTDIR}/lib/delta/delta.o ${OBJECTDIR}/mla/source/common/TimeDelay.o ${OBJECTDIR}/mla/source/MDDFS/FSIO.o ${OBJECTDIR}/mla/source/USB/usb_host.o ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o ${OBJECTDIR}/mla/source/USB/usb_host_msd.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/application/source/main.o.d ${OBJECTDIR}/application/source/app_config.o.d ${OBJECTDIR}/application/source/app_usb.o.d ${OBJECTDIR}/application/source/app_psensor.o.d ${OBJECTDIR}/application/source/app_motor.o.d ${OBJECTDIR}/application/source/app_battery.o.d ${OBJECTDIR}/application/source/app_buzzer.o.d ${OBJECTDIR}/application/source/support.o.d ${OBJECTDIR}/application/source/epa_gui.o.d ${OBJECTDIR}/application/source/app_time.o.d ${OBJECTDIR}/application/source/logo.o.d ${OBJECTDIR}/application/source/app_storage.o.d ${OBJECTDIR}/application/source/app_timer.o.d ${OBJECTDIR}/application/source/app_data_log.o.d ${OBJECTDIR}/application/source/app_user.o.d ${OBJECTDIR}/application/source/app_gpu.o.d ${OBJECTDIR}/application/source/epa_touch.o.d ${OBJECTDIR}/application/source/epa_test.o.d ${OBJECTDIR}/application/source/epa_export.o.d ${OBJECTDIR}/application/source/app_pdetector.o.d ${OBJECTDIR}/application/source/app_string.o.d ${OBJECTDIR}/application/source/app_curve.o.d ${OBJECTDIR}/application/source/app_predict.o.d ${OBJECTDIR}/application/source/app_leak.o.d ${OBJECTDIR}/application/source/app_pump.o.d ${OBJECTDIR}/driver/source/lld_spis.o.d ${OBJECTDIR}/driver/source/lld_spi1.o.d ${OBJECTDIR}/driver/source/spi.o.d ${OBJECTDIR}/driver/source/lld_spi2.o.d ${OBJECTDIR}/driver/source/clock.o.d ${OBJECTDIR}/driver/source/gpio.o.d ${OBJECTDIR}/driver/source/intr.o.d ${OBJECTDIR}/driver/source/adc.o.d ${OBJECTDIR}/driver/source/pwm.o.d ${OBJECTDIR}/driver/source/s25fl.o.d ${OBJECTDIR}/driver/source/i2c.o.d ${OBJECTDIR}/driver/source/rtc.o.d ${OBJECTDIR}/driver/source/systick.o.d ${OBJECTDIR}/driver/source/lld_i2c1.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o.d ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o.d ${OBJECTDIR}/esolid-base/src/debug.o.d ${OBJECTDIR}/esolid-base/src/error.o.d ${OBJECTDIR}/esolid-base/src/prio_queue.o.d ${OBJECTDIR}/esolid-base/src/base.o.d ${OBJECTDIR}/esolid-eds/src/smp.o.d ${OBJECTDIR}/esolid-eds/src/event.o.d ${OBJECTDIR}/esolid-eds/src/epa.o.d ${OBJECTDIR}/esolid-mem/src/mem_class.o.d ${OBJECTDIR}/esolid-mem/src/heap.o.d ${OBJECTDIR}/esolid-mem/src/static.o.d ${OBJECTDIR}/esolid-mem/src/pool.o.d ${OBJECTDIR}/esolid-vtimer/src/vtimer.o.d ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o.d ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o.d ${OBJECTDIR}/lib/checksum/checksum.o.d ${OBJECTDIR}/lib/delta/delta.o.d ${OBJECTDIR}/mla/source/common/TimeDelay.o.d ${OBJECTDIR}/mla/source/MDDFS/FSIO.o.d ${OBJECTDIR}/mla/source/USB/usb_host.o.d ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o.d ${OBJECTDIR}/mla/source/USB/usb_host_msd.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/application/source/main.o ${OBJECTDIR}/application/source/app_config.o ${OBJECTDIR}/application/source/app_usb.o ${OBJECTDIR}/application/source/app_psensor.o ${OBJECTDIR}/application/source/app_motor.o ${OBJECTDIR}/application/source/app_battery.o ${OBJECTDIR}/application/source/app_buzzer.o ${OBJECTDIR}/application/source/support.o ${OBJECTDIR}/application/source/epa_gui.o ${OBJECTDIR}/application/source/app_time.o ${OBJECTDIR}/application/source/logo.o ${OBJECTDIR}/application/source/app_storage.o ${OBJECTDIR}/application/source/app_timer.o ${OBJECTDIR}/application/source/app_data_log.o ${OBJECTDIR}/application/source/app_user.o ${OBJECTDIR}/application/source/app_gpu.o ${OBJECTDIR}/application/source/epa_touch.o ${OBJECTDIR}/application/source/app_pdetector.o ${OBJECTDIR}/application/source/app_string.o ${OBJECTDIR}/driver/source/lld_spis.o ${OBJECTDIR}/driver/source/lld_spi1.o ${OBJECTDIR}/driver/source/spi.o ${OBJECTDIR}/driver/source/lld_spi2.o ${OBJECTDIR}/driver/source/clock.o ${OBJECTDIR}/driver/source/gpio.o ${OBJECTDIR}/driver/source/intr.o ${OBJECTDIR}/driver/source/adc.o ${OBJECTDIR}/driver/source/s25fl.o ${OBJECTDIR}/driver/source/i2c.o ${OBJECTDIR}/driver/source/rtc.o ${OBJECTDIR}/driver/source/systick.o ${OBJECTDIR}/driver/source/lld_i2c1.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o ${OBJECTDIR}/esolid-base/src/debug.o ${OBJECTDIR}/esolid-base/src/error.o ${OBJECTDIR}/esolid-base/src/prio_queue.o ${OBJECTDIR}/esolid-base/src/base.o ${OBJECTDIR}/esolid-eds/src/smp.o ${OBJECTDIR}/esolid-eds/src/event.o ${OBJECTDIR}/esolid-eds/src/epa.o ${OBJECTDIR}/esolid-mem/src/mem_class.o ${OBJECTDIR}/esolid-mem/src/heap.o ${OBJECTDIR}/esolid-mem/src/static.o ${OBJECTDIR}/esolid-mem/src/pool.o ${OBJECTDIR}/esolid-vtimer/src/vtimer.o ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o ${OBJECTDIR}/lib/checksum/checksum.o ${OBJECTDIR}/mla/source/common/TimeDelay.o ${OBJECTDIR}/mla/source/MDDFS/FSIO.o ${OBJECTDIR}/mla/source/USB/usb_host.o ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o ${OBJECTDIR}/mla/source/USB/usb_host_msd.o
+OBJECTFILES=${OBJECTDIR}/application/source/main.o ${OBJECTDIR}/application/source/app_config.o ${OBJECTDIR}/application/source/app_usb.o ${OBJECTDIR}/application/source/app_psensor.o ${OBJECTDIR}/application/source/app_motor.o ${OBJECTDIR}/application/source/app_battery.o ${OBJECTDIR}/application/source/app_buzzer.o ${OBJECTDIR}/application/source/support.o ${OBJECTDIR}/application/source/epa_gui.o ${OBJECTDIR}/application/source/app_time.o ${OBJECTDIR}/application/source/logo.o ${OBJECTDIR}/application/source/app_storage.o ${OBJECTDIR}/application/source/app_timer.o ${OBJECTDIR}/application/source/app_data_log.o ${OBJECTDIR}/application/source/app_user.o ${OBJECTDIR}/application/source/app_gpu.o ${OBJECTDIR}/application/source/epa_touch.o ${OBJECTDIR}/application/source/epa_test.o ${OBJECTDIR}/application/source/epa_export.o ${OBJECTDIR}/application/source/app_pdetector.o ${OBJECTDIR}/application/source/app_string.o ${OBJECTDIR}/application/source/app_curve.o ${OBJECTDIR}/application/source/app_predict.o ${OBJECTDIR}/application/source/app_leak.o ${OBJECTDIR}/application/source/app_pump.o ${OBJECTDIR}/driver/source/lld_spis.o ${OBJECTDIR}/driver/source/lld_spi1.o ${OBJECTDIR}/driver/source/spi.o ${OBJECTDIR}/driver/source/lld_spi2.o ${OBJECTDIR}/driver/source/clock.o ${OBJECTDIR}/driver/source/gpio.o ${OBJECTDIR}/driver/source/intr.o ${OBJECTDIR}/driver/source/adc.o ${OBJECTDIR}/driver/source/pwm.o ${OBJECTDIR}/driver/source/s25fl.o ${OBJECTDIR}/driver/source/i2c.o ${OBJECTDIR}/driver/source/rtc.o ${OBJECTDIR}/driver/source/systick.o ${OBJECTDIR}/driver/source/lld_i2c1.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/cpu.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/intr.o ${OBJECTDIR}/esolid-base/port/pic32-none-gcc/mips-m4k/systimer.o ${OBJECTDIR}/esolid-base/src/debug.o ${OBJECTDIR}/esolid-base/src/error.o ${OBJECTDIR}/esolid-base/src/prio_queue.o ${OBJECTDIR}/esolid-base/src/base.o ${OBJECTDIR}/esolid-eds/src/smp.o ${OBJECTDIR}/esolid-eds/src/event.o ${OBJECTDIR}/esolid-eds/src/epa.o ${OBJECTDIR}/esolid-mem/src/mem_class.o ${OBJECTDIR}/esolid-mem/src/heap.o ${OBJECTDIR}/esolid-mem/src/static.o ${OBJECTDIR}/esolid-mem/src/pool.o ${OBJECTDIR}/esolid-vtimer/src/vtimer.o ${OBJECTDIR}/ft800/source/FT_CoPro_Cmds.o ${OBJECTDIR}/ft800/source/FT_Gpu_Hal.o ${OBJECTDIR}/lib/checksum/checksum.o ${OBJECTDIR}/lib/delta/delta.o ${OBJECTDIR}/mla/source/common/TimeDelay.o ${OBJECTDIR}/mla/source/MDDFS/FSIO.o ${OBJECTDIR}/mla/source/USB/usb_host.o ${OBJECTDIR}/mla/source/USB/usb_host_msd_scsi.o ${OBJECTDIR}/mla/source/USB/usb_host_msd.o
 
 # Source Files
-SOURCEFILES=application/source/main.c application/source/app_config.c application/source/app_usb.c application/source/app_psensor.c application/source/app_motor.c application/source/app_battery.c application/source/app_buzzer.c application/source/support.c application/source/epa_gui.c application/source/app_time.c application/source/logo.c application/source/app_storage.c application/source/app_timer.c application/source/app_data_log.c application/source/app_user.c application/source/app_gpu.c application/source/epa_touch.c application/source/app_pdetector.c application/source/app_string.c driver/source/lld_spis.c driver/source/lld_spi1.c driver/source/spi.c driver/source/lld_spi2.c driver/source/clock.c driver/source/gpio.c driver/source/intr.c driver/source/adc.c driver/source/s25fl.c driver/source/i2c.c driver/source/rtc.c driver/source/systick.c driver/source/lld_i2c1.c esolid-base/port/pic32-none-gcc/mips-m4k/cpu.c esolid-base/port/pic32-none-gcc/mips-m4k/intr.c esolid-base/port/pic32-none-gcc/mips-m4k/systimer.c esolid-base/src/debug.c esolid-base/src/error.c esolid-base/src/prio_queue.c esolid-base/src/base.c esolid-eds/src/smp.c esolid-eds/src/event.c esolid-eds/src/epa.c esolid-mem/src/mem_class.c esolid-mem/src/heap.c esolid-mem/src/static.c esolid-mem/src/pool.c esolid-vtimer/src/vtimer.c ft800/source/FT_CoPro_Cmds.c ft800/source/FT_Gpu_Hal.c lib/checksum/checksum.c mla/source/common/TimeDelay.c mla/source/MDDFS/FSIO.c mla/source/USB/usb_host.c mla/source/USB/usb_host_msd_scsi.c mla/source/USB/usb_host_msd.c
+SOURCEFILES=application/source/main.c application/source/app_config.c application/source/app_usb.c application/source/app_psensor.c application/source/app_motor.c application/source/app_battery.c application/source/app_buzzer.c application/source/support.c application/source/epa_gui.c application/source/app_time.c application/source/logo.c application/source/app_storage.c application/source/app_timer.c application/source/app_data_log.c application/source/app_user.c application/source/app_gpu.c application/source/epa_touch.c application/source/epa_test.c application/source/epa_export.c application/source/app_pdetector.c application/source/app_string.c application/source/app_curve.c application/source/app_predict.c application/source/app_leak.c application/source/app_pump.c driver/source/lld_spis.c driver/source/lld_spi1.c driver/source/spi.c driver/source/lld_spi2.c driver/source/clock.c driver/source/gpio.c driver/source/intr.c driver/source/adc.c driver/source/pwm.c driver/source/s25fl.c driver/source/i2c.c driver/source/rtc.c driver/source/systick.c driver/source/lld_i2c1.c esolid-base/port/pic32-none-gcc/mips-m4k/cpu.c esolid-base/port/pic32-none-gcc/mips-m4k/intr.c esolid-base/port/pic32-none-gcc/mips-m4k/systimer.c esolid-base/src/debug.c esolid-base/src/error.c esolid-base/src/prio_queue.c esolid-base/src/base.c esolid-eds/src/smp.c esolid-eds/src/event.c esolid-eds/src/epa.c esolid-mem/src/mem_class.c esolid-mem/src/heap.c esolid-mem/src/static.c esolid-mem/src/pool.c esolid-vtimer/src/vtimer.c ft800/source/FT_CoPro_Cmds.c ft800/source/FT_Gpu_Hal.c lib/checksum/checksum.c lib/delta/delta.c mla/source/common/TimeDelay.c mla/source/MDDFS/FSIO.c mla/source/USB/usb_host.c mla/source/USB/usb_host_msd_scsi.c mla/source/USB/usb_host_msd.c
 
 
 CFLAGS=
@@ -193,6 +193,18 @@ ${OBJECTDIR}/application/source/epa_touch.o: application/source/epa_touch.c  nbp
 	@${RM} ${OBJECTDIR}/application/source/epa_touch.o 
 	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_touch.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_touch.o.d" -o ${OBJECTDIR}/application/source/epa_touch.o application/source/epa_touch.c   
 	
+${OBJECTDIR}/application/source/epa_test.o: application/source/epa_test.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/epa_test.o.d 
+	@${RM} ${OBJECTDIR}/application/source/epa_test.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_test.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_test.o.d" -o ${OBJECTDIR}/application/source/epa_test.o application/source/epa_test.c   
+	
+${OBJECTDIR}/application/source/epa_export.o: application/source/epa_export.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/epa_export.o.d 
+	@${RM} ${OBJECTDIR}/application/source/epa_export.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_export.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_export.o.d" -o ${OBJECTDIR}/application/source/epa_export.o application/source/epa_export.c   
+	
 ${OBJECTDIR}/application/source/app_pdetector.o: application/source/app_pdetector.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/application/source 
 	@${RM} ${OBJECTDIR}/application/source/app_pdetector.o.d 
@@ -205,6 +217,30 @@ ${OBJECTDIR}/application/source/app_string.o: application/source/app_string.c  n
 	@${RM} ${OBJECTDIR}/application/source/app_string.o 
 	@${FIXDEPS} "${OBJECTDIR}/application/source/app_string.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_string.o.d" -o ${OBJECTDIR}/application/source/app_string.o application/source/app_string.c   
 	
+${OBJECTDIR}/application/source/app_curve.o: application/source/app_curve.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_curve.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_curve.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_curve.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_curve.o.d" -o ${OBJECTDIR}/application/source/app_curve.o application/source/app_curve.c   
+	
+${OBJECTDIR}/application/source/app_predict.o: application/source/app_predict.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_predict.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_predict.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_predict.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_predict.o.d" -o ${OBJECTDIR}/application/source/app_predict.o application/source/app_predict.c   
+	
+${OBJECTDIR}/application/source/app_leak.o: application/source/app_leak.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_leak.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_leak.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_leak.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_leak.o.d" -o ${OBJECTDIR}/application/source/app_leak.o application/source/app_leak.c   
+	
+${OBJECTDIR}/application/source/app_pump.o: application/source/app_pump.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_pump.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_pump.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_pump.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_pump.o.d" -o ${OBJECTDIR}/application/source/app_pump.o application/source/app_pump.c   
+	
 ${OBJECTDIR}/driver/source/lld_spis.o: driver/source/lld_spis.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/driver/source 
 	@${RM} ${OBJECTDIR}/driver/source/lld_spis.o.d 
@@ -253,6 +289,12 @@ ${OBJECTDIR}/driver/source/adc.o: driver/source/adc.c  nbproject/Makefile-${CND_
 	@${RM} ${OBJECTDIR}/driver/source/adc.o 
 	@${FIXDEPS} "${OBJECTDIR}/driver/source/adc.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/driver/source/adc.o.d" -o ${OBJECTDIR}/driver/source/adc.o driver/source/adc.c   
 	
+${OBJECTDIR}/driver/source/pwm.o: driver/source/pwm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/driver/source 
+	@${RM} ${OBJECTDIR}/driver/source/pwm.o.d 
+	@${RM} ${OBJECTDIR}/driver/source/pwm.o 
+	@${FIXDEPS} "${OBJECTDIR}/driver/source/pwm.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/driver/source/pwm.o.d" -o ${OBJECTDIR}/driver/source/pwm.o driver/source/pwm.c   
+	
 ${OBJECTDIR}/driver/source/s25fl.o: driver/source/s25fl.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/driver/source 
 	@${RM} ${OBJECTDIR}/driver/source/s25fl.o.d 
@@ -391,6 +433,12 @@ ${OBJECTDIR}/lib/checksum/checksum.o: lib/checksum/checksum.c  nbproject/Makefil
 	@${RM} ${OBJECTDIR}/lib/checksum/checksum.o 
 	@${FIXDEPS} "${OBJECTDIR}/lib/checksum/checksum.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/lib/checksum/checksum.o.d" -o ${OBJECTDIR}/lib/checksum/checksum.o lib/checksum/checksum.c   
 	
+${OBJECTDIR}/lib/delta/delta.o: lib/delta/delta.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/lib/delta 
+	@${RM} ${OBJECTDIR}/lib/delta/delta.o.d 
+	@${RM} ${OBJECTDIR}/lib/delta/delta.o 
+	@${FIXDEPS} "${OBJECTDIR}/lib/delta/delta.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/lib/delta/delta.o.d" -o ${OBJECTDIR}/lib/delta/delta.o lib/delta/delta.c   
+	
 ${OBJECTDIR}/mla/source/common/TimeDelay.o: mla/source/common/TimeDelay.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/mla/source/common 
 	@${RM} ${OBJECTDIR}/mla/source/common/TimeDelay.o.d 
@@ -524,6 +572,18 @@ ${OBJECTDIR}/application/source/epa_touch.o: application/source/epa_touch.c  nbp
 	@${RM} ${OBJECTDIR}/application/source/epa_touch.o 
 	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_touch.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_touch.o.d" -o ${OBJECTDIR}/application/source/epa_touch.o application/source/epa_touch.c   
 	
+${OBJECTDIR}/application/source/epa_test.o: application/source/epa_test.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/epa_test.o.d 
+	@${RM} ${OBJECTDIR}/application/source/epa_test.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_test.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_test.o.d" -o ${OBJECTDIR}/application/source/epa_test.o application/source/epa_test.c   
+	
+${OBJECTDIR}/application/source/epa_export.o: application/source/epa_export.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/epa_export.o.d 
+	@${RM} ${OBJECTDIR}/application/source/epa_export.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/epa_export.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/epa_export.o.d" -o ${OBJECTDIR}/application/source/epa_export.o application/source/epa_export.c   
+	
 ${OBJECTDIR}/application/source/app_pdetector.o: application/source/app_pdetector.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/application/source 
 	@${RM} ${OBJECTDIR}/application/source/app_pdetector.o.d 
@@ -536,6 +596,30 @@ ${OBJECTDIR}/application/source/app_string.o: application/source/app_string.c  n
 	@${RM} ${OBJECTDIR}/application/source/app_string.o 
 	@${FIXDEPS} "${OBJECTDIR}/application/source/app_string.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_string.o.d" -o ${OBJECTDIR}/application/source/app_string.o application/source/app_string.c   
 	
+${OBJECTDIR}/application/source/app_curve.o: application/source/app_curve.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_curve.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_curve.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_curve.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_curve.o.d" -o ${OBJECTDIR}/application/source/app_curve.o application/source/app_curve.c   
+	
+${OBJECTDIR}/application/source/app_predict.o: application/source/app_predict.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_predict.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_predict.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_predict.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_predict.o.d" -o ${OBJECTDIR}/application/source/app_predict.o application/source/app_predict.c   
+	
+${OBJECTDIR}/application/source/app_leak.o: application/source/app_leak.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_leak.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_leak.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_leak.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_leak.o.d" -o ${OBJECTDIR}/application/source/app_leak.o application/source/app_leak.c   
+	
+${OBJECTDIR}/application/source/app_pump.o: application/source/app_pump.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/application/source 
+	@${RM} ${OBJECTDIR}/application/source/app_pump.o.d 
+	@${RM} ${OBJECTDIR}/application/source/app_pump.o 
+	@${FIXDEPS} "${OBJECTDIR}/application/source/app_pump.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/application/source/app_pump.o.d" -o ${OBJECTDIR}/application/source/app_pump.o application/source/app_pump.c   
+	
 ${OBJECTDIR}/driver/source/lld_spis.o: driver/source/lld_spis.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/driver/source 
 	@${RM} ${OBJECTDIR}/driver/source/lld_spis.o.d 
@@ -584,6 +668,12 @@ ${OBJECTDIR}/driver/source/adc.o: driver/source/adc.c  nbproject/Makefile-${CND_
 	@${RM} ${OBJECTDIR}/driver/source/adc.o 
 	@${FIXDEPS} "${OBJECTDIR}/driver/source/adc.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/driver/source/adc.o.d" -o ${OBJECTDIR}/driver/source/adc.o driver/source/adc.c   
 	
+${OBJECTDIR}/driver/source/pwm.o: driver/source/pwm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/driver/source 
+	@${RM} ${OBJECTDIR}/driver/source/pwm.o.d 
+	@${RM} ${OBJECTDIR}/driver/source/pwm.o 
+	@${FIXDEPS} "${OBJECTDIR}/driver/source/pwm.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/driver/source/pwm.o.d" -o ${OBJECTDIR}/driver/source/pwm.o driver/source/pwm.c   
+	
 ${OBJECTDIR}/driver/source/s25fl.o: driver/source/s25fl.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/driver/source 
 	@${RM} ${OBJECTDIR}/driver/source/s25fl.o.d 
@@ -722,6 +812,12 @@ ${OBJECTDIR}/lib/checksum/checksum.o: lib/checksum/checksum.c  nbproject/Makefil
 	@${RM} ${OBJECTDIR}/lib/checksum/checksum.o 
 	@${FIXDEPS} "${OBJECTDIR}/lib/checksum/checksum.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/lib/checksum/checksum.o.d" -o ${OBJECTDIR}/lib/checksum/checksum.o lib/checksum/checksum.c   
 	
+${OBJECTDIR}/lib/delta/delta.o: lib/delta/delta.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/lib/delta 
+	@${RM} ${OBJECTDIR}/lib/delta/delta.o.d 
+	@${RM} ${OBJECTDIR}/lib/delta/delta.o 
+	@${FIXDEPS} "${OBJECTDIR}/lib/delta/delta.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -mips16 -mno-float -Os -I"application/include" -I"application/include/config" -I"mla/include" -I"ft800/include" -I"driver/include" -I"esolid-base/inc" -I"esolid-base/port/pic32-none-gcc/common" -I"esolid-base/port/pic32-none-gcc/mips-m4k" -I"esolid-base/port/pic32-none-gcc/pic32mx250f128d" -I"esolid-vtimer/inc" -I"esolid-mem/inc" -I"esolid-eds/inc" -I"lib" -Wall -MMD -MF "${OBJECTDIR}/lib/delta/delta.o.d" -o ${OBJECTDIR}/lib/delta/delta.o lib/delta/delta.c   
+	
 ${OBJECTDIR}/mla/source/common/TimeDelay.o: mla/source/common/TimeDelay.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/mla/source/common 
 	@${RM} ${OBJECTDIR}/mla/source/common/TimeDelay.o.d 
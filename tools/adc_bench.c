@@ -0,0 +1,222 @@
+/*
+ * File:   adc_bench.c
+ *
+ * Host side benchmark of the ADC driver filter chain. The driver source is
+ * built unchanged against the host register file, see adc_test.c, and every
+ * filter setting is measured on synthetic sensor signals:
+ *
+ *     ENOB    steady levels between the converter codes with gaussian noise
+ *             and occasional spikes are quantised to 10 bits. The RMS error of
+ *             the filtered value against the true level gives the effective
+ *             number of bits, log2(1024 / (rms * sqrt(12))).
+ *     settle  conversions after a noiseless step until the filtered value
+ *             stays within one 10-bit code of the new level.
+ *     time    host time of one interrupt with a single channel enabled. On the
+ *             target the same figure in core timer ticks is returned by
+ *             adcGetIsrCycles().
+ *
+ * Build:
+ *     cc -std=c99 -O2 -Ihost -I../driver/include -o adc_bench \
+ *         adc_bench.c host/pic32.c ../driver/source/adc.c -lm
+ *
+ * Usage:
+ *     adc_bench [-n samples] [-s seed] [-r noise]
+ *
+ *     -n      conversions per level (default 4096)
+ *     -s      seed of the noise generator (default 1)
+ *     -r      RMS noise in 10-bit codes (default 1.5)
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xc.h"
+#include "driver/adc.h"
+
+#define CONFIG_DEF_SAMPLES              4096
+#define CONFIG_DEF_NOISE                1.5
+#define CONFIG_NUM_OF_LEVELS            64
+#define CONFIG_WARMUP_SAMPLES           256
+#define CONFIG_SPIKE_RATE               0.002
+#define CONFIG_SPIKE_AMPLITUDE          200.0
+#define CONFIG_STEP_FROM                200
+#define CONFIG_STEP_TO                  800
+#define CONFIG_STEP_SAMPLES             256
+#define CONFIG_TIMING_SAMPLES           1000000
+#define CONFIG_ADC_MAX                  1023
+#define CONFIG_CHANNEL_ID               5
+
+#define PI                              3.14159265358979323846
+
+struct setting {
+    const char *        name;
+    struct adcFilter    filter;
+};
+
+/*
+ * The first entry is the plain 8 sample average of the original driver, the
+ * last one is the setting used by the pressure sensor.
+ */
+static const struct setting Setting[] = {
+    {"average 8",       {3u, 0u, 0u, false}},
+    {"average 16",      {4u, 2u, 0u, false}},
+    {"median 16",       {4u, 2u, 0u, true }},
+    {"median 16 iir 2", {4u, 2u, 1u, true }},
+};
+
+#define NUM_OF_SETTINGS                 (sizeof(Setting) / sizeof(Setting[0]))
+
+void adcHandler(void);
+
+static double gaussian(void) {
+    double              u1;
+    double              u2;
+
+    u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+    return (sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2));
+}
+
+static uint32_t quantise(double level) {
+    long                code;
+
+    code = lround(level);
+
+    if (code < 0) {
+        code = 0;
+    } else if (code > CONFIG_ADC_MAX) {
+        code = CONFIG_ADC_MAX;
+    }
+
+    return ((uint32_t)code);
+}
+
+static double convert(const struct adcFilter * filter, double level) {
+    HostAdcBuf[0] = quantise(level);
+    adcHandler();
+
+    return ((double)adcReadChannel(CONFIG_CHANNEL_ID) / (double)(0x1u << filter->extraBits));
+}
+
+static void startChannel(const struct adcFilter * filter) {
+    initAdcDriver();
+    adcEnableChannel(CONFIG_CHANNEL_ID, NULL);
+    adcSetFilter(CONFIG_CHANNEL_ID, filter);
+}
+
+static double measureEnob(const struct adcFilter * filter, uint32_t nSamples, double noise) {
+    double              sumSquares;
+    uint32_t            level;
+
+    sumSquares = 0.0;
+
+    for (level = 0u; level < CONFIG_NUM_OF_LEVELS; level++) {
+        double          value;
+        uint32_t        cnt;
+
+        value = 100.0 + (800.0 * level) / CONFIG_NUM_OF_LEVELS + 0.37;
+        startChannel(filter);
+
+        for (cnt = 0u; cnt < (CONFIG_WARMUP_SAMPLES + nSamples); cnt++) {
+            double      sample;
+            double      error;
+
+            sample = value + noise * gaussian();
+
+            if (((double)rand() / RAND_MAX) < CONFIG_SPIKE_RATE) {
+                sample += (rand() & 0x1) ? CONFIG_SPIKE_AMPLITUDE : -CONFIG_SPIKE_AMPLITUDE;
+            }
+            error = convert(filter, sample) - value;
+
+            if (cnt >= CONFIG_WARMUP_SAMPLES) {
+                sumSquares += error * error;
+            }
+        }
+    }
+
+    return (log2((CONFIG_ADC_MAX + 1) / (sqrt(sumSquares / (CONFIG_NUM_OF_LEVELS * nSamples)) * sqrt(12.0))));
+}
+
+static uint32_t measureSettling(const struct adcFilter * filter) {
+    uint32_t            settled;
+    uint32_t            cnt;
+
+    startChannel(filter);
+    settled = 0u;
+
+    for (cnt = 0u; cnt < CONFIG_WARMUP_SAMPLES; cnt++) {
+        (void)convert(filter, CONFIG_STEP_FROM);
+    }
+
+    for (cnt = 0u; cnt < CONFIG_STEP_SAMPLES; cnt++) {
+
+        if (fabs(convert(filter, CONFIG_STEP_TO) - CONFIG_STEP_TO) > 1.0) {
+            settled = cnt + 1u;
+        }
+    }
+
+    return (settled);
+}
+
+static double measureTime(const struct adcFilter * filter) {
+    uint32_t            start;
+    uint32_t            cnt;
+
+    startChannel(filter);
+    start = hostCoreCount();
+
+    for (cnt = 0u; cnt < CONFIG_TIMING_SAMPLES; cnt++) {
+        HostAdcBuf[0] = cnt & CONFIG_ADC_MAX;
+        adcHandler();
+    }
+
+    return ((double)(hostCoreCount() - start) / CONFIG_TIMING_SAMPLES);
+}
+
+int main(int argc, char ** argv) {
+    uint32_t            nSamples;
+    uint32_t            seed;
+    uint32_t            cnt;
+    double              noise;
+    int                 arg;
+
+    nSamples = CONFIG_DEF_SAMPLES;
+    seed     = 1u;
+    noise    = CONFIG_DEF_NOISE;
+
+    for (arg = 1; (arg + 1) < argc; arg += 2) {
+
+        if (strcmp(argv[arg], "-n") == 0) {
+            nSamples = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        } else if (strcmp(argv[arg], "-s") == 0) {
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        } else if (strcmp(argv[arg], "-r") == 0) {
+            noise = strtod(argv[arg + 1], NULL);
+        } else {
+            break;
+        }
+    }
+
+    if ((arg != argc) || (nSamples == 0u)) {
+        fprintf(stderr, "usage: %s [-n samples] [-s seed] [-r noise]\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    printf("%-18s %6s %8s %8s\n", "filter", "ENOB", "settle", "ns/isr");
+
+    for (cnt = 0u; cnt < NUM_OF_SETTINGS; cnt++) {
+        double          enob;
+
+        srand(seed);
+        enob = measureEnob(&Setting[cnt].filter, nSamples, noise);
+        printf("%-18s %6.2f %8u %8.1f\n", Setting[cnt].name, enob, (unsigned)measureSettling(&Setting[cnt].filter),
+            measureTime(&Setting[cnt].filter));
+    }
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,233 @@
+/*
+ * File:   adc_test.c
+ *
+ * Host side test of the ADC driver averaging. The driver source is built
+ * unchanged against the host register file and random 10-bit samples are fed
+ * through its interrupt handler. After every conversion the value returned by
+ * adcReadChannel() is compared with the average computed the slow way over the
+ * last 2^windowShift samples, for every window length and number of extra
+ * bits. Several channels are scanned at once, so the mapping of result buffers
+ * to channels is checked too.
+ *
+ * The timebase test runs a decimated capture on one of the scanned channels
+ * and checks that the period measured from the sample timestamps equals the
+ * period adcSamplesToMs() reports. Every interrupt is a whole scan, so with
+ * several channels enabled a channel sample is several conversions apart.
+ *
+ * The running sum replaces the summing loop of adcReadChannel(). The ISR
+ * publishes the average as one aligned word, so a read can not observe a
+ * partly updated window and no sequence counter is needed.
+ *
+ * Build:
+ *     cc -std=c99 -O2 -Ihost -I../driver/include -o adc_test \
+ *         adc_test.c host/pic32.c ../driver/source/adc.c
+ *
+ * Usage:
+ *     adc_test [-n samples] [-s seed]
+ *
+ *     -n      conversions per filter setting (default 20000)
+ *     -s      seed of the sample generator (default 1)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xc.h"
+#include "driver/adc.h"
+
+#define CONFIG_DEF_SAMPLES              20000
+#define CONFIG_MAX_WINDOW_SHIFT         4
+#define CONFIG_ADC_MAX                  1023
+#define CONFIG_CAPTURE_DECIMATION       5
+#define CONFIG_CAPTURE_SIZE             64
+
+/*
+ * Channels are scanned in ascending order, the result of the n-th enabled
+ * channel is in the n-th result buffer.
+ */
+static const uint32_t ChannelId[] = {2, 5, 11};
+
+#define NUM_OF_CHANNELS                 (sizeof(ChannelId) / sizeof(ChannelId[0]))
+
+struct reference {
+    int32_t             history[0x1u << CONFIG_MAX_WINDOW_SHIFT];
+    uint32_t            count;
+};
+
+void adcHandler(void);
+
+/*
+ * Average of the last 2^windowShift samples with extraBits kept, the driver
+ * fills the window with the first sample after the filter is set.
+ */
+static int32_t referencePush(struct reference * reference, const struct adcFilter * filter, int32_t sample) {
+    int32_t             sum;
+    uint32_t            cnt;
+
+    if (reference->count == 0u) {
+
+        for (cnt = 0u; cnt < (0x1u << CONFIG_MAX_WINDOW_SHIFT); cnt++) {
+            reference->history[cnt] = sample;
+        }
+    }
+    memmove(&reference->history[1], &reference->history[0],
+        sizeof(reference->history) - sizeof(reference->history[0]));
+    reference->history[0] = sample;
+    reference->count++;
+    sum = 0;
+
+    for (cnt = 0u; cnt < (0x1u << filter->windowShift); cnt++) {
+        sum += reference->history[cnt];
+    }
+
+    return (sum >> (filter->windowShift - filter->extraBits));
+}
+
+static uint32_t runFilter(const struct adcFilter * filter, uint32_t nSamples) {
+    struct reference    reference[NUM_OF_CHANNELS];
+    uint32_t            nErrors;
+    uint32_t            sample;
+    uint32_t            channel;
+
+    initAdcDriver();
+    memset(reference, 0, sizeof(reference));
+
+    for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+        adcEnableChannel(ChannelId[channel], NULL);
+        adcSetFilter(ChannelId[channel], filter);
+    }
+    nErrors = 0u;
+
+    for (sample = 0u; sample < nSamples; sample++) {
+        int32_t         expected[NUM_OF_CHANNELS];
+
+        for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+            int32_t     value;
+
+            value = rand() % (CONFIG_ADC_MAX + 1);
+            HostAdcBuf[channel * 4u] = (uint32_t)value;
+            expected[channel] = referencePush(&reference[channel], filter, value);
+        }
+        adcHandler();
+
+        for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+            int32_t     actual;
+
+            actual = adcReadChannel(ChannelId[channel]);
+
+            if (actual != expected[channel]) {
+
+                if (nErrors < 5u) {
+                    fprintf(stderr, "window %u, extra %u: channel %u sample %u: read %d, expected %d\n",
+                        1u << filter->windowShift, (unsigned)filter->extraBits, (unsigned)ChannelId[channel],
+                        (unsigned)sample, (int)actual, (int)expected[channel]);
+                }
+                nErrors++;
+            }
+        }
+    }
+
+    for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+        adcDisableChannel(ChannelId[channel]);
+    }
+
+    return (nErrors);
+}
+
+static uint32_t runTimebase(void) {
+    struct adcCapture   capture;
+    struct adcSample    buffer[CONFIG_CAPTURE_SIZE];
+    struct adcSample    samples[CONFIG_CAPTURE_SIZE];
+    uint32_t            nSamples;
+    uint32_t            measuredMs;
+    uint32_t            expectedMs;
+    uint32_t            channel;
+    uint32_t            cnt;
+    uint32_t            start;
+
+    initAdcDriver();
+
+    for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+        adcEnableChannel(ChannelId[channel], NULL);
+    }
+    adcCaptureInit(&capture, buffer, CONFIG_CAPTURE_SIZE);
+    adcCaptureSetDecimation(&capture, CONFIG_CAPTURE_DECIMATION);
+    adcStartCapture(ChannelId[0], &capture);
+    start = adcGetTimestamp();
+
+    for (cnt = 0u; cnt < (CONFIG_CAPTURE_SIZE * CONFIG_CAPTURE_DECIMATION); cnt++) {
+        adcHandler();
+    }
+    adcStopCapture(ChannelId[0]);
+    nSamples   = adcCaptureRead(&capture, samples, CONFIG_CAPTURE_SIZE);
+    measuredMs = adcTimestampToMs(samples[nSamples - 1u].timestamp - samples[0].timestamp) / (nSamples - 1u);
+    expectedMs = adcSamplesToMs(CONFIG_CAPTURE_DECIMATION);
+    printf("capture period %u ms, expected %u ms, %u conversions in %u interrupts: %s\n", (unsigned)measuredMs,
+        (unsigned)expectedMs, (unsigned)(adcGetTimestamp() - start), (unsigned)cnt,
+        measuredMs == expectedMs ? "ok" : "FAILED");
+
+    for (channel = 0u; channel < NUM_OF_CHANNELS; channel++) {
+        adcDisableChannel(ChannelId[channel]);
+    }
+
+    if ((measuredMs != expectedMs) ||
+        (measuredMs != (CONFIG_CAPTURE_DECIMATION * NUM_OF_CHANNELS)) ||
+        ((adcGetTimestamp() - start) != (cnt * NUM_OF_CHANNELS))) {
+
+        return (1u);
+    }
+
+    return (0u);
+}
+
+int main(int argc, char ** argv) {
+    struct adcFilter    filter;
+    uint32_t            nSamples;
+    uint32_t            nFailed;
+    int                 arg;
+
+    nSamples = CONFIG_DEF_SAMPLES;
+    srand(1);
+
+    for (arg = 1; (arg + 1) < argc; arg += 2) {
+
+        if (strcmp(argv[arg], "-n") == 0) {
+            nSamples = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        } else if (strcmp(argv[arg], "-s") == 0) {
+            srand((unsigned)strtoul(argv[arg + 1], NULL, 10));
+        } else {
+            break;
+        }
+    }
+
+    if (arg != argc) {
+        fprintf(stderr, "usage: %s [-n samples] [-s seed]\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    nFailed                = 0u;
+    filter.iirShift        = 0u;
+    filter.isMedianEnabled = false;
+    printf("%-8s %-6s %10s %s\n", "window", "extra", "samples", "result");
+
+    for (filter.windowShift = 0u; filter.windowShift <= CONFIG_MAX_WINDOW_SHIFT; filter.windowShift++) {
+
+        for (filter.extraBits = 0u; filter.extraBits <= filter.windowShift; filter.extraBits++) {
+            uint32_t    nErrors;
+
+            nErrors = runFilter(&filter, nSamples);
+            printf("%-8u %-6u %10u %s\n", 1u << filter.windowShift, (unsigned)filter.extraBits,
+                (unsigned)nSamples, nErrors == 0u ? "ok" : "FAILED");
+
+            if (nErrors != 0u) {
+                nFailed++;
+            }
+        }
+    }
+    nFailed += runTimebase();
+
+    return (nFailed == 0u ? EXIT_SUCCESS : EXIT_FAILURE);
+}
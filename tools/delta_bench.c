@@ -0,0 +1,309 @@
+/*
+ * File:   delta_bench.c
+ *
+ * Host side test and benchmark of the delta encoding used for the pump-down
+ * curves of the log.
+ *
+ * The test encodes and decodes random, constant, ramp and full scale jump
+ * signals of every length up to the curve limit. Every decoded signal must be
+ * equal to the original, and encoding into a buffer one byte shorter than
+ * needed must fail.
+ *
+ * The benchmark encodes synthetic pump-down curves, 12-bit raw vacuum with
+ * noise sampled every period ms, and reports the encoded bytes per point, the
+ * ratio against plain 16-bit points, how many points are left after merging
+ * them the way appDataLogSetCurve() does until the curve fits into the log
+ * entry payload, and the host time of encoding and decoding.
+ *
+ * Build:
+ *     cc -std=c99 -O2 -I../lib -o delta_bench delta_bench.c \
+ *         ../lib/delta/delta.c -lm
+ *
+ * Usage:
+ *     delta_bench [-n curves] [-s seed] [-r noise]
+ *
+ *     -n      benchmark curves (default 1000)
+ *     -s      seed of the signal generator (default 1)
+ *     -r      RMS noise of the curves in raw codes (default 2.0)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "delta/delta.h"
+
+#define CONFIG_CURVE_SIZE               96                                      /* CONFIG_DATA_LOG_CURVE_SIZE                               */
+#define CONFIG_CURVE_POINTS             128                                     /* CONFIG_DATA_LOG_CURVE_POINTS                             */
+#define CONFIG_DEF_CURVES               1000
+#define CONFIG_DEF_NOISE                2.0
+#define CONFIG_RAW_MAX                  4095
+#define CONFIG_RAW_IDLE                 1080
+#define CONFIG_RAW_VACUUM               250
+#define CONFIG_TEST_LENGTHS             (CONFIG_CURVE_POINTS * 4)
+
+#define PI                              3.14159265358979323846
+
+enum signal {
+    SIGNAL_RANDOM,
+    SIGNAL_CONSTANT,
+    SIGNAL_RAMP,
+    SIGNAL_JUMP,
+    LAST_SIGNAL
+};
+
+static const char * const SignalName[] = {
+    "random",
+    "constant",
+    "ramp",
+    "jump"
+};
+
+static double gaussian(void) {
+    double              u1;
+    double              u2;
+
+    u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+    return (sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2));
+}
+
+static uint64_t hostNs(void) {
+    struct timespec     now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec);
+}
+
+static void makeSignal(enum signal signal, uint16_t * samples, size_t nSamples) {
+    size_t              cnt;
+
+    for (cnt = 0u; cnt < nSamples; cnt++) {
+
+        switch (signal) {
+            case SIGNAL_RANDOM: {
+                samples[cnt] = (uint16_t)(((unsigned)rand() << 8) ^ (unsigned)rand());
+                break;
+            }
+            case SIGNAL_CONSTANT: {
+                samples[cnt] = 0x1234u;
+                break;
+            }
+            case SIGNAL_RAMP: {
+                samples[cnt] = (uint16_t)(cnt * 37u);
+                break;
+            }
+            default: {
+                samples[cnt] = (cnt % 2u) != 0u ? 0xffffu : 0x0000u;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Vacuum falls from the idle level towards the pump limit with a random time
+ * constant, the way the tester records it.
+ */
+static void makeCurve(uint16_t * samples, size_t nSamples, double noise) {
+    double              tau;
+    size_t              cnt;
+
+    tau = 10.0 + 30.0 * ((double)rand() / RAND_MAX);
+
+    for (cnt = 0u; cnt < nSamples; cnt++) {
+        double          value;
+
+        value = CONFIG_RAW_VACUUM + (CONFIG_RAW_IDLE - CONFIG_RAW_VACUUM) * exp(-(double)cnt / tau);
+        value = floor(value + noise * gaussian() + 0.5);
+
+        if (value < 0.0) {
+            value = 0.0;
+        } else if (value > CONFIG_RAW_MAX) {
+            value = CONFIG_RAW_MAX;
+        }
+        samples[cnt] = (uint16_t)value;
+    }
+}
+
+/*
+ * Same merge as appDataLogSetCurve(): neighbouring points are merged keeping
+ * the higher value and an odd last point is kept, until the curve fits.
+ */
+static size_t fitCurve(uint16_t * points, size_t nPoints) {
+    uint8_t             buffer[CONFIG_CURVE_SIZE];
+
+    while ((nPoints > 1u) && (deltaEncode(points, nPoints, buffer, sizeof(buffer)) == 0u)) {
+        size_t          cnt;
+
+        for (cnt = 0u; cnt < (nPoints / 2u); cnt++) {
+            points[cnt] = points[cnt * 2u];
+
+            if (points[cnt] < points[cnt * 2u + 1u]) {
+                points[cnt] = points[cnt * 2u + 1u];
+            }
+        }
+
+        if ((nPoints % 2u) != 0u) {
+            points[cnt] = points[nPoints - 1u];
+        }
+        nPoints = (nPoints + 1u) / 2u;
+    }
+
+    return (nPoints);
+}
+
+static bool roundTrip(const uint16_t * samples, size_t nSamples) {
+    uint8_t             buffer[CONFIG_TEST_LENGTHS * 3];
+    uint16_t            decoded[CONFIG_TEST_LENGTHS];
+    size_t              size;
+
+    size = deltaEncode(samples, nSamples, buffer, sizeof(buffer));
+
+    if ((size == 0u) && (nSamples != 0u)) {
+
+        return (false);
+    }
+
+    if (deltaDecode(buffer, size, decoded, nSamples) != nSamples) {
+
+        return (false);
+    }
+
+    if (memcmp(samples, decoded, nSamples * sizeof(samples[0])) != 0) {
+
+        return (false);
+    }
+
+    if ((size != 0u) && (deltaEncode(samples, nSamples, buffer, size - 1u) != 0u)) {
+
+        return (false);
+    }
+
+    return (true);
+}
+
+static uint32_t runTest(void) {
+    uint16_t            samples[CONFIG_TEST_LENGTHS];
+    uint32_t            nFailed;
+    uint32_t            signal;
+
+    nFailed = 0u;
+    printf("%-10s %8s %s\n", "signal", "lengths", "result");
+
+    for (signal = 0u; signal < LAST_SIGNAL; signal++) {
+        uint32_t        nErrors;
+        size_t          nSamples;
+
+        nErrors = 0u;
+
+        for (nSamples = 0u; nSamples <= CONFIG_TEST_LENGTHS; nSamples++) {
+            makeSignal((enum signal)signal, samples, nSamples);
+
+            if (!roundTrip(samples, nSamples)) {
+
+                if (nErrors == 0u) {
+                    fprintf(stderr, "%s: round trip of %u samples failed\n", SignalName[signal], (unsigned)nSamples);
+                }
+                nErrors++;
+            }
+        }
+        printf("%-10s %8u %s\n", SignalName[signal], CONFIG_TEST_LENGTHS + 1u, nErrors == 0u ? "ok" : "FAILED");
+
+        if (nErrors != 0u) {
+            nFailed++;
+        }
+    }
+
+    return (nFailed);
+}
+
+static uint32_t runBench(uint32_t nCurves, double noise) {
+    uint16_t            samples[CONFIG_CURVE_POINTS];
+    uint16_t            decoded[CONFIG_CURVE_POINTS];
+    uint8_t             buffer[CONFIG_CURVE_POINTS * 3];
+    uint64_t            encodeNs;
+    uint64_t            decodeNs;
+    uint64_t            totalSize;
+    uint64_t            totalPoints;
+    uint32_t            nErrors;
+    uint32_t            curve;
+
+    encodeNs    = 0u;
+    decodeNs    = 0u;
+    totalSize   = 0u;
+    totalPoints = 0u;
+    nErrors     = 0u;
+
+    for (curve = 0u; curve < nCurves; curve++) {
+        uint64_t        start;
+        size_t          size;
+
+        makeCurve(samples, CONFIG_CURVE_POINTS, noise);
+        start     = hostNs();
+        size      = deltaEncode(samples, CONFIG_CURVE_POINTS, buffer, sizeof(buffer));
+        encodeNs += hostNs() - start;
+        start     = hostNs();
+
+        if (deltaDecode(buffer, size, decoded, CONFIG_CURVE_POINTS) != CONFIG_CURVE_POINTS) {
+            nErrors++;
+        }
+        decodeNs += hostNs() - start;
+
+        if (memcmp(samples, decoded, sizeof(samples)) != 0) {
+            nErrors++;
+        }
+        totalSize   += size;
+        totalPoints += fitCurve(samples, CONFIG_CURVE_POINTS);
+    }
+    printf("\n%u curves of %u points, noise %.1f codes RMS\n", (unsigned)nCurves, CONFIG_CURVE_POINTS, noise);
+    printf("  bytes per point      %6.2f\n", (double)totalSize / ((double)nCurves * CONFIG_CURVE_POINTS));
+    printf("  compression ratio    %6.2f\n", (2.0 * nCurves * CONFIG_CURVE_POINTS) / (double)totalSize);
+    printf("  points in %u bytes   %6.1f\n", CONFIG_CURVE_SIZE, (double)totalPoints / nCurves);
+    printf("  encode ns per point  %6.1f\n", (double)encodeNs / ((double)nCurves * CONFIG_CURVE_POINTS));
+    printf("  decode ns per point  %6.1f\n", (double)decodeNs / ((double)nCurves * CONFIG_CURVE_POINTS));
+
+    return (nErrors);
+}
+
+int main(int argc, char ** argv) {
+    uint32_t            nCurves;
+    uint32_t            nFailed;
+    double              noise;
+    int                 arg;
+
+    nCurves = CONFIG_DEF_CURVES;
+    noise   = CONFIG_DEF_NOISE;
+    srand(1);
+
+    for (arg = 1; (arg + 1) < argc; arg += 2) {
+
+        if (strcmp(argv[arg], "-n") == 0) {
+            nCurves = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+        } else if (strcmp(argv[arg], "-s") == 0) {
+            srand((unsigned)strtoul(argv[arg + 1], NULL, 10));
+        } else if (strcmp(argv[arg], "-r") == 0) {
+            noise = strtod(argv[arg + 1], NULL);
+        } else {
+            break;
+        }
+    }
+
+    if ((arg != argc) || (nCurves == 0u)) {
+        fprintf(stderr, "usage: %s [-n curves] [-s seed] [-r noise]\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    nFailed  = runTest();
+    nFailed += runBench(nCurves, noise);
+
+    return (nFailed == 0u ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,522 @@
+/*
+ * File:   export_bench.c
+ *
+ * Host side benchmark of the log export write pattern. The MDD file system
+ * runs on top of a FAT image file instead of the USB stick. Every SCSI
+ * command is counted and charged a fixed latency, every transferred sector is
+ * charged its bus time, which together model the USB MSD cost of the tester.
+ * Every byte FSfwrite copies through its data buffer is charged the CPU time
+ * of the tester, sectors written straight from the export buffer are not.
+ *
+ * Two export patterns are measured on a freshly formatted image. The image
+ * can be partly filled first to model a used stick, the used clusters are
+ * at the start of the volume like on a stick that was only ever appended to,
+ * which is the worst case for a linear search of the FAT:
+ *
+ *     per entry   one file per log entry, opened, written once and closed,
+ *                 the way the exporter worked before
+ *     stream      all entries in one file written through the export buffer,
+ *                 whole sectors until the last write like the exporter does
+ *     prealloc    like stream, with the clusters reserved by FSfpreallocate
+ *
+ * Build:
+ *     cc -std=c99 -O2 -D__PIC32MX__ -DALLOW_FORMATS -Ihost \
+ *         -I../application/include/config -I../mla/include -o export_bench \
+ *         export_bench.c "../mla/source/MDDFS/FSIO.c"
+ *
+ * Usage:
+ *     export_bench [-n entries] [-r bytes] [-b bytes] [-l us] [-t us] [-c ns]
+ *                  [-s MB] [-f percent] [-i 0|1] image
+ *
+ *     -n      number of exported entries (default 2000)
+ *     -r      bytes written per entry (default 420)
+ *     -b      export block size in bytes, the buffer holds one more record
+ *             (default 2048)
+ *     -l      modeled latency of one SCSI command in us (default 1000)
+ *     -t      modeled transfer time of one sector in us (default 500)
+ *     -c      modeled CPU time of one byte copied by FSfwrite in ns
+ *             (default 1000)
+ *     -s      image size in MB (default 4096, gives FAT32)
+ *     -f      percent of the clusters that are in use before the export
+ *             (default 0)
+ *     -i      write a valid FAT32 FSInfo sector like a PC does (default 1)
+ *
+ * The image file is created or overwritten.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MDD File System/FSIO.h"
+
+#define CONFIG_SECTOR_SIZE              512u
+#define CONFIG_PARTITION_START          2048u
+#define CONFIG_DEF_ENTRIES              2000u
+#define CONFIG_DEF_RECORD_SIZE          420u
+#define CONFIG_DEF_BUFFER_SIZE          2048u
+#define CONFIG_DEF_LATENCY_US           1000u
+#define CONFIG_DEF_TRANSFER_US          500u
+#define CONFIG_DEF_COPY_NS              1000u
+#define CONFIG_DEF_IMAGE_MB             4096u
+#define CONFIG_DEF_FILL                 0u
+#define CONFIG_DEF_FSINFO               1u
+
+enum exportMode {
+    EXPORT_PER_ENTRY,
+    EXPORT_STREAM,
+    EXPORT_PREALLOCATED
+};
+
+struct media {
+    FILE *              image;
+    unsigned long       nReads;
+    unsigned long       nWrites;
+    unsigned long       nSectors;
+    unsigned long       nDirect;                                                /* Sectors written straight from the export buffer          */
+    const char *        direct;
+    size_t              directSize;
+    MEDIA_INFORMATION   info;
+};
+
+struct config {
+    uint32_t            nEntries;
+    uint32_t            recordSize;
+    uint32_t            bufferSize;
+    uint32_t            latency;
+    uint32_t            transfer;
+    uint32_t            copy;
+    uint32_t            imageSize;
+    uint32_t            fill;
+    uint32_t            hasFsInfo;
+};
+
+static struct media     Media;
+
+static const char * const ModeName[] = {
+    "per entry",
+    "stream",
+    "prealloc"
+};
+
+BYTE USBHostMSDSCSIMediaDetect(void) {
+
+    return (TRUE);
+}
+
+MEDIA_INFORMATION * USBHostMSDSCSIMediaInitialize(void) {
+    Media.info.errorCode                     = MEDIA_NO_ERROR;
+    Media.info.validityFlags.value           = 0u;
+    Media.info.validityFlags.bits.sectorSize = 1u;
+    Media.info.sectorSize                    = CONFIG_SECTOR_SIZE;
+
+    return (&Media.info);
+}
+
+BYTE USBHostMSDSCSIMediaReset(void) {
+
+    return (TRUE);
+}
+
+BYTE USBHostMSDSCSIWriteProtectState(void) {
+
+    return (FALSE);
+}
+
+BYTE USBHostMSDSCSISectorsRead(DWORD sectorAddress, WORD sectorCount, BYTE * dataBuffer) {
+    Media.nReads++;
+    Media.nSectors += sectorCount;
+
+    if ((sectorCount == 0u) || (fseek(Media.image, (long)sectorAddress * CONFIG_SECTOR_SIZE, SEEK_SET) != 0)) {
+
+        return (FALSE);
+    }
+
+    return (fread(dataBuffer, CONFIG_SECTOR_SIZE, sectorCount, Media.image) == sectorCount ? TRUE : FALSE);
+}
+
+BYTE USBHostMSDSCSISectorsWrite(DWORD sectorAddress, WORD sectorCount, BYTE * dataBuffer, BYTE allowWriteToZero) {
+    (void)allowWriteToZero;
+    Media.nWrites++;
+    Media.nSectors += sectorCount;
+
+    if (((const char *)dataBuffer >= Media.direct) && ((const char *)dataBuffer < &Media.direct[Media.directSize])) {
+        Media.nDirect += sectorCount;
+    }
+
+    if ((sectorCount == 0u) || (fseek(Media.image, (long)sectorAddress * CONFIG_SECTOR_SIZE, SEEK_SET) != 0)) {
+
+        return (FALSE);
+    }
+
+    return (fwrite(dataBuffer, CONFIG_SECTOR_SIZE, sectorCount, Media.image) == sectorCount ? TRUE : FALSE);
+}
+
+BYTE USBHostMSDSCSISectorRead(DWORD sectorAddress, BYTE * dataBuffer) {
+
+    return (USBHostMSDSCSISectorsRead(sectorAddress, 1u, dataBuffer));
+}
+
+BYTE USBHostMSDSCSISectorWrite(DWORD sectorAddress, BYTE * dataBuffer, BYTE allowWriteToZero) {
+
+    return (USBHostMSDSCSISectorsWrite(sectorAddress, 1u, dataBuffer, allowWriteToZero));
+}
+
+static double hostTime(void) {
+    struct timespec     now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0);
+}
+
+static uint32_t le16(const uint8_t * buffer) {
+
+    return ((uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8));
+}
+
+static uint32_t le32(const uint8_t * buffer) {
+
+    return (le16(buffer) | (le16(&buffer[2]) << 16));
+}
+
+static void setLe32(uint8_t * buffer, uint32_t value) {
+    buffer[0] = (uint8_t)(value >>  0);
+    buffer[1] = (uint8_t)(value >>  8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/*
+ * Marks the first config->fill percent of the FAT32 clusters as used, every
+ * cluster as a chain of its own, and writes the FSInfo sector a PC would
+ * leave behind.
+ */
+static bool imageFill(const struct config * config) {
+    uint8_t             sector[CONFIG_SECTOR_SIZE];
+    uint32_t            fat;
+    uint32_t            fatSize;
+    uint32_t            nFats;
+    uint32_t            nClusters;
+    uint32_t            nUsed;
+    uint32_t            fatSector;
+
+    if ((fseek(Media.image, (long)CONFIG_PARTITION_START * CONFIG_SECTOR_SIZE, SEEK_SET) != 0) ||
+        (fread(sector, sizeof(sector), 1u, Media.image) != 1u)) {
+
+        return (false);
+    }
+    if (le16(&sector[22]) != 0u) {                                              /* FAT12 or FAT16 keep their FAT size here                  */
+
+        return (config->fill == 0u ? true : false);
+    }
+    fat       = CONFIG_PARTITION_START + le16(&sector[14]);
+    nFats     = sector[16];
+    fatSize   = le32(&sector[36]);
+    nClusters = (le32(&sector[32]) - le16(&sector[14]) - nFats * fatSize) / sector[13];
+    nUsed = (uint32_t)((uint64_t)nClusters * config->fill / 100u);
+
+    for (fatSector = 0u; (fatSector * (CONFIG_SECTOR_SIZE / 4u)) < (nUsed + 3u); fatSector++) {
+        uint32_t        entry;
+        uint32_t        copy;
+
+        if ((fseek(Media.image, (long)(fat + fatSector) * CONFIG_SECTOR_SIZE, SEEK_SET) != 0) ||
+            (fread(sector, sizeof(sector), 1u, Media.image) != 1u)) {
+
+            return (false);
+        }
+
+        for (entry = 0u; entry < (CONFIG_SECTOR_SIZE / 4u); entry++) {
+            uint32_t    cluster;
+
+            cluster = fatSector * (CONFIG_SECTOR_SIZE / 4u) + entry;
+
+            if ((cluster >= 3u) && (cluster < (nUsed + 3u))) {
+                setLe32(&sector[entry * 4u], 0x0fffffffu);
+            }
+        }
+
+        for (copy = 0u; copy < nFats; copy++) {
+
+            if ((fseek(Media.image, (long)(fat + fatSector + copy * fatSize) * CONFIG_SECTOR_SIZE, SEEK_SET) != 0) ||
+                (fwrite(sector, sizeof(sector), 1u, Media.image) != 1u)) {
+
+                return (false);
+            }
+        }
+    }
+
+    if (config->hasFsInfo != 0u) {
+        memset(sector, 0, sizeof(sector));
+        setLe32(&sector[0],   0x41615252u);
+        setLe32(&sector[484], 0x61417272u);
+        setLe32(&sector[488], nClusters - 1u - nUsed);                          /* The root directory takes one cluster                     */
+        setLe32(&sector[492], nUsed + 3u);
+        setLe32(&sector[508], 0xaa550000u);
+
+        if ((fseek(Media.image, (long)(CONFIG_PARTITION_START + 1u) * CONFIG_SECTOR_SIZE, SEEK_SET) != 0) ||
+            (fwrite(sector, sizeof(sector), 1u, Media.image) != 1u)) {
+
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/*
+ * Writes an MBR with one FAT partition and formats it, so every run starts
+ * from the same volume.
+ */
+static bool imageFormat(const struct config * config, const char * name) {
+    uint8_t             mbr[CONFIG_SECTOR_SIZE];
+    uint32_t            nSectors;
+    uint32_t            nPartition;
+
+    Media.image = fopen(name, "w+b");
+
+    if (Media.image == NULL) {
+
+        return (false);
+    }
+    nSectors   = config->imageSize * (1024u * 1024u / CONFIG_SECTOR_SIZE);
+    nPartition = nSectors - CONFIG_PARTITION_START;
+    memset(mbr, 0, sizeof(mbr));
+    mbr[446u + 4u]  = 0x0cu;                                                    /* FAT32 LBA, FSformat picks the real type                  */
+    mbr[446u + 8u]  = (uint8_t)(CONFIG_PARTITION_START >>  0);
+    mbr[446u + 9u]  = (uint8_t)(CONFIG_PARTITION_START >>  8);
+    mbr[446u + 12u] = (uint8_t)(nPartition >>  0);
+    mbr[446u + 13u] = (uint8_t)(nPartition >>  8);
+    mbr[446u + 14u] = (uint8_t)(nPartition >> 16);
+    mbr[446u + 15u] = (uint8_t)(nPartition >> 24);
+    mbr[510u]       = 0x55u;
+    mbr[511u]       = 0xaau;
+
+    if ((fseek(Media.image, (long)nSectors * CONFIG_SECTOR_SIZE - 1, SEEK_SET) != 0) ||
+        (fputc(0, Media.image) == EOF) || (fseek(Media.image, 0, SEEK_SET) != 0) ||
+        (fwrite(mbr, sizeof(mbr), 1u, Media.image) != 1u)) {
+        fclose(Media.image);
+
+        return (false);
+    }
+    SetClockVars(2014, 8, 24, 18, 40, 0);
+
+    if ((FSformat(1, 0x20140824, "BENCH") != 0) || !imageFill(config) || (FSInit() != TRUE)) {
+        fclose(Media.image);
+
+        return (false);
+    }
+
+    return (true);
+}
+
+static void recordFill(char * record, uint32_t recordSize, uint32_t entry) {
+    uint32_t            cnt;
+
+    snprintf(record, recordSize, "%u,8-24-2014,6:40 PM,1,PASSED,1", (unsigned)entry);
+
+    for (cnt = (uint32_t)strlen(record); cnt < (recordSize - 2u); cnt++) {
+        record[cnt] = ',';
+    }
+    record[recordSize - 2u] = '\r';
+    record[recordSize - 1u] = '\n';
+}
+
+static bool exportPerEntry(const struct config * config, char * record) {
+    uint32_t            entry;
+
+    for (entry = 0u; entry < config->nEntries; entry++) {
+        FSFILE *        file;
+        char            name[16];
+
+        snprintf(name, sizeof(name), "V%06u.LOG", (unsigned)entry);
+        file = FSfopen(name, FS_WRITE);
+
+        if (file == NULL) {
+
+            return (false);
+        }
+        recordFill(record, config->recordSize, entry);
+
+        if (FSfwrite(record, 1u, config->recordSize, file) != config->recordSize) {
+            FSfclose(file);
+
+            return (false);
+        }
+
+        if (FSfclose(file) != 0) {
+
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+static bool exportStream(const struct config * config, char * record, char * buffer, bool isPreallocated) {
+    FSFILE *            file;
+    uint32_t            entry;
+    size_t              length;
+
+    file = FSfopen("08241840.CSV", FS_WRITE);
+
+    if (file == NULL) {
+
+        return (false);
+    }
+
+    if (isPreallocated && (FSfpreallocate(file, config->nEntries * config->recordSize) != 0)) {
+        FSfclose(file);
+
+        return (false);
+    }
+    length = 0u;
+
+    for (entry = 0u; entry < config->nEntries; entry++) {
+        recordFill(record, config->recordSize, entry);
+
+        if (length >= config->bufferSize) {
+            size_t      whole;
+
+            whole = length - length % CONFIG_SECTOR_SIZE;
+
+            if (FSfwrite(buffer, 1u, whole, file) != whole) {
+                FSfclose(file);
+
+                return (false);
+            }
+            length -= whole;
+            memmove(buffer, &buffer[whole], length);
+        }
+        memcpy(&buffer[length], record, config->recordSize);
+        length += config->recordSize;
+    }
+
+    if ((length != 0u) && (FSfwrite(buffer, 1u, length, file) != length)) {
+        FSfclose(file);
+
+        return (false);
+    }
+
+    return (FSfclose(file) == 0 ? true : false);
+}
+
+static bool run(const struct config * config, const char * image, enum exportMode mode) {
+    char *              record;
+    char *              buffer;
+    double              start;
+    double              hostMs;
+    double              modelMs;
+    bool                isDone;
+
+    if (!imageFormat(config, image)) {
+        fprintf(stderr, "%s: can not format\n", image);
+
+        return (false);
+    }
+    record = malloc(config->recordSize);
+    buffer = malloc(config->bufferSize + config->recordSize);
+
+    if ((record == NULL) || (buffer == NULL)) {
+        free(record);
+        free(buffer);
+        fclose(Media.image);
+
+        return (false);
+    }
+    Media.nReads     = 0u;
+    Media.nWrites    = 0u;
+    Media.nSectors   = 0u;
+    Media.nDirect    = 0u;
+    Media.direct     = buffer;
+    Media.directSize = config->bufferSize + config->recordSize;
+    start            = hostTime();
+
+    if (mode == EXPORT_PER_ENTRY) {
+        isDone = exportPerEntry(config, record);
+    } else {
+        isDone = exportStream(config, record, buffer, mode == EXPORT_PREALLOCATED);
+    }
+    hostMs  = hostTime() - start;
+    modelMs = hostMs + ((double)(Media.nReads + Media.nWrites) * config->latency +
+        (double)Media.nSectors * config->transfer) / 1000.0 +
+        ((double)config->nEntries * config->recordSize - (double)Media.nDirect * CONFIG_SECTOR_SIZE) *
+        config->copy / 1000000.0;
+    printf("%-10s %10lu %10lu %10lu %10lu %10.1f %12.1f %10.1f %s\n", ModeName[mode],
+        Media.nReads, Media.nWrites, Media.nSectors, Media.nDirect, hostMs, modelMs,
+        config->nEntries * 1000.0 / modelMs,
+        isDone ? "" : "FAILED");
+    free(record);
+    free(buffer);
+    fclose(Media.image);
+
+    return (isDone);
+}
+
+int main(int argc, char ** argv) {
+    struct config       config;
+    int                 arg;
+
+    config.nEntries   = CONFIG_DEF_ENTRIES;
+    config.recordSize = CONFIG_DEF_RECORD_SIZE;
+    config.bufferSize = CONFIG_DEF_BUFFER_SIZE;
+    config.latency    = CONFIG_DEF_LATENCY_US;
+    config.transfer   = CONFIG_DEF_TRANSFER_US;
+    config.copy       = CONFIG_DEF_COPY_NS;
+    config.imageSize  = CONFIG_DEF_IMAGE_MB;
+    config.fill       = CONFIG_DEF_FILL;
+    config.hasFsInfo  = CONFIG_DEF_FSINFO;
+    arg               = 1;
+
+    while (((arg + 1) < argc) && (argv[arg][0] == '-')) {
+        uint32_t        value;
+
+        value = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+
+        if (strcmp(argv[arg], "-n") == 0) {
+            config.nEntries   = value;
+        } else if (strcmp(argv[arg], "-r") == 0) {
+            config.recordSize = value;
+        } else if (strcmp(argv[arg], "-b") == 0) {
+            config.bufferSize = value;
+        } else if (strcmp(argv[arg], "-l") == 0) {
+            config.latency    = value;
+        } else if (strcmp(argv[arg], "-t") == 0) {
+            config.transfer   = value;
+        } else if (strcmp(argv[arg], "-c") == 0) {
+            config.copy       = value;
+        } else if (strcmp(argv[arg], "-s") == 0) {
+            config.imageSize  = value;
+        } else if (strcmp(argv[arg], "-f") == 0) {
+            config.fill       = value;
+        } else if (strcmp(argv[arg], "-i") == 0) {
+            config.hasFsInfo  = value;
+        } else {
+            break;
+        }
+        arg += 2;
+    }
+
+    if (((argc - arg) != 1) || (config.recordSize < 40u) || (config.bufferSize < config.recordSize) ||
+        (config.bufferSize < CONFIG_SECTOR_SIZE) || (config.fill > 95u)) {
+        fprintf(stderr, "usage: %s [-n entries] [-r bytes] [-b bytes] [-l us] [-t us] [-c ns] [-s MB] "
+            "[-f percent] [-i 0|1] image\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    printf("%-10s %10s %10s %10s %10s %10s %12s %10s\n", "mode", "reads", "writes", "sectors", "direct", "host ms",
+        "modeled ms", "entries/s");
+
+    if (!run(&config, argv[arg], EXPORT_PER_ENTRY) || !run(&config, argv[arg], EXPORT_STREAM) ||
+        !run(&config, argv[arg], EXPORT_PREALLOCATED)) {
+
+        return (EXIT_FAILURE);
+    }
+
+    return (EXIT_SUCCESS);
+}
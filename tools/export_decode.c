@@ -0,0 +1,548 @@
+/*
+ * File:   export_decode.c
+ *
+ * Host side decoder of the binary log export. The file is checked first: the
+ * header, the block chain, the entry count and the CRC-32 in the end block
+ * must all be right, otherwise nothing is printed. The entries are then
+ * printed as CSV, in the same columns as the text export of the tester, or as
+ * JSON. Raw values are converted with the calibration stored in the header,
+ * the same way the tester converts them. Files of format version 1 are read
+ * too, their entries have no leak test result.
+ *
+ * Build:
+ *     cc -std=c99 -O2 -I../application/include -I../lib -o export_decode \
+ *         export_decode.c ../lib/checksum/checksum.c ../lib/delta/delta.c
+ *
+ * Usage:
+ *     export_decode [-c | -j] [-r] [-f] file
+ *
+ *     -c      print CSV (default)
+ *     -j      print JSON
+ *     -r      print raw sensor values, do not convert them
+ *     -f      print what can be decoded even when the file does not check
+ *
+ * The output goes to the standard output. The exit status is failure when the
+ * file does not check.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_log_format.h"
+#include "checksum/checksum.h"
+#include "delta/delta.h"
+
+#define CONFIG_MAX_POINTS               1024
+#define CALIB_SHIFT                     16
+
+enum format {
+    FORMAT_CSV,
+    FORMAT_JSON
+};
+
+struct calib {
+    uint32_t            nPoints;
+    uint32_t            rawVacuum[LOG_BIN_CALIB_POINTS];
+    uint32_t            vacuum[LOG_BIN_CALIB_POINTS];
+    int32_t             slope[LOG_BIN_CALIB_POINTS];
+};
+
+struct time {
+    uint32_t            year;
+    uint32_t            month;
+    uint32_t            day;
+    uint32_t            hour;
+    uint32_t            minute;
+    uint32_t            second;
+};
+
+struct entry {
+    uint32_t            id;
+    struct time         timestamp;
+    bool                hasPassed;
+    bool                isPredicted;
+    uint32_t            userId;
+    uint32_t            numOfTests;
+    uint32_t            rawMaxValue[2];
+    uint32_t            time[2];
+    uint32_t            leakResult;
+    int32_t             rawLeakRate;
+    uint32_t            period;
+    uint32_t            nPoints;
+    uint16_t            points[CONFIG_MAX_POINTS];
+};
+
+struct output {
+    enum format         format;
+    bool                isRaw;
+    const struct calib * calib;
+    uint32_t            nEntries;
+};
+
+static uint32_t getUint16(const uint8_t * buffer) {
+
+    return ((uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8));
+}
+
+static uint32_t getUint32(const uint8_t * buffer) {
+
+    return ((uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | ((uint32_t)buffer[2] << 16) |
+        ((uint32_t)buffer[3] << 24));
+}
+
+static size_t getTime(const uint8_t * buffer, struct time * time) {
+    time->year   = getUint16(&buffer[0]);
+    time->month  = buffer[2];
+    time->day    = buffer[3];
+    time->hour   = buffer[4];
+    time->minute = buffer[5];
+    time->second = buffer[6];
+
+    return (7u);
+}
+
+/*
+ * Slopes are computed with the same integer arithmetic as dutSetCalibration(),
+ * so converted values match the text export to the unit.
+ */
+static bool calibInit(struct calib * calib, const uint8_t * buffer) {
+    uint32_t            cnt;
+
+    calib->nPoints = buffer[15];
+
+    if ((calib->nPoints == 1u) || (calib->nPoints > LOG_BIN_CALIB_POINTS)) {
+
+        return (false);
+    }
+
+    for (cnt = 0u; cnt < calib->nPoints; cnt++) {
+        calib->rawVacuum[cnt] = getUint32(&buffer[16u + cnt * 8u]);
+        calib->vacuum[cnt]    = getUint32(&buffer[20u + cnt * 8u]);
+
+        if ((cnt != 0u) && ((calib->rawVacuum[cnt] <= calib->rawVacuum[cnt - 1u]) ||
+            (calib->vacuum[cnt] <= calib->vacuum[cnt - 1u]))) {
+
+            return (false);
+        }
+    }
+
+    for (cnt = 0u; cnt < calib->nPoints; cnt++) {
+
+        if (cnt < (calib->nPoints - 1u)) {
+            calib->slope[cnt] = (int32_t)(((calib->vacuum[cnt + 1u] - calib->vacuum[cnt]) << CALIB_SHIFT) /
+                (calib->rawVacuum[cnt + 1u] - calib->rawVacuum[cnt]));
+        } else {
+            calib->slope[cnt] = calib->slope[cnt - 1u];
+        }
+    }
+
+    return (true);
+}
+
+static uint32_t rawToMm(const struct calib * calib, uint32_t rawValue) {
+    int32_t             vacuum;
+    uint32_t            cnt;
+
+    if (calib->nPoints == 0u) {
+
+        return (rawValue);
+    }
+
+    for (cnt = calib->nPoints - 1u; (cnt != 0u) && (rawValue < calib->rawVacuum[cnt]); cnt--);
+    vacuum = (int32_t)calib->vacuum[cnt] +
+        (int32_t)((((int64_t)rawValue - calib->rawVacuum[cnt]) * calib->slope[cnt] +
+        (0x1 << (CALIB_SHIFT - 1))) >> CALIB_SHIFT);
+
+    return (vacuum > 0 ? (uint32_t)vacuum : 0u);
+}
+
+static uint32_t convert(const struct output * output, uint32_t rawValue) {
+
+    return (output->isRaw ? rawValue : rawToMm(output->calib, rawValue));
+}
+
+/*
+ * Leak rate per minute, converted with the slope at the vacuum where the leak
+ * test started, like dutRawRateToMm() does.
+ */
+static uint32_t convertRate(const struct output * output, int32_t rawRate, uint32_t rawValue) {
+    uint32_t            rate;
+    uint32_t            cnt;
+
+    rate = rawRate > 0 ? (uint32_t)rawRate * 60u : 0u;
+
+    if (output->isRaw || (output->calib->nPoints == 0u)) {
+
+        return (rate);
+    }
+
+    for (cnt = output->calib->nPoints - 1u; (cnt != 0u) && (rawValue < output->calib->rawVacuum[cnt]); cnt--);
+
+    return ((uint32_t)(((int64_t)rate * output->calib->slope[cnt] + (0x1 << (CALIB_SHIFT - 1))) >> CALIB_SHIFT));
+}
+
+static const char * leakName(uint32_t leakResult) {
+
+    switch (leakResult) {
+        case LOG_BIN_LEAK_PASSED: {
+
+            return ("PASSED");
+        }
+        case LOG_BIN_LEAK_FAILED: {
+
+            return ("FAILED");
+        }
+        default: {
+
+            return (NULL);
+        }
+    }
+}
+
+static uint8_t * readFile(const char * name, size_t * size) {
+    FILE *              file;
+    uint8_t *           buffer;
+    long                length;
+
+    file = fopen(name, "rb");
+
+    if (file == NULL) {
+
+        return (NULL);
+    }
+    buffer = NULL;
+
+    if ((fseek(file, 0, SEEK_END) == 0) && ((length = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+        buffer = malloc((size_t)length + 1u);
+
+        if ((buffer != NULL) && (fread(buffer, 1, (size_t)length, file) != (size_t)length)) {
+            free(buffer);
+            buffer = NULL;
+        }
+        *size = (size_t)length;
+    }
+    fclose(file);
+
+    return (buffer);
+}
+
+/*
+ * Returns NULL when the file checks, otherwise the reason why it does not.
+ * The header must be checked before the blocks are walked.
+ */
+static const char * checkHeader(const uint8_t * buffer, size_t size, struct calib * calib) {
+
+    if ((size < LOG_BIN_HEADER_SIZE) || (memcmp(buffer, LOG_BIN_MAGIC, 4) != 0)) {
+
+        return ("not a binary log export");
+    }
+
+    if ((getUint16(&buffer[4]) == 0u) || (getUint16(&buffer[4]) > LOG_BIN_VERSION)) {
+
+        return ("unknown format version");
+    }
+
+    if ((getUint16(&buffer[6]) < LOG_BIN_HEADER_SIZE) || (getUint16(&buffer[6]) > size)) {
+
+        return ("bad header size");
+    }
+
+    if (!calibInit(calib, buffer)) {
+
+        return ("bad calibration");
+    }
+
+    return (NULL);
+}
+
+static const char * checkBlocks(const uint8_t * buffer, size_t size) {
+    size_t              offset;
+    uint32_t            nEntries;
+
+    nEntries = 0u;
+
+    for (offset = getUint16(&buffer[6]); offset < size; ) {
+        uint32_t        type;
+        uint32_t        length;
+
+        if ((size - offset) < LOG_BIN_BLOCK_SIZE) {
+
+            return ("truncated block");
+        }
+        type    = getUint16(&buffer[offset]);
+        length  = getUint16(&buffer[offset + 2u]);
+        offset += LOG_BIN_BLOCK_SIZE;
+
+        if ((size - offset) < length) {
+
+            return ("truncated block");
+        }
+
+        if ((type == LOG_BIN_ENTRY) && (length < LOG_BIN_ENTRY_V1_SIZE)) {
+
+            return ("short entry block");
+        }
+
+        if ((type == LOG_BIN_CURVE) && (length < LOG_BIN_CURVE_SIZE)) {
+
+            return ("short curve block");
+        }
+
+        if (type == LOG_BIN_ENTRY) {
+            nEntries++;
+        } else if (type == LOG_BIN_END) {
+
+            if ((length != LOG_BIN_END_SIZE) || ((offset + length) != size)) {
+
+                return ("end block is not the last one");
+            }
+
+            if (getUint32(&buffer[offset]) != nEntries) {
+
+                return ("entry count does not match");
+            }
+
+            if (getUint32(&buffer[offset + 4u]) != checksumCrc32(0u, buffer, offset + 4u)) {
+
+                return ("CRC does not match");
+            }
+
+            return (NULL);
+        }
+        offset += length;
+    }
+
+    return ("no end block, the export was not finished");
+}
+
+static void printTime(const struct time * time, bool isCsv) {
+
+    if (isCsv) {
+        printf("%u-%u-%u,%02u:%02u:%02u", (unsigned)time->month, (unsigned)time->day, (unsigned)time->year,
+            (unsigned)time->hour, (unsigned)time->minute, (unsigned)time->second);
+    } else {
+        printf("\"%04u-%02u-%02uT%02u:%02u:%02u\"", (unsigned)time->year, (unsigned)time->month,
+            (unsigned)time->day, (unsigned)time->hour, (unsigned)time->minute, (unsigned)time->second);
+    }
+}
+
+static void printBegin(const struct output * output, const uint8_t * buffer) {
+    struct time         time;
+    uint32_t            cnt;
+
+    getTime(&buffer[8], &time);
+
+    if (output->format == FORMAT_CSV) {
+        printf("Entry,Date,Time,User,Result,Predicted,Tests,"
+            "Th1 max (%s),Th1 time (ms),Th2 max (%s),Th2 time (ms),"
+            "Leak result,Leak rate (%s/min),Curve period (ms),Curve (%s)\r\n",
+            output->isRaw ? "raw" : "inHg", output->isRaw ? "raw" : "inHg", output->isRaw ? "raw" : "inHg",
+            output->isRaw ? "raw" : "inHg");
+
+        return;
+    }
+    printf("{\n  \"version\": %u,\n  \"exported\": ", (unsigned)getUint16(&buffer[4]));
+    printTime(&time, false);
+    printf(",\n  \"units\": \"%s\",\n  \"calibration\": [", output->isRaw ? "raw" : "inHg");
+
+    for (cnt = 0u; cnt < output->calib->nPoints; cnt++) {
+        printf("%s{\"raw\": %u, \"vacuum\": %u}", cnt == 0u ? "" : ", ",
+            (unsigned)output->calib->rawVacuum[cnt], (unsigned)output->calib->vacuum[cnt]);
+    }
+    printf("],\n  \"entries\": [");
+}
+
+static void printEntry(struct output * output, const struct entry * entry) {
+    uint32_t            cnt;
+
+    if (output->format == FORMAT_CSV) {
+        printf("%u,", (unsigned)entry->id);
+        printTime(&entry->timestamp, true);
+        printf(",%u,%s,%s,%u,%u,%u,%u,%u", (unsigned)entry->userId, entry->hasPassed ? "PASSED" : "FAILED",
+            entry->isPredicted ? "YES" : "NO", (unsigned)entry->numOfTests,
+            (unsigned)convert(output, entry->rawMaxValue[0]), (unsigned)entry->time[0],
+            (unsigned)convert(output, entry->rawMaxValue[1]), (unsigned)entry->time[1]);
+
+        if (leakName(entry->leakResult) != NULL) {
+            printf(",%s,%u", leakName(entry->leakResult),
+                (unsigned)convertRate(output, entry->rawLeakRate, entry->rawMaxValue[1]));
+        } else {
+            printf(",,");
+        }
+        printf(",%u", (unsigned)entry->period);
+
+        for (cnt = 0u; cnt < entry->nPoints; cnt++) {
+            printf(",%u", (unsigned)convert(output, entry->points[cnt]));
+        }
+        printf("\r\n");
+    } else {
+        printf("%s\n    {\"entry\": %u, \"time\": ", output->nEntries == 0u ? "" : ",", (unsigned)entry->id);
+        printTime(&entry->timestamp, false);
+        printf(", \"user\": %u, \"passed\": %s, \"predicted\": %s, \"tests\": %u,\n", (unsigned)entry->userId,
+            entry->hasPassed ? "true" : "false", entry->isPredicted ? "true" : "false", (unsigned)entry->numOfTests);
+        printf("     \"th\": [{\"max\": %u, \"time\": %u}, {\"max\": %u, \"time\": %u}],\n",
+            (unsigned)convert(output, entry->rawMaxValue[0]), (unsigned)entry->time[0],
+            (unsigned)convert(output, entry->rawMaxValue[1]), (unsigned)entry->time[1]);
+
+        if (leakName(entry->leakResult) != NULL) {
+            printf("     \"leak\": {\"passed\": %s, \"rate\": %u},\n",
+                entry->leakResult == LOG_BIN_LEAK_PASSED ? "true" : "false",
+                (unsigned)convertRate(output, entry->rawLeakRate, entry->rawMaxValue[1]));
+        }
+        printf("     \"curve\": {\"period\": %u, \"points\": [", (unsigned)entry->period);
+
+        for (cnt = 0u; cnt < entry->nPoints; cnt++) {
+            printf("%s%u", cnt == 0u ? "" : ", ", (unsigned)convert(output, entry->points[cnt]));
+        }
+        printf("]}}");
+    }
+    output->nEntries++;
+}
+
+static void printEnd(const struct output * output) {
+
+    if (output->format == FORMAT_JSON) {
+        printf("%s],\n  \"count\": %u\n}\n", output->nEntries == 0u ? "" : "\n  ", (unsigned)output->nEntries);
+    }
+}
+
+/*
+ * A curve block belongs to the entry before it, so an entry is printed when
+ * the next entry or the end of the file is reached. Unknown blocks are skipped.
+ */
+static void decode(struct output * output, const uint8_t * buffer, size_t size) {
+    static struct entry entry;
+    bool                isPending;
+    size_t              offset;
+
+    isPending = false;
+    printBegin(output, buffer);
+
+    for (offset = getUint16(&buffer[6]); (size - offset) >= LOG_BIN_BLOCK_SIZE; ) {
+        const uint8_t * payload;
+        uint32_t        type;
+        uint32_t        length;
+
+        type    = getUint16(&buffer[offset]);
+        length  = getUint16(&buffer[offset + 2u]);
+        payload = &buffer[offset + LOG_BIN_BLOCK_SIZE];
+        offset += LOG_BIN_BLOCK_SIZE;
+
+        if ((size - offset) < length) {
+            break;
+        }
+        offset += length;
+
+        if ((type == LOG_BIN_ENTRY) && (length >= LOG_BIN_ENTRY_V1_SIZE)) {
+
+            if (isPending) {
+                printEntry(output, &entry);
+            }
+            entry.id             = getUint32(&payload[0]);
+            getTime(&payload[4], &entry.timestamp);
+            entry.hasPassed      = (payload[11] & LOG_BIN_FLAG_PASSED) != 0u;
+            entry.isPredicted    = (payload[11] & LOG_BIN_FLAG_PREDICTED) != 0u;
+            entry.userId         = getUint32(&payload[12]);
+            entry.numOfTests     = getUint32(&payload[16]);
+            entry.rawMaxValue[0] = getUint32(&payload[20]);
+            entry.time[0]        = getUint32(&payload[24]);
+            entry.rawMaxValue[1] = getUint32(&payload[28]);
+            entry.time[1]        = getUint32(&payload[32]);
+            entry.leakResult     = LOG_BIN_LEAK_NOT_EXECUTED;
+            entry.rawLeakRate    = 0;
+
+            if (length >= LOG_BIN_ENTRY_SIZE) {
+                entry.leakResult  = payload[36];
+                entry.rawLeakRate = (int32_t)getUint32(&payload[37]);
+            }
+            entry.period         = 0u;
+            entry.nPoints        = 0u;
+            isPending            = true;
+        } else if ((type == LOG_BIN_CURVE) && (length >= LOG_BIN_CURVE_SIZE) && isPending) {
+            uint32_t    nPoints;
+
+            nPoints = getUint16(&payload[0]);
+
+            if (nPoints > CONFIG_MAX_POINTS) {
+                nPoints = CONFIG_MAX_POINTS;
+            }
+            entry.period  = getUint16(&payload[2]);
+            entry.nPoints = (uint32_t)deltaDecode(&payload[LOG_BIN_CURVE_SIZE], length - LOG_BIN_CURVE_SIZE,
+                entry.points, nPoints);
+        } else if (type == LOG_BIN_END) {
+            break;
+        }
+    }
+
+    if (isPending) {
+        printEntry(output, &entry);
+    }
+    printEnd(output);
+}
+
+int main(int argc, char ** argv) {
+    struct output       output;
+    struct calib        calib;
+    const char *        problem;
+    uint8_t *           buffer;
+    size_t              size;
+    bool                isForced;
+    int                 arg;
+
+    output.format   = FORMAT_CSV;
+    output.isRaw    = false;
+    output.calib    = &calib;
+    output.nEntries = 0u;
+    isForced        = false;
+
+    for (arg = 1; (arg < argc) && (argv[arg][0] == '-'); arg++) {
+
+        if (strcmp(argv[arg], "-c") == 0) {
+            output.format = FORMAT_CSV;
+        } else if (strcmp(argv[arg], "-j") == 0) {
+            output.format = FORMAT_JSON;
+        } else if (strcmp(argv[arg], "-r") == 0) {
+            output.isRaw = true;
+        } else if (strcmp(argv[arg], "-f") == 0) {
+            isForced = true;
+        } else {
+            break;
+        }
+    }
+
+    if ((argc - arg) != 1) {
+        fprintf(stderr, "usage: %s [-c | -j] [-r] [-f] file\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    buffer = readFile(argv[arg], &size);
+
+    if (buffer == NULL) {
+        fprintf(stderr, "%s: can not read\n", argv[arg]);
+
+        return (EXIT_FAILURE);
+    }
+    problem = checkHeader(buffer, size, &calib);
+
+    if (problem != NULL) {
+        fprintf(stderr, "%s: %s\n", argv[arg], problem);
+        free(buffer);
+
+        return (EXIT_FAILURE);
+    }
+    problem = checkBlocks(buffer, size);
+
+    if (problem != NULL) {
+        fprintf(stderr, "%s: %s\n", argv[arg], problem);
+    }
+
+    if ((problem == NULL) || isForced) {
+        decode(&output, buffer, size);
+    }
+    free(buffer);
+
+    return (problem == NULL ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,19 @@
+/*
+ * File:   Compiler.h
+ *
+ * Host replacement for the MLA compiler header. It lets the host tools build
+ * the MDD file system without the XC32 device headers.
+ */
+
+#ifndef __COMPILER_H
+#define	__COMPILER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define Nop()
+#define ClrWdt()
+#define ROM                             const
+
+#endif	/* __COMPILER_H */
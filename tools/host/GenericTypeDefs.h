@@ -0,0 +1,67 @@
+/*
+ * File:   GenericTypeDefs.h
+ *
+ * Host replacement for the MLA generic types. The MLA header derives DWORD
+ * from unsigned long which is 64 bits wide on most hosts, the file system
+ * expects it to be 32 bits wide.
+ */
+
+#ifndef __GENERIC_TYPE_DEFS_H_
+#define	__GENERIC_TYPE_DEFS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum _BOOL {
+    FALSE = 0,
+    TRUE
+} BOOL;
+
+typedef void                    VOID;
+typedef char                    CHAR8;
+typedef unsigned char           UCHAR8;
+typedef signed int              INT;
+typedef int8_t                  INT8;
+typedef int16_t                 INT16;
+typedef int32_t                 INT32;
+typedef int64_t                 INT64;
+typedef unsigned int            UINT;
+typedef uint8_t                 UINT8;
+typedef uint16_t                UINT16;
+typedef uint32_t                UINT32;
+typedef uint64_t                UINT64;
+typedef uint8_t                 BYTE;
+typedef uint16_t                WORD;
+typedef uint32_t                DWORD;
+typedef uint64_t                QWORD;
+typedef int8_t                  CHAR;
+typedef int16_t                 SHORT;
+typedef int32_t                 LONG;
+typedef int64_t                 LONGLONG;
+
+typedef union {
+    WORD                Val;
+    BYTE                v[2];
+    struct {
+        BYTE                LB;
+        BYTE                HB;
+    }                   byte;
+} WORD_VAL;
+
+typedef union {
+    DWORD               Val;
+    WORD                w[2];
+    BYTE                v[4];
+    struct {
+        WORD                LW;
+        WORD                HW;
+    }                   word;
+    struct {
+        BYTE                LB;
+        BYTE                HB;
+        BYTE                UB;
+        BYTE                MB;
+    }                   byte;
+} DWORD_VAL;
+
+#endif	/* __GENERIC_TYPE_DEFS_H_ */
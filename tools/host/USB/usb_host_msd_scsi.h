@@ -0,0 +1,23 @@
+/*
+ * File:   usb_host_msd_scsi.h
+ *
+ * Host replacement for the USB MSD SCSI layer. The host tool that links the
+ * file system provides these functions on top of an image file.
+ */
+
+#ifndef USB_HOST_MSD_SCSI_H
+#define	USB_HOST_MSD_SCSI_H
+
+#include "GenericTypeDefs.h"
+#include "MDD File System/FSDefs.h"
+
+BYTE USBHostMSDSCSIMediaDetect(void);
+MEDIA_INFORMATION * USBHostMSDSCSIMediaInitialize(void);
+BYTE USBHostMSDSCSIMediaReset(void);
+BYTE USBHostMSDSCSISectorRead(DWORD sectorAddress, BYTE * dataBuffer);
+BYTE USBHostMSDSCSISectorWrite(DWORD sectorAddress, BYTE * dataBuffer, BYTE allowWriteToZero);
+BYTE USBHostMSDSCSISectorsRead(DWORD sectorAddress, WORD sectorCount, BYTE * dataBuffer);
+BYTE USBHostMSDSCSISectorsWrite(DWORD sectorAddress, WORD sectorCount, BYTE * dataBuffer, BYTE allowWriteToZero);
+BYTE USBHostMSDSCSIWriteProtectState(void);
+
+#endif	/* USB_HOST_MSD_SCSI_H */
@@ -0,0 +1,50 @@
+/*
+ * File:   pic32.c
+ *
+ * Special function registers and the clock driver of the PIC32 for the host
+ * tools, see host/xc.h.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <time.h>
+
+#include "xc.h"
+#include "driver/clock.h"
+
+#define CONFIG_HOST_PERIPHERAL_CLOCK    48000000ul
+
+volatile uint32_t AD1CON1;
+volatile uint32_t AD1CON1SET;
+volatile uint32_t AD1CON2;
+volatile uint32_t AD1CON3;
+volatile uint32_t AD1CHS;
+volatile uint32_t AD1CSSL;
+volatile uint32_t HostAdcBuf[16 * 4];
+volatile uint32_t IFS0CLR;
+volatile uint32_t IEC0SET;
+volatile uint32_t IEC0CLR;
+volatile uint32_t IPC5CLR;
+volatile uint32_t IPC5SET;
+volatile uint32_t T3CON;
+volatile uint32_t T3CONSET;
+volatile uint32_t TMR3;
+volatile uint32_t PR3;
+
+uint32_t hostCoreCount(void) {
+    struct timespec     now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint32_t)now.tv_sec * 1000000000ul + (uint32_t)now.tv_nsec);
+}
+
+uint32_t clockGetSystemClock(void) {
+
+    return (CONFIG_HOST_PERIPHERAL_CLOCK);
+}
+
+uint32_t clockGetPeripheralClock(void) {
+
+    return (CONFIG_HOST_PERIPHERAL_CLOCK);
+}
@@ -0,0 +1,13 @@
+/*
+ * File:   attribs.h
+ *
+ * Host replacement for the XC32 interrupt attributes. Interrupt handlers
+ * become ordinary functions which the host tools call directly.
+ */
+
+#ifndef __ATTRIBS_H
+#define	__ATTRIBS_H
+
+#define __ISR(...)
+
+#endif	/* __ATTRIBS_H */
@@ -0,0 +1,41 @@
+/*
+ * File:   xc.h
+ *
+ * Host replacement for the XC32 device header. The special function registers
+ * used by the drivers are plain variables defined in host/pic32.c, so a host
+ * tool can run driver code and its interrupt handlers directly. The ADC
+ * result buffers keep the device spacing of four words.
+ */
+
+#ifndef __XC_H
+#define	__XC_H
+
+#include <stdint.h>
+
+extern volatile uint32_t AD1CON1;
+extern volatile uint32_t AD1CON1SET;
+extern volatile uint32_t AD1CON2;
+extern volatile uint32_t AD1CON3;
+extern volatile uint32_t AD1CHS;
+extern volatile uint32_t AD1CSSL;
+extern volatile uint32_t HostAdcBuf[16 * 4];
+extern volatile uint32_t IFS0CLR;
+extern volatile uint32_t IEC0SET;
+extern volatile uint32_t IEC0CLR;
+extern volatile uint32_t IPC5CLR;
+extern volatile uint32_t IPC5SET;
+extern volatile uint32_t T3CON;
+extern volatile uint32_t T3CONSET;
+extern volatile uint32_t TMR3;
+extern volatile uint32_t PR3;
+
+#define ADC1BUF0                        HostAdcBuf[0]
+
+/*
+ * Core timer of the host, it counts nanoseconds instead of core clock ticks.
+ */
+uint32_t hostCoreCount(void);
+
+#define _CP0_GET_COUNT()                hostCoreCount()
+
+#endif	/* __XC_H */
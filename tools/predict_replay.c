@@ -0,0 +1,262 @@
+/*
+ * File:   predict_replay.c
+ *
+ * Host side replay of recorded pump-down curves through the early pass/fail
+ * predictor. Every curve is run twice: once the way the tester runs without
+ * prediction and once with the predictor enabled. The tool reports whether
+ * both runs agree and how much test time the prediction saved.
+ *
+ * Build:
+ *     cc -std=c99 -O2 -I../application/include -o predict_replay \
+ *         predict_replay.c ../application/source/app_predict.c
+ *
+ * Usage:
+ *     predict_replay [-f | -a] th0 timeout0 th1 timeout1 file...
+ *
+ *     -f      predict failures only
+ *     -a      predict both passes and failures (default)
+ *
+ * Input files are the .CSV files exported by the tester. Every line after the
+ * header is one test, the curve period is in the "Curve period" column and the
+ * curve points follow it. Tests without a curve are skipped. Thresholds must
+ * be given in the same units as the curve points, timeouts are in
+ * milliseconds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_predict.h"
+
+#define CONFIG_MAX_SAMPLES              4096
+#define CONFIG_MAX_LINE                 4096
+#define CONFIG_PERIOD_COLUMN            13
+
+struct curve {
+    uint32_t            entry;
+    uint32_t            period;
+    uint32_t            nSamples;
+    uint32_t            sample[CONFIG_MAX_SAMPLES];
+};
+
+struct run {
+    bool                hasPassed;
+    bool                isPredicted;
+    uint32_t            time;
+};
+
+struct summary {
+    uint32_t            nCurves;
+    uint32_t            nAgreed;
+    uint32_t            nFalsePass;
+    uint32_t            nFalseFail;
+    uint32_t            nPredicted;
+    uint64_t            referenceTime;
+    uint64_t            predictedTime;
+};
+
+/*
+ * Reads the next test that has a curve from the export. Returns false at the
+ * end of the file.
+ */
+static bool readCurve(FILE * file, struct curve * curve) {
+    static char         line[CONFIG_MAX_LINE];
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char *          field;
+        uint32_t        column;
+
+        if ((line[0] < '0') || (line[0] > '9')) {                               /* Header line                                              */
+            continue;
+        }
+        curve->entry    = (uint32_t)strtoul(line, NULL, 10);
+        curve->period   = 0u;
+        curve->nSamples = 0u;
+        field           = line;
+
+        for (column = 0u; field != NULL; column++) {
+            char *      end;
+            unsigned long value;
+
+            value = strtoul(field, &end, 10);
+
+            if (column == CONFIG_PERIOD_COLUMN) {
+                curve->period = (uint32_t)value;
+            } else if ((column > CONFIG_PERIOD_COLUMN) && (end != field) &&
+                (curve->nSamples < CONFIG_MAX_SAMPLES)) {
+                curve->sample[curve->nSamples++] = (uint32_t)value;
+            }
+            field = strchr(field, ',');
+
+            if (field != NULL) {
+                field++;
+            }
+        }
+
+        if ((curve->period != 0u) && (curve->nSamples != 0u)) {
+
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/*
+ * Mirrors the two threshold stages of the tester. The second stage starts when
+ * the first threshold is crossed, each stage has its own timeout. A curve that
+ * ends before the deadline is treated as timed out at its last sample.
+ */
+static void replay(const struct curve * curve, const uint32_t * th, const uint32_t * timeout,
+    enum predictMode mode, struct run * run) {
+
+    struct predict      predict;
+    uint32_t            stage;
+    uint32_t            stageStart;
+    uint32_t            cnt;
+
+    run->hasPassed   = false;
+    run->isPredicted = false;
+    stage            = 0u;
+    stageStart       = 0u;
+    predictStart(&predict);
+    predictSetTarget(&predict, th[0], timeout[0] / curve->period);
+
+    for (cnt = 0u; cnt < curve->nSamples; cnt++) {
+        enum predictVerdict verdict;
+
+        run->time = cnt * curve->period;
+
+        if ((run->time - stageStart * curve->period) > timeout[stage]) {
+            run->time = stageStart * curve->period + timeout[stage];
+
+            return;
+        }
+
+        if (curve->sample[cnt] >= th[stage]) {
+
+            if (stage == 1u) {
+                run->hasPassed = true;
+
+                return;
+            }
+            stage      = 1u;
+            stageStart = cnt;
+            predictSetTarget(&predict, th[1], timeout[1] / curve->period);
+        }
+
+        if (mode == PREDICT_DISABLED) {
+            continue;
+        }
+        verdict = predictPush(&predict, curve->sample[cnt]);
+
+        if (verdict == PREDICT_FAIL) {
+            run->isPredicted = true;
+
+            return;
+        }
+
+        if ((verdict == PREDICT_PASS) && (stage == 1u) && (mode == PREDICT_PASS_FAIL)) {
+            run->hasPassed   = true;
+            run->isPredicted = true;
+
+            return;
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    enum predictMode    mode;
+    uint32_t            th[2];
+    uint32_t            timeout[2];
+    struct summary      summary;
+    static struct curve curve;
+    int                 arg;
+
+    mode = PREDICT_PASS_FAIL;
+    arg  = 1;
+
+    while ((arg < argc) && (argv[arg][0] == '-')) {
+
+        if (strcmp(argv[arg], "-f") == 0) {
+            mode = PREDICT_FAIL_ONLY;
+        } else if (strcmp(argv[arg], "-a") == 0) {
+            mode = PREDICT_PASS_FAIL;
+        } else {
+            break;
+        }
+        arg++;
+    }
+
+    if ((argc - arg) < 5) {
+        fprintf(stderr, "usage: %s [-f | -a] th0 timeout0 th1 timeout1 file...\n", argv[0]);
+
+        return (EXIT_FAILURE);
+    }
+    th[0]      = (uint32_t)strtoul(argv[arg++], NULL, 10);
+    timeout[0] = (uint32_t)strtoul(argv[arg++], NULL, 10);
+    th[1]      = (uint32_t)strtoul(argv[arg++], NULL, 10);
+    timeout[1] = (uint32_t)strtoul(argv[arg++], NULL, 10);
+    memset(&summary, 0, sizeof(summary));
+    printf("%-16s %6s %-6s %8s %-6s %8s %s\n", "file", "entry", "ref", "ref ms", "pred", "pred ms", "note");
+
+    for (; arg < argc; arg++) {
+        FILE *          file;
+
+        file = fopen(argv[arg], "r");
+
+        if (file == NULL) {
+            fprintf(stderr, "%s: can not open\n", argv[arg]);
+            continue;
+        }
+
+        while (readCurve(file, &curve)) {
+            struct run      reference;
+            struct run      predicted;
+            const char *    note;
+
+            replay(&curve, th, timeout, PREDICT_DISABLED, &reference);
+            replay(&curve, th, timeout, mode, &predicted);
+            summary.nCurves++;
+            summary.referenceTime += reference.time;
+            summary.predictedTime += predicted.time;
+            note = "";
+
+            if (predicted.isPredicted) {
+                summary.nPredicted++;
+            }
+
+            if (reference.hasPassed == predicted.hasPassed) {
+                summary.nAgreed++;
+            } else if (predicted.hasPassed) {
+                summary.nFalsePass++;
+                note = "FALSE PASS";
+            } else {
+                summary.nFalseFail++;
+                note = "FALSE FAIL";
+            }
+            printf("%-16s %6u %-6s %8u %-6s %8u %s\n", argv[arg], (unsigned)curve.entry,
+                reference.hasPassed ? "PASS" : "FAIL", (unsigned)reference.time,
+                predicted.hasPassed ? "PASS" : "FAIL", (unsigned)predicted.time, note);
+        }
+        fclose(file);
+    }
+
+    if (summary.nCurves == 0u) {
+
+        return (EXIT_FAILURE);
+    }
+    printf("\ncurves     : %u\n", (unsigned)summary.nCurves);
+    printf("predicted  : %u\n", (unsigned)summary.nPredicted);
+    printf("accuracy   : %.1f %%\n", 100.0 * summary.nAgreed / summary.nCurves);
+    printf("false pass : %u\n", (unsigned)summary.nFalsePass);
+    printf("false fail : %u\n", (unsigned)summary.nFalseFail);
+    printf("time saved : %llu ms of %llu ms (%.1f %%)\n",
+        (unsigned long long)(summary.referenceTime - summary.predictedTime),
+        (unsigned long long)summary.referenceTime,
+        summary.referenceTime == 0u ? 0.0 :
+            100.0 * (double)(summary.referenceTime - summary.predictedTime) / (double)summary.referenceTime);
+
+    return (summary.nFalsePass == 0u ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,192 @@
+/*
+ * File:   pump_sim.c
+ *
+ * Host side simulation of the pneumatic plant for tuning the pump controller.
+ * The same controller code that runs on the tester is stepped at the ADC rate
+ * against a simple model:
+ *
+ *     motor speed  dw/dt = (duty - w) / tauMotor
+ *     vacuum       dv/dt = (w * vMax - v) / tauChamber
+ *     sensor       first order lag of tauSensor, like the ADC filter chain
+ *
+ * Each run pumps until the sensor reports the threshold and then stops the
+ * pump, the same way the second test stage does. The tool reports the time to
+ * threshold, the overshoot after the pump was stopped and the peak inrush,
+ * which is the largest difference between duty and motor speed.
+ *
+ * Build:
+ *     cc -std=c99 -O2 -I../application/include -o pump_sim \
+ *         pump_sim.c ../application/source/app_pump.c -lm
+ *
+ * Usage:
+ *     pump_sim [-t] [threshold [vMax [tauChamber [tauMotor]]]]
+ *
+ *     -t      print the trace of the closed loop run as CSV
+ *
+ * Vacuum is in raw sensor units, time constants are in milliseconds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_pump.h"
+
+#define CONFIG_SAMPLE_MS                1.0
+#define CONFIG_RUN_MS                   5000
+#define CONFIG_SENSOR_TAU_MS            8.0
+#define CONFIG_DEF_THRESHOLD            336
+#define CONFIG_DEF_VMAX                 600.0
+#define CONFIG_DEF_TAU_CHAMBER_MS       250.0
+#define CONFIG_DEF_TAU_MOTOR_MS         60.0
+#define CONFIG_HEADROOM_SHIFT           3
+
+enum runMode {
+    RUN_ON_OFF,
+    RUN_SOFT_START,
+    RUN_CLOSED_LOOP
+};
+
+struct plant {
+    double              vMax;
+    double              tauChamber;
+    double              tauMotor;
+    double              speed;
+    double              vacuum;
+    double              sensor;
+};
+
+struct result {
+    double              timeToThreshold;
+    double              peakVacuum;
+    double              peakInrush;
+    bool                hasCrossed;
+};
+
+static void plantStep(struct plant * plant, double duty) {
+    plant->speed  += (duty - plant->speed) * CONFIG_SAMPLE_MS / plant->tauMotor;
+    plant->vacuum += (plant->speed * plant->vMax - plant->vacuum) * CONFIG_SAMPLE_MS / plant->tauChamber;
+    plant->sensor += (plant->vacuum - plant->sensor) * CONFIG_SAMPLE_MS / CONFIG_SENSOR_TAU_MS;
+}
+
+static void run(const struct plant * model, uint32_t threshold, enum runMode mode, bool isTraced,
+    struct result * result) {
+
+    struct plant        plant;
+    struct pump         pump;
+    bool                isRunning;
+    uint32_t            cnt;
+
+    plant        = *model;
+    plant.speed  = 0.0;
+    plant.vacuum = 0.0;
+    plant.sensor = 0.0;
+    isRunning    = true;
+    memset(result, 0, sizeof(*result));
+
+    if (mode == RUN_CLOSED_LOOP) {
+        pumpStart(&pump, (int32_t)(threshold + (threshold >> CONFIG_HEADROOM_SHIFT)));
+    } else {
+        pumpStart(&pump, 0);
+    }
+
+    if (isTraced) {
+        printf("time,duty,speed,vacuum,sensor\n");
+    }
+
+    for (cnt = 0u; cnt < (uint32_t)(CONFIG_RUN_MS / CONFIG_SAMPLE_MS); cnt++) {
+        double          duty;
+
+        duty = 0.0;
+
+        if (isRunning) {
+
+            if (mode == RUN_ON_OFF) {
+                duty = 1.0;
+            } else {
+                duty = (double)pumpUpdate(&pump, (int32_t)plant.sensor) / (double)PUMP_DUTY_ONE;
+            }
+        }
+
+        if ((duty - plant.speed) > result->peakInrush) {
+            result->peakInrush = duty - plant.speed;
+        }
+        plantStep(&plant, duty);
+
+        if (plant.vacuum > result->peakVacuum) {
+            result->peakVacuum = plant.vacuum;
+        }
+
+        if (isRunning && (plant.sensor >= threshold)) {
+            result->timeToThreshold = cnt * CONFIG_SAMPLE_MS;
+            result->hasCrossed      = true;
+            isRunning               = false;
+        }
+
+        if (isTraced) {
+            printf("%.0f,%.3f,%.3f,%.1f,%.1f\n", cnt * CONFIG_SAMPLE_MS, duty, plant.speed, plant.vacuum,
+                plant.sensor);
+        }
+    }
+}
+
+static void report(const char * name, uint32_t threshold, const struct result * result) {
+
+    if (result->hasCrossed) {
+        printf("%-12s %10.0f %10.1f %10.2f\n", name, result->timeToThreshold,
+            result->peakVacuum - threshold, result->peakInrush);
+    } else {
+        printf("%-12s %10s %10s %10.2f\n", name, "never", "-", result->peakInrush);
+    }
+}
+
+int main(int argc, char ** argv) {
+    struct plant        plant;
+    struct result       result;
+    uint32_t            threshold;
+    bool                isTraced;
+    int                 arg;
+
+    isTraced         = false;
+    threshold        = CONFIG_DEF_THRESHOLD;
+    plant.vMax       = CONFIG_DEF_VMAX;
+    plant.tauChamber = CONFIG_DEF_TAU_CHAMBER_MS;
+    plant.tauMotor   = CONFIG_DEF_TAU_MOTOR_MS;
+    arg              = 1;
+
+    if ((arg < argc) && (strcmp(argv[arg], "-t") == 0)) {
+        isTraced = true;
+        arg++;
+    }
+
+    if (arg < argc) {
+        threshold = (uint32_t)strtoul(argv[arg++], NULL, 10);
+    }
+
+    if (arg < argc) {
+        plant.vMax = strtod(argv[arg++], NULL);
+    }
+
+    if (arg < argc) {
+        plant.tauChamber = strtod(argv[arg++], NULL);
+    }
+
+    if (arg < argc) {
+        plant.tauMotor = strtod(argv[arg++], NULL);
+    }
+
+    if (isTraced) {
+        run(&plant, threshold, RUN_CLOSED_LOOP, true, &result);
+
+        return (EXIT_SUCCESS);
+    }
+    printf("%-12s %10s %10s %10s\n", "mode", "time ms", "overshoot", "inrush");
+    run(&plant, threshold, RUN_ON_OFF, false, &result);
+    report("on/off", threshold, &result);
+    run(&plant, threshold, RUN_SOFT_START, false, &result);
+    report("soft start", threshold, &result);
+    run(&plant, threshold, RUN_CLOSED_LOOP, false, &result);
+    report("closed loop", threshold, &result);
+
+    return (EXIT_SUCCESS);
+}